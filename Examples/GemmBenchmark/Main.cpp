@@ -0,0 +1,91 @@
+#include "SMathLib/Matrix.h"
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+// The i-j-l loop Matrix::operator* used before it was moved to glGemm.
+static SMathLib::Matrix NaiveMultiply(const SMathLib::Matrix& A, const SMathLib::Matrix& B)
+{
+	SMathLib::Matrix C(A.rows, B.cols, SMathLib::MatrixType::Zero);
+	for(size_t i=0 ; i<A.rows ; i++)
+	{
+		for(size_t j=0 ; j<B.cols ; j++)
+		{
+			for(size_t l=0 ; l<A.cols ; l++)
+			{
+				C(i, j) = C(i, j) + A.matrix[i*A.cols + l] * B.matrix[l*B.cols + j];
+			}
+		}
+	}
+	return C;
+}
+
+// Run the product a few times and return the best GFLOP/s.
+template<typename Func>
+static double Benchmark(size_t n, int repeats, Func func)
+{
+	double _best = 0.0;
+	for(int r=0 ; r<repeats ; ++r)
+	{
+		std::chrono::high_resolution_clock::time_point _start = std::chrono::high_resolution_clock::now();
+		func();
+		std::chrono::high_resolution_clock::time_point _end = std::chrono::high_resolution_clock::now();
+		
+		double _seconds = std::chrono::duration<double>(_end - _start).count();
+		double _gflops  = 2.0 * double(n) * double(n) * double(n) / _seconds * 1e-9;
+		if(_gflops > _best)
+		{
+			_best = _gflops;
+		}
+	}
+	return _best;
+}
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+// Usage: GemmBenchmark [n1 n2 ...]
+int main(int argc, char* argv[])
+{
+	size_t _sizes[] = {128, 256, 500, 1000, 2000};
+	size_t _count   = sizeof(_sizes) / sizeof(_sizes[0]);
+	if(argc > 1)
+	{
+		_count = 0;
+		for(int i=1 ; i<argc && _count<5 ; ++i)
+		{
+			_sizes[_count++] = size_t(atoi(argv[i]));
+		}
+	}
+	
+	std::cout << "       n    naive GFLOP/s     gemm GFLOP/s    speedup    max error\n";
+	for(size_t s=0 ; s<_count ; ++s)
+	{
+		const size_t n = _sizes[s];
+		SMathLib::Matrix A(n, n, SMathLib::MatrixType::Random);
+		SMathLib::Matrix B(n, n, SMathLib::MatrixType::Random);
+		SMathLib::Matrix C1, C2;
+		
+		// The naive loop is very slow for large matrices so only run it once.
+		double _naive = Benchmark(n, 1, [&]() { C1 = NaiveMultiply(A, B); });
+		double _gemm  = Benchmark(n, 3, [&]() { C2 = A * B; });
+		
+		double _error = 0.0;
+		for(size_t i=0 ; i<n*n ; ++i)
+		{
+			_error = std::max(_error, std::fabs(C1[i] - C2[i]));
+		}
+		
+		std::cout.width(8);  std::cout << n;
+		std::cout.width(17); std::cout << _naive;
+		std::cout.width(17); std::cout << _gemm;
+		std::cout.width(11); std::cout << _gemm / _naive;
+		std::cout.width(13); std::cout << _error << "\n";
+	}
+	
+	std::cout << "\n";
+	return 0;
+}
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
@@ -54,4 +54,11 @@ void glAxisAngleToRotationMatrix(double x, double y, double z, double r, double*
 	rotMat[15] = 1.0;
 }
 
+FixedMatrixD4 glAxisAngleToRotationMatrix(double x, double y, double z, double r)
+{
+	FixedMatrixD4 _rotMat;
+	glAxisAngleToRotationMatrix(x, y, z, r, _rotMat.Data());
+	return _rotMat;
+}
+
 };	// End namespace SMathLib.
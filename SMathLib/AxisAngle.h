@@ -8,6 +8,7 @@
 #define _SMATHLIB_AXISANGLE_H_
 
 #include "SMathLib/Config.h"
+#include "SMathLib/FixedMatrix.h"
 
 namespace SMathLib {
 ;
@@ -21,6 +22,14 @@ namespace SMathLib {
 SMATHLIB_DLL_API void glAxisAngleToRotationMatrix(double x, double y, double z, 
 												  double r, double* rotMat);
 
+//! Compute a 4x4 rotation matrix from axis angles.
+//! \param x The x-coordinate of the axis.
+//! \param y The y-coordinate of the axis.
+//! \param z The z-coordinate of the axis.
+//! \param r The angle about the axis.
+//! \return The 4x4 rotation matrix.
+SMATHLIB_DLL_API FixedMatrixD4 glAxisAngleToRotationMatrix(double x, double y, double z, double r);
+
 };	// End namespace SMathLib.
 
 #endif // _SMATHLIB_AXISANGLE_H_
@@ -0,0 +1,358 @@
+// 
+// This file is part of SLogLib; you can redistribute it and/or 
+// modify it under the terms of the MIT License.
+// Author: Saurabh Garg (saurabhgarg@mysoc.net)
+// 
+
+#include "BandedMatrix.h"
+#include "Parallel.h"
+#include "SUtils/Exceptions/InvalidArgumentException.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+
+namespace SMathLib {
+;
+
+// minimum number of elements processed by a thread.
+static const size_t gcParallelGrain = 32768;
+
+
+// constructors.
+// ------------------------------------------------------------------------- //
+BandedMatrix::BandedMatrix()
+	: mSize(0), mLower(0), mUpper(0)
+{}
+
+BandedMatrix::BandedMatrix(size_t n, size_t lower, size_t upper)
+	: mSize(n), mLower(lower), mUpper(upper), mBand(n*(lower+upper+1), 0.0)
+{}
+
+BandedMatrix::BandedMatrix(const ConstMatrixView& A, size_t lower, size_t upper)
+	: BandedMatrix(A.Rows(), lower, upper)
+{
+	if(A.Rows() != A.Cols())
+	{
+		char _msg[] = "A must be square in BandedMatrix::BandedMatrix";
+		throw SUtils::Exceptions::InvalidArgumentException(_msg);
+	}
+	for(size_t i=0 ; i<mSize ; ++i)
+	{
+		const size_t _first = i > mLower ? i-mLower : 0;
+		const size_t _last  = std::min(mSize-1, i+mUpper);
+		for(size_t j=_first ; j<=_last ; ++j)
+		{
+			mBand[i*Width() + j+mLower-i] = A(i, j);
+		}
+	}
+}
+// ------------------------------------------------------------------------- //
+
+
+// element access.
+// ------------------------------------------------------------------------- //
+double BandedMatrix::operator ()(size_t r, size_t c) const
+{
+	assert(r < mSize && c < mSize);
+	if(c+mLower < r || c > r+mUpper)
+	{
+		return 0.0;
+	}
+	return mBand[r*Width() + c+mLower-r];
+}
+
+double& BandedMatrix::At(size_t r, size_t c)
+{
+	assert(r < mSize && c < mSize && c+mLower >= r && c <= r+mUpper);
+	return mBand[r*Width() + c+mLower-r];
+}
+// ------------------------------------------------------------------------- //
+
+
+// functions.
+// ------------------------------------------------------------------------- //
+void BandedMatrix::Multiply(const double* x, double* y) const
+{
+	const size_t _width = Width();
+	glParallelFor(0, mSize, std::max<size_t>(1, gcParallelGrain / _width), [&](size_t r1, size_t r2)
+	{
+		for(size_t i=r1 ; i<r2 ; ++i)
+		{
+			const size_t  _first = i > mLower ? i-mLower : 0;
+			const size_t  _last  = std::min(mSize-1, i+mUpper);
+			const double* _row   = mBand.data() + i*_width + _first+mLower-i;
+			double _sum = 0.0;
+			for(size_t j=_first ; j<=_last ; ++j)
+			{
+				_sum += _row[j-_first] * x[j];
+			}
+			y[i] = _sum;
+		}
+	});
+}
+
+Matrix BandedMatrix::Solve(const ConstMatrixView& B) const
+{
+	if(B.Rows() != mSize)
+	{
+		char _msg[] = "B must have as many rows as A in BandedMatrix::Solve";
+		throw SUtils::Exceptions::InvalidArgumentException(_msg);
+	}
+	
+	// the factorization needs l more columns per row for the fill-in.
+	const size_t _width = Width();
+	const size_t _ld    = _width + mLower;
+	std::vector<double> _band(mSize*_ld, 0.0);
+	for(size_t i=0 ; i<mSize ; ++i)
+	{
+		std::memcpy(_band.data() + i*_ld, mBand.data() + i*_width, _width*sizeof(double));
+	}
+	
+	Matrix _X(B);
+	if(!glSolveBandedLU(mSize, mLower, mUpper, _band.data(), _X.matrix, _X.cols))
+	{
+		char _msg[] = "Singular matrix in BandedMatrix::Solve";
+		throw SUtils::Exceptions::InvalidArgumentException(_msg);
+	}
+	return _X;
+}
+
+Matrix BandedMatrix::ToDense() const
+{
+	Matrix _A(mSize, mSize, MatrixType::Zero);
+	for(size_t i=0 ; i<mSize ; ++i)
+	{
+		const size_t _first = i > mLower ? i-mLower : 0;
+		const size_t _last  = std::min(mSize-1, i+mUpper);
+		for(size_t j=_first ; j<=_last ; ++j)
+		{
+			_A.matrix[i*mSize+j] = mBand[i*Width() + j+mLower-i];
+		}
+	}
+	return _A;
+}
+// ------------------------------------------------------------------------- //
+
+
+// banded LU.
+// ------------------------------------------------------------------------- //
+template<typename T>
+static bool BandedLU(size_t n, size_t kl, size_t ku, T* band, T* X, size_t nrhs)
+{
+	// element (i, j) of the band.
+	const size_t _ld = 2*kl + ku + 1;
+	auto _at = [&](size_t i, size_t j) -> T& { return band[i*_ld + j+kl-i]; };
+	
+	for(size_t k=0 ; k<n ; ++k)
+	{
+		const size_t _lastRow = std::min(n-1, k+kl);
+		const size_t _lastCol = std::min(n-1, k+kl+ku);
+		
+		// move the largest element of column k to the diagonal.
+		size_t _p = k;
+		for(size_t i=k+1 ; i<=_lastRow ; ++i)
+		{
+			if(std::fabs(_at(i, k)) > std::fabs(_at(_p, k)))
+			{
+				_p = i;
+			}
+		}
+		if(_at(_p, k) == T(0))
+		{
+			return false;
+		}
+		if(_p != k)
+		{
+			for(size_t j=k ; j<=_lastCol ; ++j)
+			{
+				std::swap(_at(k, j), _at(_p, j));
+			}
+			std::swap_ranges(X + k*nrhs, X + (k+1)*nrhs, X + _p*nrhs);
+		}
+		
+		// eliminate column k from the rows below it.
+		const T _inv = T(1) / _at(k, k);
+		for(size_t i=k+1 ; i<=_lastRow ; ++i)
+		{
+			const T _l = _at(i, k) * _inv;
+			if(_l == T(0))
+			{
+				continue;
+			}
+			for(size_t j=k+1 ; j<=_lastCol ; ++j)
+			{
+				_at(i, j) -= _l * _at(k, j);
+			}
+			for(size_t c=0 ; c<nrhs ; ++c)
+			{
+				X[i*nrhs+c] -= _l * X[k*nrhs+c];
+			}
+		}
+	}
+	
+	// back substitution with U.
+	for(size_t k=n ; k-->0 ; )
+	{
+		const size_t _lastCol = std::min(n-1, k+kl+ku);
+		T* _x = X + k*nrhs;
+		for(size_t j=k+1 ; j<=_lastCol ; ++j)
+		{
+			const T  _u  = _at(k, j);
+			const T* _xj = X + j*nrhs;
+			for(size_t c=0 ; c<nrhs ; ++c)
+			{
+				_x[c] -= _u * _xj[c];
+			}
+		}
+		const T _inv = T(1) / _at(k, k);
+		for(size_t c=0 ; c<nrhs ; ++c)
+		{
+			_x[c] *= _inv;
+		}
+	}
+	return true;
+}
+
+bool glSolveBandedLU(size_t n, size_t lower, size_t upper, double* band, double* X, size_t nrhs)
+{
+	return BandedLU(n, lower, upper, band, X, nrhs);
+}
+
+bool glSolveBandedLU(size_t n, size_t lower, size_t upper, float* band, float* X, size_t nrhs)
+{
+	return BandedLU(n, lower, upper, band, X, nrhs);
+}
+// ------------------------------------------------------------------------- //
+
+
+// tridiagonal systems.
+// ------------------------------------------------------------------------- //
+
+// Thomas algorithm, s is scratch of size n for the eliminated super-diagonal.
+// Returns false if a zero pivot is found.
+static bool Thomas(size_t n, const double* sub, const double* diag, const double* super, const double* d,
+                   double* x, double* s)
+{
+	if(n == 0)
+	{
+		return true;
+	}
+	
+	// forward elimination of the sub-diagonal.
+	double _pivot = diag[0];
+	for(size_t i=0 ; ; )
+	{
+		if(_pivot == 0.0)
+		{
+			return false;
+		}
+		const double _inv = 1.0 / _pivot;
+		x[i] = (i == 0 ? d[0] : d[i] - sub[i]*x[i-1]) * _inv;
+		if(++i == n)
+		{
+			break;
+		}
+		s[i-1] = super[i-1] * _inv;
+		_pivot = diag[i] - sub[i]*s[i-1];
+	}
+	
+	// back substitution.
+	for(size_t i=n-1 ; i-->0 ; )
+	{
+		x[i] -= s[i] * x[i+1];
+	}
+	return true;
+}
+
+void glSolveTridiagonal(size_t n, const double* sub, const double* diag, const double* super, const double* d,
+                        double* x)
+{
+	std::vector<double> _s(n);
+	if(!Thomas(n, sub, diag, super, d, x, _s.data()))
+	{
+		char _msg[] = "Zero pivot in glSolveTridiagonal";
+		throw SUtils::Exceptions::InvalidArgumentException(_msg);
+	}
+}
+
+void glSolveCyclicTridiagonal(size_t n, const double* sub, const double* diag, const double* super,
+                              const double* d, double* x)
+{
+	if(n < 3)
+	{
+		char _msg[] = "Size must be at least 3 in glSolveCyclicTridiagonal";
+		throw SUtils::Exceptions::InvalidArgumentException(_msg);
+	}
+	
+	// A = T + u*v^T, where T is tridiagonal with its first and last diagonal
+	// elements modified, u = (gamma, 0, ..., 0, alpha) and v = (1, 0, ..., 0,
+	// beta/gamma). Then x = y - (v^T*y)/(1 + v^T*z)*z with T*y = d, T*z = u.
+	const double _alpha = super[n-1];
+	const double _beta  = sub[0];
+	const double _gamma = diag[0] != 0.0 ? -diag[0] : -1.0;
+	
+	std::vector<double> _diag(diag, diag+n), _z(n, 0.0), _s(n);
+	_diag[0]   -= _gamma;
+	_diag[n-1] -= _alpha*_beta / _gamma;
+	_z[0]   = _gamma;
+	_z[n-1] = _alpha;
+	if(!Thomas(n, sub, _diag.data(), super, d, x, _s.data()) ||
+	   !Thomas(n, sub, _diag.data(), super, _z.data(), _z.data(), _s.data()))
+	{
+		char _msg[] = "Zero pivot in glSolveCyclicTridiagonal";
+		throw SUtils::Exceptions::InvalidArgumentException(_msg);
+	}
+	
+	const double _denominator = 1.0 + _z[0] + _beta*_z[n-1]/_gamma;
+	if(_denominator == 0.0)
+	{
+		char _msg[] = "Singular matrix in glSolveCyclicTridiagonal";
+		throw SUtils::Exceptions::InvalidArgumentException(_msg);
+	}
+	const double _factor = (x[0] + _beta*x[n-1]/_gamma) / _denominator;
+	for(size_t i=0 ; i<n ; ++i)
+	{
+		x[i] -= _factor * _z[i];
+	}
+}
+
+size_t glBatchSolveTridiagonal(size_t n, size_t count, const double* sub, const double* diag, const double* super,
+                               const double* d, double* x, BatchSolveStatus* status, unsigned int numThreads)
+{
+	if(n == 0 || count == 0)
+	{
+		return 0;
+	}
+	
+	std::vector<unsigned char> _failed(count, 0);
+	glParallelFor(0, count, std::max<size_t>(1, gcParallelGrain / n), [&](size_t s1, size_t s2)
+	{
+		std::vector<double> _s(n);
+		for(size_t s=s1 ; s<s2 ; ++s)
+		{
+			const size_t _offset = s*n;
+			double*      _x      = x + _offset;
+			const bool   _ok     = Thomas(n, sub+_offset, diag+_offset, super+_offset, d+_offset, _x, _s.data());
+			if(!_ok)
+			{
+				std::fill(_x, _x+n, 0.0);
+			}
+			if(status)
+			{
+				status[s] = _ok ? BatchSolveStatus::Success : BatchSolveStatus::Singular;
+			}
+			_failed[s] = _ok ? 0 : 1;
+		}
+	}, numThreads);
+	
+	size_t _numFailed = 0;
+	for(size_t s=0 ; s<count ; ++s)
+	{
+		_numFailed += _failed[s];
+	}
+	return _numFailed;
+}
+// ------------------------------------------------------------------------- //
+
+};	// End namespace SMathLib.
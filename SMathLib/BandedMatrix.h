@@ -0,0 +1,137 @@
+// 
+// This file is part of SLogLib; you can redistribute it and/or 
+// modify it under the terms of the MIT License.
+// Author: Saurabh Garg (saurabhgarg@mysoc.net)
+// 
+
+#ifndef _SMATHLIB_BANDEDMATRIX_H_
+#define _SMATHLIB_BANDEDMATRIX_H_
+
+#include "SMathLib/Config.h"
+#include "SMathLib/BatchSolve.h"
+#include "SMathLib/Matrix.h"
+#include "SMathLib/MatrixView.h"
+#include <vector>
+
+namespace SMathLib {
+;
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+// Banded and tridiagonal matrices, stored and solved in O(n) memory and time
+// for a fixed bandwidth:
+//
+//     BandedMatrix _A(n, 2, 2);             // Pentadiagonal.
+//     _A.At(i, i+1) = a;                    // Only elements inside the band.
+//     Matrix _x = _A.Solve(b);              // Banded LU with partial pivoting.
+//
+//     glSolveTridiagonal(n, sub, diag, super, d, x);    // Thomas algorithm.
+//
+// A n x n matrix with lower bandwidth l and upper bandwidth u has A(i, j) = 0
+// for j < i-l and j > i+u. The band is stored row by row, row i holds the
+// columns [i-l, i+u] at Data()[i*Width() + j-i+l]; the slots outside the
+// matrix in the first and the last rows are 0.
+//
+// A tridiagonal system is given by three arrays of size n: sub[i] = A(i, i-1),
+// diag[i] = A(i, i) and super[i] = A(i, i+1). sub[0] and super[n-1] are not
+// used, except by the cyclic solver where they are the corners A(0, n-1) and
+// A(n-1, 0).
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+//! Square matrix in compact banded storage.
+class SMATHLIB_DLL_API BandedMatrix
+{
+public:  // Constructors.
+
+	BandedMatrix();
+	
+	//! Create a n x n zero matrix with the given bandwidths.
+	BandedMatrix(size_t n, size_t lower, size_t upper);
+	
+	//! Copy the band of a square dense matrix, the elements outside the band
+	//! are ignored.
+	BandedMatrix(const ConstMatrixView& A, size_t lower, size_t upper);
+
+public:  // Size and storage.
+
+	inline size_t        Size()  const {return mSize;}
+	inline size_t        Lower() const {return mLower;}
+	inline size_t        Upper() const {return mUpper;}
+	inline size_t        Width() const {return mLower + mUpper + 1;}
+	inline const double* Data()  const {return mBand.data();}
+	inline double*       Data()        {return mBand.data();}
+
+public:  // Element access.
+
+	//! Get element (r, c), 0 if it is outside the band.
+	double operator ()(size_t r, size_t c) const;
+	
+	//! Reference to element (r, c), which must be inside the band.
+	double& At(size_t r, size_t c);
+
+public:  // Functions.
+
+	//! y = A*x, x and y have Size() elements and must not overlap.
+	void Multiply(const double* x, double* y) const;
+	
+	//! Solve A*X = B by LU factorization with partial pivoting restricted to
+	//! the band, in O(n*l*(l+u)) time per column of B. Throws
+	//! SUtils::Exceptions::InvalidArgumentException if A is singular.
+	Matrix Solve(const ConstMatrixView& B) const;
+	
+	Matrix ToDense() const;
+
+private:
+
+	size_t              mSize;
+	size_t              mLower;
+	size_t              mUpper;
+	std::vector<double> mBand;
+};
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+//! Solve A*X = B in place by banded LU with partial pivoting, the kernel of
+//! BandedMatrix::Solve() and of SolveAxB() with SolveMode::Auto. The row
+//! exchanges widen the upper bandwidth of U to l+u, so band has n rows of
+//! width 2*l+u+1: row i holds A(i, j) for j in [i-l, i+u] at band[i*width + j-i+l]
+//! and its last l slots are zero on input. band is overwritten by the
+//! factorization.
+//! \param X Row-major n x nrhs matrix holding B on input and X on output.
+//! \return false if a zero pivot was found, X is then undefined.
+SMATHLIB_DLL_API bool glSolveBandedLU(size_t n, size_t lower, size_t upper, double* band, double* X, size_t nrhs);
+SMATHLIB_DLL_API bool glSolveBandedLU(size_t n, size_t lower, size_t upper, float*  band, float*  X, size_t nrhs);
+
+//! Solve the tridiagonal system A*x = d with the Thomas algorithm, in O(n)
+//! time. There is no pivoting, which is stable for diagonally dominant and
+//! for symmetric positive definite matrices; use BandedMatrix::Solve() for
+//! the others. x can be the same as d. Throws
+//! SUtils::Exceptions::InvalidArgumentException if a zero pivot is found.
+SMATHLIB_DLL_API void glSolveTridiagonal(size_t n, const double* sub, const double* diag, const double* super,
+                                         const double* d, double* x);
+
+//! Solve the cyclic tridiagonal system, with the corners sub[0] = A(0, n-1)
+//! and super[n-1] = A(n-1, 0), as it arises from periodic boundaries. The
+//! corners are removed by the Sherman-Morrison formula, which costs two
+//! Thomas solves. n must be at least 3; the other requirements are the same
+//! as glSolveTridiagonal().
+SMATHLIB_DLL_API void glSolveCyclicTridiagonal(size_t n, const double* sub, const double* diag, const double* super,
+                                               const double* d, double* x);
+
+//! Solve count independent tridiagonal systems of size n with the Thomas
+//! algorithm. The arrays hold the systems one after another, n elements
+//! each, and the systems are solved in parallel.
+//! \param status Pointer to count statuses, one per system, can be nullptr.
+//! \param numThreads Number of threads to use, 0 means use glGetNumThreads().
+//! \return The number of systems with a zero pivot; their solutions are set
+//! to 0 and their status to Singular.
+SMATHLIB_DLL_API size_t glBatchSolveTridiagonal(size_t n, size_t count, const double* sub, const double* diag,
+                                                const double* super, const double* d, double* x,
+                                                BatchSolveStatus* status = nullptr, unsigned int numThreads = 0);
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+
+};	// End namespace SMathLib.
+
+#endif // _SMATHLIB_BANDEDMATRIX_H_
@@ -0,0 +1,648 @@
+// 
+// This file is part of SLogLib; you can redistribute it and/or 
+// modify it under the terms of the MIT License.
+// Author: Saurabh Garg (saurabhgarg@mysoc.net)
+// 
+
+#include "BatchSolve.h"
+#include "Cpu.h"
+#include "Parallel.h"
+#include "SUtils/Exceptions/InvalidArgumentException.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+#if defined(SMATHLIB_HAS_AVX2)
+	#include <immintrin.h>
+#endif
+
+// The kernels are inlined into the AVX2 and the portable entry points so that
+// each is compiled for its instruction set.
+#if defined(_MSC_VER)
+	#define SMATHLIB_BATCH_INLINE __forceinline
+#else
+	#define SMATHLIB_BATCH_INLINE inline __attribute__((always_inline))
+#endif
+
+namespace SMathLib {
+;
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+// Number of systems solved together, the kernels operate on the corresponding
+// elements of all the systems of a group at once.
+static const size_t gcLanes = 8;
+
+// Minimum number of groups of systems solved by one thread.
+static const size_t gcParallelGroups = 64;
+
+// A group of systems in structure-of-arrays layout: element (i, j) of the
+// system w is A[i][j][w]. failed[w] is set to 1 when a system can't be solved.
+struct BatchGroup
+{
+	double A[gcBatchSolveMaxSize][gcBatchSolveMaxSize][gcLanes];
+	double b[gcBatchSolveMaxSize][gcLanes];
+	double invDiag[gcBatchSolveMaxSize][gcLanes];
+	double tolerance[gcLanes];
+	double failed[gcLanes];
+};
+
+// Kernel which loads and solves one group.
+typedef void (*BatchKernel)(size_t n, size_t first, size_t count, const double* A, const double* b,
+                            BatchGroup& group);
+
+// Load a group of systems, padding the group with identity systems. The pivot
+// tolerance of each system is relative to its largest element, only the lower
+// triangle is considered if Lower is true. N is the size of the systems if it
+// is known at compile time and 0 otherwise.
+template<size_t N, bool Lower>
+static SMATHLIB_BATCH_INLINE void LoadGroup(size_t n, size_t first, size_t count, const double* A, const double* b,
+                                            BatchGroup& group)
+{
+	const size_t _n = N ? N : n;
+	for(size_t w=0 ; w<gcLanes ; ++w)
+	{
+		const size_t  _s = first + w;
+		const bool    _v = _s < count;
+		const double* _A = A + _s*_n*_n;
+		const double* _b = b + _s*_n;
+		double _max = 0.0;
+		for(size_t i=0 ; i<_n ; ++i)
+		{
+			for(size_t j=0 ; j<_n ; ++j)
+			{
+				const double _a = _v ? _A[i*_n+j] : (i == j ? 1.0 : 0.0);
+				group.A[i][j][w] = _a;
+				if(!Lower || j <= i)
+				{
+					_max = std::max(_max, std::fabs(_a));
+				}
+			}
+			group.b[i][w] = _v ? _b[i] : 0.0;
+		}
+		group.tolerance[w] = double(_n) * DBL_EPSILON * _max;
+		group.failed[w]    = 0.0;
+	}
+}
+
+// Operations on the lanes of a group. LanesScalar is the portable version,
+// LanesAvx2 holds the 8 lanes in two ymm registers. The kernels are written
+// once against these operations and are instantiated for both.
+struct LanesScalar
+{
+	double v[gcLanes];
+	
+	static SMATHLIB_BATCH_INLINE LanesScalar Load(const double* p)
+	{
+		LanesScalar _r;
+		for(size_t w=0 ; w<gcLanes ; ++w)
+		{
+			_r.v[w] = p[w];
+		}
+		return _r;
+	}
+	static SMATHLIB_BATCH_INLINE LanesScalar Set(double s)
+	{
+		LanesScalar _r;
+		for(size_t w=0 ; w<gcLanes ; ++w)
+		{
+			_r.v[w] = s;
+		}
+		return _r;
+	}
+	SMATHLIB_BATCH_INLINE void Store(double* p) const
+	{
+		for(size_t w=0 ; w<gcLanes ; ++w)
+		{
+			p[w] = v[w];
+		}
+	}
+	
+	// Element-wise operations, masks are 1 for true and 0 for false.
+	template<typename Func>
+	static SMATHLIB_BATCH_INLINE LanesScalar Map(const LanesScalar& a, const LanesScalar& b, Func func)
+	{
+		LanesScalar _r;
+		for(size_t w=0 ; w<gcLanes ; ++w)
+		{
+			_r.v[w] = func(a.v[w], b.v[w]);
+		}
+		return _r;
+	}
+	static SMATHLIB_BATCH_INLINE LanesScalar Add(const LanesScalar& a, const LanesScalar& b)     { return Map(a, b, [](double x, double y) { return x + y; }); }
+	static SMATHLIB_BATCH_INLINE LanesScalar Mul(const LanesScalar& a, const LanesScalar& b)     { return Map(a, b, [](double x, double y) { return x * y; }); }
+	static SMATHLIB_BATCH_INLINE LanesScalar Div(const LanesScalar& a, const LanesScalar& b)     { return Map(a, b, [](double x, double y) { return x / y; }); }
+	static SMATHLIB_BATCH_INLINE LanesScalar Greater(const LanesScalar& a, const LanesScalar& b) { return Map(a, b, [](double x, double y) { return x > y ? 1.0 : 0.0; }); }
+	
+	// a - b*c.
+	static SMATHLIB_BATCH_INLINE LanesScalar SubMul(const LanesScalar& a, const LanesScalar& b, const LanesScalar& c)
+	{
+		LanesScalar _r;
+		for(size_t w=0 ; w<gcLanes ; ++w)
+		{
+			_r.v[w] = a.v[w] - b.v[w]*c.v[w];
+		}
+		return _r;
+	}
+	static SMATHLIB_BATCH_INLINE LanesScalar Abs(const LanesScalar& a)
+	{
+		LanesScalar _r;
+		for(size_t w=0 ; w<gcLanes ; ++w)
+		{
+			_r.v[w] = std::fabs(a.v[w]);
+		}
+		return _r;
+	}
+	static SMATHLIB_BATCH_INLINE LanesScalar Sqrt(const LanesScalar& a)
+	{
+		LanesScalar _r;
+		for(size_t w=0 ; w<gcLanes ; ++w)
+		{
+			_r.v[w] = std::sqrt(a.v[w]);
+		}
+		return _r;
+	}
+	
+	// mask ? a : b.
+	static SMATHLIB_BATCH_INLINE LanesScalar Select(const LanesScalar& mask, const LanesScalar& a, const LanesScalar& b)
+	{
+		LanesScalar _r;
+		for(size_t w=0 ; w<gcLanes ; ++w)
+		{
+			_r.v[w] = mask.v[w] != 0.0 ? a.v[w] : b.v[w];
+		}
+		return _r;
+	}
+};
+
+#if defined(SMATHLIB_HAS_AVX2)
+struct LanesAvx2
+{
+	__m256d lo, hi;
+	
+	SMATHLIB_AVX2_TARGET static inline LanesAvx2 Load(const double* p)
+	{
+		return LanesAvx2{_mm256_loadu_pd(p), _mm256_loadu_pd(p+4)};
+	}
+	SMATHLIB_AVX2_TARGET static inline LanesAvx2 Set(double s)
+	{
+		return LanesAvx2{_mm256_set1_pd(s), _mm256_set1_pd(s)};
+	}
+	SMATHLIB_AVX2_TARGET inline void Store(double* p) const
+	{
+		_mm256_storeu_pd(p, lo);
+		_mm256_storeu_pd(p+4, hi);
+	}
+	
+	// Masks have all the bits of true lanes set.
+	SMATHLIB_AVX2_TARGET static inline LanesAvx2 Add(const LanesAvx2& a, const LanesAvx2& b)
+	{
+		return LanesAvx2{_mm256_add_pd(a.lo, b.lo), _mm256_add_pd(a.hi, b.hi)};
+	}
+	SMATHLIB_AVX2_TARGET static inline LanesAvx2 Mul(const LanesAvx2& a, const LanesAvx2& b)
+	{
+		return LanesAvx2{_mm256_mul_pd(a.lo, b.lo), _mm256_mul_pd(a.hi, b.hi)};
+	}
+	SMATHLIB_AVX2_TARGET static inline LanesAvx2 Div(const LanesAvx2& a, const LanesAvx2& b)
+	{
+		return LanesAvx2{_mm256_div_pd(a.lo, b.lo), _mm256_div_pd(a.hi, b.hi)};
+	}
+	SMATHLIB_AVX2_TARGET static inline LanesAvx2 Greater(const LanesAvx2& a, const LanesAvx2& b)
+	{
+		return LanesAvx2{_mm256_cmp_pd(a.lo, b.lo, _CMP_GT_OQ), _mm256_cmp_pd(a.hi, b.hi, _CMP_GT_OQ)};
+	}
+	SMATHLIB_AVX2_TARGET static inline LanesAvx2 SubMul(const LanesAvx2& a, const LanesAvx2& b, const LanesAvx2& c)
+	{
+		return LanesAvx2{_mm256_fnmadd_pd(b.lo, c.lo, a.lo), _mm256_fnmadd_pd(b.hi, c.hi, a.hi)};
+	}
+	SMATHLIB_AVX2_TARGET static inline LanesAvx2 Abs(const LanesAvx2& a)
+	{
+		const __m256d _sign = _mm256_set1_pd(-0.0);
+		return LanesAvx2{_mm256_andnot_pd(_sign, a.lo), _mm256_andnot_pd(_sign, a.hi)};
+	}
+	SMATHLIB_AVX2_TARGET static inline LanesAvx2 Sqrt(const LanesAvx2& a)
+	{
+		return LanesAvx2{_mm256_sqrt_pd(a.lo), _mm256_sqrt_pd(a.hi)};
+	}
+	SMATHLIB_AVX2_TARGET static inline LanesAvx2 Select(const LanesAvx2& mask, const LanesAvx2& a, const LanesAvx2& b)
+	{
+		return LanesAvx2{_mm256_blendv_pd(b.lo, a.lo, mask.lo), _mm256_blendv_pd(b.hi, a.hi, mask.hi)};
+	}
+};
+#endif
+
+// LU factorization with partial pivoting and solution of a group. Rows are
+// exchanged with selects so that all the lanes execute the same instructions.
+template<size_t N, typename L>
+static SMATHLIB_BATCH_INLINE void SolveGroupLU(size_t n, BatchGroup& group)
+{
+	const size_t _n   = N ? N : n;
+	const L      _one = L::Set(1.0);
+	L _failed = L::Set(0.0);
+	for(size_t k=0 ; k<_n ; ++k)
+	{
+		// Move the largest element of column k to the diagonal.
+		for(size_t i=k+1 ; i<_n ; ++i)
+		{
+			const L _swap = L::Greater(L::Abs(L::Load(group.A[i][k])), L::Abs(L::Load(group.A[k][k])));
+			for(size_t j=k ; j<_n ; ++j)
+			{
+				const L _kj = L::Load(group.A[k][j]);
+				const L _ij = L::Load(group.A[i][j]);
+				L::Select(_swap, _ij, _kj).Store(group.A[k][j]);
+				L::Select(_swap, _kj, _ij).Store(group.A[i][j]);
+			}
+			const L _k = L::Load(group.b[k]);
+			const L _i = L::Load(group.b[i]);
+			L::Select(_swap, _i, _k).Store(group.b[k]);
+			L::Select(_swap, _k, _i).Store(group.b[i]);
+		}
+		
+		// A pivot below the tolerance marks the system as singular; its pivot
+		// is replaced by 1 so the other lanes are not disturbed by infinities.
+		const L _pivot = L::Load(group.A[k][k]);
+		const L _ok    = L::Greater(L::Abs(_pivot), L::Load(group.tolerance));
+		const L _inv   = L::Div(_one, L::Select(_ok, _pivot, _one));
+		_failed = L::Select(_ok, _failed, _one);
+		_inv.Store(group.invDiag[k]);
+		
+		// Eliminate column k from the rows below it.
+		for(size_t i=k+1 ; i<_n ; ++i)
+		{
+			const L _l = L::Mul(L::Load(group.A[i][k]), _inv);
+			for(size_t j=k+1 ; j<_n ; ++j)
+			{
+				L::SubMul(L::Load(group.A[i][j]), _l, L::Load(group.A[k][j])).Store(group.A[i][j]);
+			}
+			L::SubMul(L::Load(group.b[i]), _l, L::Load(group.b[k])).Store(group.b[i]);
+		}
+	}
+	
+	// Back substitution with U, the solution overwrites b.
+	for(size_t i=_n ; i-->0 ; )
+	{
+		L _x = L::Load(group.b[i]);
+		for(size_t j=i+1 ; j<_n ; ++j)
+		{
+			_x = L::SubMul(_x, L::Load(group.A[i][j]), L::Load(group.b[j]));
+		}
+		L::Mul(_x, L::Load(group.invDiag[i])).Store(group.b[i]);
+	}
+	_failed.Store(group.failed);
+}
+
+// Cholesky factorization and solution of a group. The factor L overwrites the
+// lower triangle of A.
+template<size_t N, typename L>
+static SMATHLIB_BATCH_INLINE void SolveGroupCholesky(size_t n, BatchGroup& group)
+{
+	const size_t _n   = N ? N : n;
+	const L      _one = L::Set(1.0);
+	L _failed = L::Set(0.0);
+	for(size_t k=0 ; k<_n ; ++k)
+	{
+		// Diagonal element of L.
+		L _d = L::Load(group.A[k][k]);
+		for(size_t p=0 ; p<k ; ++p)
+		{
+			const L _kp = L::Load(group.A[k][p]);
+			_d = L::SubMul(_d, _kp, _kp);
+		}
+		const L _ok  = L::Greater(_d, L::Load(group.tolerance));
+		const L _inv = L::Div(_one, L::Sqrt(L::Select(_ok, _d, _one)));
+		_failed = L::Select(_ok, _failed, _one);
+		_inv.Store(group.invDiag[k]);
+		
+		// Column k of L below the diagonal.
+		for(size_t i=k+1 ; i<_n ; ++i)
+		{
+			L _s = L::Load(group.A[i][k]);
+			for(size_t p=0 ; p<k ; ++p)
+			{
+				_s = L::SubMul(_s, L::Load(group.A[i][p]), L::Load(group.A[k][p]));
+			}
+			L::Mul(_s, _inv).Store(group.A[i][k]);
+		}
+	}
+	
+	// Forward substitution with L.
+	for(size_t i=0 ; i<_n ; ++i)
+	{
+		L _y = L::Load(group.b[i]);
+		for(size_t p=0 ; p<i ; ++p)
+		{
+			_y = L::SubMul(_y, L::Load(group.A[i][p]), L::Load(group.b[p]));
+		}
+		L::Mul(_y, L::Load(group.invDiag[i])).Store(group.b[i]);
+	}
+	
+	// Back substitution with L^T.
+	for(size_t i=_n ; i-->0 ; )
+	{
+		L _x = L::Load(group.b[i]);
+		for(size_t p=i+1 ; p<_n ; ++p)
+		{
+			_x = L::SubMul(_x, L::Load(group.A[p][i]), L::Load(group.b[p]));
+		}
+		L::Mul(_x, L::Load(group.invDiag[i])).Store(group.b[i]);
+	}
+	_failed.Store(group.failed);
+}
+
+// Kernels for each size, compiled for AVX2 and for the portable instruction set.
+template<size_t N>
+static void KernelLU(size_t n, size_t first, size_t count, const double* A, const double* b, BatchGroup& group)
+{
+	LoadGroup<N, false>(n, first, count, A, b, group);
+	SolveGroupLU<N, LanesScalar>(n, group);
+}
+
+template<size_t N>
+static void KernelCholesky(size_t n, size_t first, size_t count, const double* A, const double* b, BatchGroup& group)
+{
+	LoadGroup<N, true>(n, first, count, A, b, group);
+	SolveGroupCholesky<N, LanesScalar>(n, group);
+}
+
+#if defined(SMATHLIB_HAS_AVX2)
+template<size_t N>
+SMATHLIB_AVX2_TARGET static void KernelLUAvx2(size_t n, size_t first, size_t count, const double* A, const double* b,
+                                              BatchGroup& group)
+{
+	LoadGroup<N, false>(n, first, count, A, b, group);
+	SolveGroupLU<N, LanesAvx2>(n, group);
+}
+
+template<size_t N>
+SMATHLIB_AVX2_TARGET static void KernelCholeskyAvx2(size_t n, size_t first, size_t count, const double* A, const double* b,
+                                                    BatchGroup& group)
+{
+	LoadGroup<N, true>(n, first, count, A, b, group);
+	SolveGroupCholesky<N, LanesAvx2>(n, group);
+}
+#endif
+
+// Select the kernel for the size of the systems and the CPU.
+static BatchKernel SelectKernel(size_t n, bool cholesky)
+{
+#if defined(SMATHLIB_HAS_AVX2)
+	if(glCpuHasAvx2())
+	{
+		switch(n)
+		{
+		case 2:  return cholesky ? KernelCholeskyAvx2<2> : KernelLUAvx2<2>;
+		case 3:  return cholesky ? KernelCholeskyAvx2<3> : KernelLUAvx2<3>;
+		case 4:  return cholesky ? KernelCholeskyAvx2<4> : KernelLUAvx2<4>;
+		case 5:  return cholesky ? KernelCholeskyAvx2<5> : KernelLUAvx2<5>;
+		case 6:  return cholesky ? KernelCholeskyAvx2<6> : KernelLUAvx2<6>;
+		default: return cholesky ? KernelCholeskyAvx2<0> : KernelLUAvx2<0>;
+		}
+	}
+#endif
+	switch(n)
+	{
+	case 2:  return cholesky ? KernelCholesky<2> : KernelLU<2>;
+	case 3:  return cholesky ? KernelCholesky<3> : KernelLU<3>;
+	case 4:  return cholesky ? KernelCholesky<4> : KernelLU<4>;
+	case 5:  return cholesky ? KernelCholesky<5> : KernelLU<5>;
+	case 6:  return cholesky ? KernelCholesky<6> : KernelLU<6>;
+	default: return cholesky ? KernelCholesky<0> : KernelLU<0>;
+	}
+}
+
+// Solve all the systems, one group at a time.
+static size_t BatchSolve(size_t n, size_t count, const double* A, const double* b, double* x,
+                         BatchSolveStatus* status, unsigned int numThreads, bool cholesky)
+{
+	const BatchSolveStatus _failure = cholesky ? BatchSolveStatus::NotPositiveDefinite : BatchSolveStatus::Singular;
+	if(n > gcBatchSolveMaxSize)
+	{
+		char _msg[] = "Size of the systems is too large in glBatchSolve";
+		throw SUtils::Exceptions::InvalidArgumentException(_msg);
+	}
+	if(n == 0 || count == 0)
+	{
+		return 0;
+	}
+	
+	const BatchKernel _kernel    = SelectKernel(n, cholesky);
+	const size_t      _numGroups = (count + gcLanes - 1) / gcLanes;
+	std::vector<size_t> _failed(_numGroups, 0);
+	
+	glParallelFor(0, _numGroups, gcParallelGroups, [&](size_t g1, size_t g2)
+	{
+		BatchGroup _group;
+		for(size_t g=g1 ; g<g2 ; ++g)
+		{
+			const size_t _first = g*gcLanes;
+			_kernel(n, _first, count, A, b, _group);
+			
+			// Store the solutions of the systems which are part of the batch.
+			const size_t _lanes = std::min(gcLanes, count-_first);
+			for(size_t w=0 ; w<_lanes ; ++w)
+			{
+				const bool _ok = _group.failed[w] == 0.0;
+				double*    _x  = x + (_first+w)*n;
+				for(size_t i=0 ; i<n ; ++i)
+				{
+					_x[i] = _ok ? _group.b[i][w] : 0.0;
+				}
+				if(status)
+				{
+					status[_first+w] = _ok ? BatchSolveStatus::Success : _failure;
+				}
+				_failed[g] += _ok ? 0 : 1;
+			}
+		}
+	}, numThreads);
+	
+	size_t _numFailed = 0;
+	for(size_t g=0 ; g<_numGroups ; ++g)
+	{
+		_numFailed += _failed[g];
+	}
+	return _numFailed;
+}
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+size_t glBatchSolveLU(size_t n, size_t count, const double* A, const double* b, double* x,
+                      BatchSolveStatus* status, unsigned int numThreads)
+{
+	return BatchSolve(n, count, A, b, x, status, numThreads, false);
+}
+
+size_t glBatchSolveCholesky(size_t n, size_t count, const double* A, const double* b, double* x,
+                            BatchSolveStatus* status, unsigned int numThreads)
+{
+	return BatchSolve(n, count, A, b, x, status, numThreads, true);
+}
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+// Least squares. Each problem is copied into a row-major m x (n+1) work matrix
+// [A b], with its rows scaled by the square roots of the weights, which is
+// reduced to upper triangular form by Householder reflections; the last column
+// then holds Q^T*b. The reflections are applied a row at a time so that the
+// work matrix is read contiguously.
+
+// Minimum number of elements of the problems solved by one thread.
+static const size_t gcParallelLeastSquares = 16384;
+
+// Solve the problem in the work matrix W into x using the scratch vector s of
+// size n+1. Returns false if the matrix is rank deficient.
+static bool SolveLeastSquares(size_t m, size_t n, double* W, double* s, double* x)
+{
+	const size_t _ld = n + 1;
+	
+	// A column is dependent when its part orthogonal to the previous columns,
+	// which is the diagonal element of R, is small relative to the largest column.
+	std::fill(s, s+n, 0.0);
+	for(size_t i=0 ; i<m ; ++i)
+	{
+		for(size_t j=0 ; j<n ; ++j)
+		{
+			s[j] += W[i*_ld+j] * W[i*_ld+j];
+		}
+	}
+	const double _tolerance = double(m) * DBL_EPSILON * std::sqrt(*std::max_element(s, s+n));
+	
+	for(size_t j=0 ; j<n ; ++j)
+	{
+		// Reflection H = I - tau*v*v^T with v_j = 1 which maps column j to
+		// beta*e_j; v below the diagonal overwrites the column.
+		double _norm2 = 0.0;
+		for(size_t i=j ; i<m ; ++i)
+		{
+			_norm2 += W[i*_ld+j] * W[i*_ld+j];
+		}
+		const double _norm = std::sqrt(_norm2);
+		if(!(_norm > _tolerance))
+		{
+			return false;
+		}
+		const double _alpha = W[j*_ld+j];
+		const double _beta  = _alpha > 0.0 ? -_norm : _norm;
+		const double _tau   = (_beta - _alpha) / _beta;
+		const double _scale = 1.0 / (_alpha - _beta);
+		for(size_t i=j+1 ; i<m ; ++i)
+		{
+			W[i*_ld+j] *= _scale;
+		}
+		W[j*_ld+j] = _beta;
+		
+		// Apply H to the remaining columns: s = tau * v^T*W, W -= v*s.
+		for(size_t k=j+1 ; k<=n ; ++k)
+		{
+			s[k] = W[j*_ld+k];
+		}
+		for(size_t i=j+1 ; i<m ; ++i)
+		{
+			const double  _v   = W[i*_ld+j];
+			const double* _row = W + i*_ld;
+			for(size_t k=j+1 ; k<=n ; ++k)
+			{
+				s[k] += _v * _row[k];
+			}
+		}
+		for(size_t k=j+1 ; k<=n ; ++k)
+		{
+			s[k]       *= _tau;
+			W[j*_ld+k] -= s[k];
+		}
+		for(size_t i=j+1 ; i<m ; ++i)
+		{
+			const double _v   = W[i*_ld+j];
+			double*      _row = W + i*_ld;
+			for(size_t k=j+1 ; k<=n ; ++k)
+			{
+				_row[k] -= _v * s[k];
+			}
+		}
+	}
+	
+	// Back substitution with R.
+	for(size_t j=n ; j-->0 ; )
+	{
+		double _x = W[j*_ld+n];
+		for(size_t k=j+1 ; k<n ; ++k)
+		{
+			_x -= W[j*_ld+k] * x[k];
+		}
+		x[j] = _x / W[j*_ld+j];
+	}
+	return true;
+}
+
+size_t glBatchSolveLeastSquares(size_t m, size_t n, size_t count, const double* A, const double* b, double* x,
+                                const double* w, BatchSolveStatus* status, unsigned int numThreads)
+{
+	if(m < n)
+	{
+		char _msg[] = "More unknowns than equations in glBatchSolveLeastSquares";
+		throw SUtils::Exceptions::InvalidArgumentException(_msg);
+	}
+	if(w)
+	{
+		for(size_t i=0 ; i<m*count ; ++i)
+		{
+			if(!(w[i] >= 0.0))
+			{
+				char _msg[] = "Negative weight in glBatchSolveLeastSquares";
+				throw SUtils::Exceptions::InvalidArgumentException(_msg);
+			}
+		}
+	}
+	if(n == 0 || count == 0)
+	{
+		return 0;
+	}
+	
+	const size_t _ld    = n + 1;
+	const size_t _grain = std::max<size_t>(1, gcParallelLeastSquares / (m*_ld));
+	std::vector<unsigned char> _failed(count, 0);
+	
+	glParallelFor(0, count, _grain, [&](size_t p1, size_t p2)
+	{
+		std::vector<double> _W(m*_ld), _s(_ld);
+		for(size_t p=p1 ; p<p2 ; ++p)
+		{
+			const double* _A = A + p*m*n;
+			const double* _b = b + p*m;
+			for(size_t i=0 ; i<m ; ++i)
+			{
+				const double _sw = w ? std::sqrt(w[p*m+i]) : 1.0;
+				for(size_t j=0 ; j<n ; ++j)
+				{
+					_W[i*_ld+j] = _sw * _A[i*n+j];
+				}
+				_W[i*_ld+n] = _sw * _b[i];
+			}
+			
+			double*    _x  = x + p*n;
+			const bool _ok = SolveLeastSquares(m, n, _W.data(), _s.data(), _x);
+			if(!_ok)
+			{
+				std::fill(_x, _x+n, 0.0);
+			}
+			if(status)
+			{
+				status[p] = _ok ? BatchSolveStatus::Success : BatchSolveStatus::RankDeficient;
+			}
+			_failed[p] = _ok ? 0 : 1;
+		}
+	}, numThreads);
+	
+	size_t _numFailed = 0;
+	for(size_t p=0 ; p<count ; ++p)
+	{
+		_numFailed += _failed[p];
+	}
+	return _numFailed;
+}
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+
+};	// End namespace SMathLib.
@@ -0,0 +1,76 @@
+// 
+// This file is part of SLogLib; you can redistribute it and/or 
+// modify it under the terms of the MIT License.
+// Author: Saurabh Garg (saurabhgarg@mysoc.net)
+// 
+
+#ifndef _SMATHLIB_BATCHSOLVE_H_
+#define _SMATHLIB_BATCHSOLVE_H_
+
+#include "SMathLib/Config.h"
+#include <cstddef>
+
+namespace SMathLib {
+;
+
+//! Result of solving one system of a batch.
+enum class BatchSolveStatus : unsigned char
+{
+	Success             = 0,
+	Singular            = 1,    ///< A zero pivot was found by the LU factorization.
+	NotPositiveDefinite = 2,    ///< A non-positive pivot was found by the Cholesky factorization.
+	RankDeficient       = 3     ///< The columns of a least squares problem are linearly dependent.
+};
+
+//! Largest size of the systems which can be solved by the batched solvers.
+static const size_t gcBatchSolveMaxSize = 16;
+
+//! Solve count independent n x n systems A_i*x_i = b_i using LU factorization
+//! with partial pivoting.
+//! \param n Size of the systems, at most gcBatchSolveMaxSize.
+//! \param count Number of systems.
+//! \param A Pointer to count row-major n x n matrices stored one after another.
+//! \param b Pointer to count vectors of size n stored one after another.
+//! \param x Pointer to count vectors of size n which receive the solutions, x
+//! can be the same as b.
+//! \param status Pointer to count statuses, one per system, can be nullptr.
+//! \param numThreads Number of threads to use, 0 means use glGetNumThreads().
+//! \return The number of systems which could not be solved; their solutions
+//! are set to 0.
+//! Groups of systems are transposed into a structure-of-arrays layout and are
+//! solved together by a kernel which is unrolled for sizes up to 6 and
+//! vectorized across the systems, using AVX2 when the CPU supports it. The
+//! groups are solved in parallel. Throws SUtils::Exceptions::InvalidArgumentException
+//! if n is larger than gcBatchSolveMaxSize.
+SMATHLIB_DLL_API size_t glBatchSolveLU(size_t n, size_t count, const double* A, const double* b, double* x,
+                                       BatchSolveStatus* status = nullptr, unsigned int numThreads = 0);
+
+//! Solve count independent symmetric positive definite n x n systems using
+//! Cholesky factorization. Only the lower triangles of the matrices are read.
+//! The parameters and the return value are the same as glBatchSolveLU().
+SMATHLIB_DLL_API size_t glBatchSolveCholesky(size_t n, size_t count, const double* A, const double* b, double* x,
+                                             BatchSolveStatus* status = nullptr, unsigned int numThreads = 0);
+
+//! Solve count independent least squares problems min ||A_i*x_i - b_i||, or
+//! min sum_r w_ir*(A_i*x_i - b_i)_r^2 if weights are given, using Householder
+//! QR factorization.
+//! \param m Number of rows (equations) of each problem.
+//! \param n Number of columns (unknowns) of each problem, at most m.
+//! \param A Pointer to count row-major m x n matrices stored one after another.
+//! \param b Pointer to count vectors of size m stored one after another.
+//! \param x Pointer to count vectors of size n which receive the solutions.
+//! \param w Pointer to count vectors of m non-negative row weights, can be
+//! nullptr for unweighted problems.
+//! \return The number of problems whose matrices are rank deficient; their
+//! solutions are set to 0 and their status to RankDeficient.
+//! The problems are solved in parallel, each one on its own; there is no limit
+//! on m and n but the function is meant for many small problems, large ones
+//! are better solved by Matrix::SolveLeastSquares(). Throws
+//! SUtils::Exceptions::InvalidArgumentException if m is less than n.
+SMATHLIB_DLL_API size_t glBatchSolveLeastSquares(size_t m, size_t n, size_t count, const double* A, const double* b,
+                                                 double* x, const double* w = nullptr, BatchSolveStatus* status = nullptr,
+                                                 unsigned int numThreads = 0);
+
+};	// End namespace SMathLib.
+
+#endif // _SMATHLIB_BATCHSOLVE_H_
@@ -42,4 +42,21 @@
 #endif
 // ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
 
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+//! Enable the AVX2/FMA kernels. With GCC and Clang the kernels are compiled 
+//! using a target attribute and are selected at runtime based on the CPU; 
+//! with MSVC they are only available when compiling with /arch:AVX2.
+//! Define SMATHLIB_NO_SIMD to always use the portable kernels.
+#if !defined(SMATHLIB_NO_SIMD)
+	#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+		#define SMATHLIB_HAS_AVX2
+		#define SMATHLIB_AVX2_TARGET __attribute__((target("avx2,fma")))
+	#elif defined(_MSC_VER) && defined(__AVX2__)
+		#define SMATHLIB_HAS_AVX2
+		#define SMATHLIB_AVX2_TARGET
+	#endif
+#endif
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+
 #endif // _SMATHLIB_CONFIG_H_
@@ -0,0 +1,28 @@
+// 
+// This file is part of SLogLib; you can redistribute it and/or 
+// modify it under the terms of the MIT License.
+// Author: Saurabh Garg (saurabhgarg@mysoc.net)
+// 
+
+#include "Cpu.h"
+
+namespace SMathLib {
+;
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+bool glCpuHasAvx2()
+{
+#if defined(SMATHLIB_HAS_AVX2) && defined(_MSC_VER)
+	// MSVC only compiles the kernels with /arch:AVX2 in which case the 
+	// whole binary already requires AVX2.
+	return true;
+#elif defined(SMATHLIB_HAS_AVX2)
+	static const bool _hasAvx2 = __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+	return _hasAvx2;
+#else
+	return false;
+#endif
+}
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+
+};	// End namespace SMathLib.
@@ -0,0 +1,22 @@
+// 
+// This file is part of SLogLib; you can redistribute it and/or 
+// modify it under the terms of the MIT License.
+// Author: Saurabh Garg (saurabhgarg@mysoc.net)
+// 
+
+#ifndef _SMATHLIB_CPU_H_
+#define _SMATHLIB_CPU_H_
+
+#include "SMathLib/Config.h"
+
+namespace SMathLib {
+;
+
+//! Check if the AVX2 and FMA kernels can be used on this CPU.
+//! \return true if the library was compiled with AVX2 kernels and the CPU
+//! supports both AVX2 and FMA instructions, false otherwise.
+SMATHLIB_DLL_API bool glCpuHasAvx2();
+
+};	// End namespace SMathLib.
+
+#endif // _SMATHLIB_CPU_H_
@@ -0,0 +1,109 @@
+// 
+// This file is part of SLogLib; you can redistribute it and/or 
+// modify it under the terms of the MIT License.
+// Author: Saurabh Garg (saurabhgarg@mysoc.net)
+// 
+
+#ifndef _SMATHLIB_EIGENINTEROP_H_
+#define _SMATHLIB_EIGENINTEROP_H_
+
+#include "SMathLib/Config.h"
+#include "SMathLib/Matrix.h"
+#include "SMathLib/MatrixView.h"
+#include <Eigen/Core>
+
+namespace SMathLib {
+;
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+// Use matrices and views with Eigen without copying their elements:
+//
+//     Matrix A(n, n), B(n, k);
+//     Eigen::PartialPivLU<Eigen::MatrixXd> _lu(A.AsEigen());
+//     Matrix X(_lu.solve(B.AsEigen()));                      // Evaluated into X.
+//     glEigenOutput(C, n, k).noalias() = A.AsEigen() * X.AsEigen();
+//     A.Block(0, 0, 9, 9).AsEigen() *= 2.0;                 // Strided map.
+//
+// The maps are row-major like the matrices, so Eigen reads and writes the
+// elements in place; assigning a column-major Eigen matrix to a map reorders
+// its elements. The maps must not be used after the matrix is destroyed or
+// resized. Only this header needs Eigen, the rest of the library can be used
+// without it.
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+//! Eigen types matching the storage of MatrixT<T> and its views.
+template<typename T>
+struct EigenTypes
+{
+	typedef Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>  Matrix;
+	typedef Eigen::Stride<Eigen::Dynamic, Eigen::Dynamic>                      Stride;
+	typedef Eigen::Map<Matrix>                                                 Map;
+	typedef Eigen::Map<const Matrix>                                           ConstMap;
+	typedef Eigen::Map<Matrix, Eigen::Unaligned, Stride>                       StridedMap;
+	typedef Eigen::Map<const Matrix, Eigen::Unaligned, Stride>                 ConstStridedMap;
+};
+
+//! Resize out to rows x cols, keeping its storage if it already has that size,
+//! and return a map through which Eigen writes the result directly into it.
+//! The elements are not initialized.
+template<typename T>
+inline typename EigenTypes<T>::Map glEigenOutput(MatrixT<T>& out, size_t rows, size_t cols)
+{
+	if(out.matrix == nullptr || out.rows != rows || out.cols != cols)
+	{
+		out = MatrixT<T>(rows, cols, MatrixType::Null);
+	}
+	return out.AsEigen();
+}
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+// Definitions of the members declared in Matrix.h and MatrixView.h.
+template<typename T>
+template<typename U>
+inline typename EigenTypes<U>::Map MatrixT<T>::AsEigen()
+{
+	return typename EigenTypes<U>::Map(matrix, Eigen::Index(rows), Eigen::Index(cols));
+}
+
+template<typename T>
+template<typename U>
+inline typename EigenTypes<U>::ConstMap MatrixT<T>::AsEigen() const
+{
+	return typename EigenTypes<U>::ConstMap(matrix, Eigen::Index(rows), Eigen::Index(cols));
+}
+
+template<typename T>
+template<typename Derived>
+MatrixT<T>::MatrixT(const Eigen::MatrixBase<Derived>& expr)
+	: MatrixT(size_t(expr.rows()), size_t(expr.cols()), MatrixType::Null)
+{
+	// the new storage can't alias the operands of the expression.
+	AsEigen().noalias() = expr.derived();
+}
+
+template<typename T>
+template<typename U>
+inline typename EigenTypes<U>::ConstStridedMap ConstMatrixViewT<T>::AsEigen() const
+{
+	typedef typename EigenTypes<U>::Stride Stride;
+	return typename EigenTypes<U>::ConstStridedMap(mData, Eigen::Index(mRows), Eigen::Index(mCols),
+	                                               Stride(Eigen::Index(mRowStride), Eigen::Index(mColStride)));
+}
+
+template<typename T>
+template<typename U>
+inline typename EigenTypes<U>::StridedMap MatrixViewT<T>::AsEigen() const
+{
+	typedef typename EigenTypes<U>::Stride Stride;
+	return typename EigenTypes<U>::StridedMap(Data(), Eigen::Index(mRows), Eigen::Index(mCols),
+	                                          Stride(Eigen::Index(mRowStride), Eigen::Index(mColStride)));
+}
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+
+};	// End namespace SMathLib.
+
+#endif // _SMATHLIB_EIGENINTEROP_H_
@@ -0,0 +1,428 @@
+// 
+// This file is part of SLogLib; you can redistribute it and/or 
+// modify it under the terms of the MIT License.
+// Author: Saurabh Garg (saurabhgarg@mysoc.net)
+// 
+
+#include "Factorization.h"
+#include "Gemm.h"
+#include "SUtils/Exceptions/InvalidArgumentException.h"
+#include <Eigen/Dense>
+#include <Eigen/Cholesky>
+#include <Eigen/LU>
+#include <Eigen/QR>
+#include <cassert>
+#include <cfloat>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+namespace SMathLib {
+;
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+// Strided Eigen maps of the elements of views.
+typedef Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>  MatrixXd;
+typedef Eigen::Stride<Eigen::Dynamic, Eigen::Dynamic>                           StrideXd;
+typedef Eigen::Map<const MatrixXd, Eigen::Unaligned, StrideXd>                  ConstMapXd;
+typedef Eigen::Map<MatrixXd, Eigen::Unaligned, StrideXd>                        MapXd;
+
+static ConstMapXd EigenMap(const ConstMatrixView& A)
+{
+	return ConstMapXd(A.Data(), A.Rows(), A.Cols(), StrideXd(A.RowStride(), A.ColStride()));
+}
+
+static MapXd EigenMap(const MatrixView& A)
+{
+	return MapXd(A.Data(), A.Rows(), A.Cols(), StrideXd(A.RowStride(), A.ColStride()));
+}
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+struct LUFactorizationPriv
+{
+	Eigen::PartialPivLU<MatrixXd> mLU;
+};
+
+LUFactorization::LUFactorization()
+	: mPriv(new LUFactorizationPriv)
+{
+}
+LUFactorization::LUFactorization(const ConstMatrixView& A)
+	: mPriv(new LUFactorizationPriv)
+{
+	Compute(A);
+}
+LUFactorization::LUFactorization(LUFactorization&& B)
+	: mPriv(B.mPriv)
+{
+	B.mPriv = nullptr;
+}
+LUFactorization& LUFactorization::operator=(LUFactorization&& B)
+{
+	std::swap(mPriv, B.mPriv);
+	return *this;
+}
+LUFactorization::~LUFactorization()
+{
+	delete mPriv;
+}
+
+void LUFactorization::Compute(const ConstMatrixView& A)
+{
+	assert(A.Rows() == A.Cols());
+	mPriv->mLU.compute(EigenMap(A));
+}
+
+size_t LUFactorization::Size() const
+{
+	return size_t(mPriv->mLU.rows());
+}
+
+Matrix LUFactorization::Solve(const ConstMatrixView& B) const
+{
+	Matrix _X(B.Rows(), B.Cols(), MatrixType::Null);
+	Solve(B, _X);
+	return _X;
+}
+
+void LUFactorization::Solve(const ConstMatrixView& B, MatrixView X) const
+{
+	assert(B.Rows() == Size() && X.Rows() == Size() && X.Cols() == B.Cols());
+	
+	// The permutation and the triangular solves are done in place in X.
+	MapXd _X = EigenMap(X);
+	_X = mPriv->mLU.solve(EigenMap(B));
+}
+
+double LUFactorization::Determinant() const
+{
+	return mPriv->mLU.determinant();
+}
+
+Matrix LUFactorization::Inverse() const
+{
+	Matrix _inverse(Size(), Size(), MatrixType::Identity);
+	Solve(_inverse, _inverse);
+	return _inverse;
+}
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+struct CholeskyFactorizationPriv
+{
+	Eigen::LLT<MatrixXd, Eigen::Lower> mLLT;
+};
+
+CholeskyFactorization::CholeskyFactorization()
+	: mPriv(new CholeskyFactorizationPriv)
+{
+}
+CholeskyFactorization::CholeskyFactorization(const ConstMatrixView& A)
+	: mPriv(new CholeskyFactorizationPriv)
+{
+	Compute(A);
+}
+CholeskyFactorization::CholeskyFactorization(CholeskyFactorization&& B)
+	: mPriv(B.mPriv)
+{
+	B.mPriv = nullptr;
+}
+CholeskyFactorization& CholeskyFactorization::operator=(CholeskyFactorization&& B)
+{
+	std::swap(mPriv, B.mPriv);
+	return *this;
+}
+CholeskyFactorization::~CholeskyFactorization()
+{
+	delete mPriv;
+}
+
+void CholeskyFactorization::Compute(const ConstMatrixView& A)
+{
+	assert(A.Rows() == A.Cols());
+	mPriv->mLLT.compute(EigenMap(A));
+	if(mPriv->mLLT.info() != Eigen::Success)
+	{
+		char _msg[] = "Matrix is not positive definite in CholeskyFactorization::Compute";
+		throw SUtils::Exceptions::InvalidArgumentException(_msg);
+	}
+}
+
+size_t CholeskyFactorization::Size() const
+{
+	return size_t(mPriv->mLLT.rows());
+}
+
+Matrix CholeskyFactorization::Solve(const ConstMatrixView& B) const
+{
+	Matrix _X(B.Rows(), B.Cols(), MatrixType::Null);
+	Solve(B, _X);
+	return _X;
+}
+
+void CholeskyFactorization::Solve(const ConstMatrixView& B, MatrixView X) const
+{
+	assert(B.Rows() == Size() && X.Rows() == Size() && X.Cols() == B.Cols());
+	
+	// B is copied into X and both triangular solves are done in place.
+	MapXd _X = EigenMap(X);
+	_X = mPriv->mLLT.solve(EigenMap(B));
+}
+
+double CholeskyFactorization::Determinant() const
+{
+	// det(A) = det(L)^2 and L is triangular.
+	const double _detL = mPriv->mLLT.matrixLLT().diagonal().prod();
+	return _detL * _detL;
+}
+
+Matrix CholeskyFactorization::Inverse() const
+{
+	Matrix _inverse(Size(), Size(), MatrixType::Identity);
+	Solve(_inverse, _inverse);
+	return _inverse;
+}
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+struct QRFactorizationPriv
+{
+	Eigen::ColPivHouseholderQR<MatrixXd> mQR;
+	
+	// Buffers for Q^T*B and for applying the Householder reflections, these
+	// keep their allocation between solves with the same number of columns.
+	Eigen::MatrixXd                          mQtB;
+	Eigen::Matrix<double, 1, Eigen::Dynamic> mWorkspace;
+};
+
+QRFactorization::QRFactorization()
+	: mPriv(new QRFactorizationPriv)
+{
+}
+QRFactorization::QRFactorization(const ConstMatrixView& A)
+	: mPriv(new QRFactorizationPriv)
+{
+	Compute(A);
+}
+QRFactorization::QRFactorization(QRFactorization&& B)
+	: mPriv(B.mPriv)
+{
+	B.mPriv = nullptr;
+}
+QRFactorization& QRFactorization::operator=(QRFactorization&& B)
+{
+	std::swap(mPriv, B.mPriv);
+	return *this;
+}
+QRFactorization::~QRFactorization()
+{
+	delete mPriv;
+}
+
+void QRFactorization::Compute(const ConstMatrixView& A)
+{
+	assert(A.Rows() >= A.Cols());
+	mPriv->mQR.compute(EigenMap(A));
+}
+
+size_t QRFactorization::Rows() const
+{
+	return size_t(mPriv->mQR.rows());
+}
+
+size_t QRFactorization::Cols() const
+{
+	return size_t(mPriv->mQR.cols());
+}
+
+size_t QRFactorization::Rank() const
+{
+	return size_t(mPriv->mQR.rank());
+}
+
+Matrix QRFactorization::Solve(const ConstMatrixView& B) const
+{
+	Matrix _X(Cols(), B.Cols(), MatrixType::Null);
+	Solve(B, _X);
+	return _X;
+}
+
+void QRFactorization::Solve(const ConstMatrixView& B, MatrixView X) const
+{
+	assert(B.Rows() == Rows() && X.Rows() == Cols() && X.Cols() == B.Cols());
+	
+	const Eigen::ColPivHouseholderQR<MatrixXd>& _qr   = mPriv->mQR;
+	const Eigen::Index                          _rank = _qr.rank();
+	
+	// Q^T*B, only the first rank rows are needed for the solution.
+	Eigen::MatrixXd& _QtB = mPriv->mQtB;
+	_QtB = EigenMap(B);
+	_qr.householderQ().setLength(_qr.nonzeroPivots()).adjoint().applyThisOnTheLeft(_QtB, mPriv->mWorkspace);
+	
+	// R*P^T*X = Q^T*B, the components of X outside the rank are set to 0.
+	_qr.matrixR().topLeftCorner(_rank, _rank).triangularView<Eigen::Upper>().solveInPlace(_QtB.topRows(_rank));
+	
+	MapXd _X = EigenMap(X);
+	const Eigen::Index _cols = Eigen::Index(Cols());
+	for(Eigen::Index i=0 ; i<_cols ; ++i)
+	{
+		const Eigen::Index _row = _qr.colsPermutation().indices()(i);
+		if(i < _rank)
+		{
+			_X.row(_row) = _QtB.row(i);
+		}
+		else
+		{
+			_X.row(_row).setZero();
+		}
+	}
+}
+
+double QRFactorization::Determinant() const
+{
+	assert(Rows() == Cols());
+	
+	// det(A) = det(Q)*det(R)*det(P^T). Q is a product of Householder
+	// reflections, each of which has determinant -1 unless it is the identity.
+	const Eigen::ColPivHouseholderQR<MatrixXd>& _qr = mPriv->mQR;
+	double _det = _qr.matrixR().diagonal().prod();
+	for(Eigen::Index i=0 ; i<_qr.hCoeffs().size() ; ++i)
+	{
+		if(_qr.hCoeffs()(i) != 0.0)
+		{
+			_det = -_det;
+		}
+	}
+	return _det * double(_qr.colsPermutation().determinant());
+}
+
+Matrix QRFactorization::Inverse() const
+{
+	assert(Rows() == Cols());
+	Matrix _inverse(Cols(), Cols(), MatrixType::Identity);
+	Solve(_inverse, _inverse);
+	return _inverse;
+}
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+MixedSolveOptions::MixedSolveOptions()
+	: maxIterations(10), tolerance(0.0), numThreads(0)
+{}
+
+MixedSolveResult::MixedSolveResult()
+	: converged(false), fallback(false), iterations(0), backwardError(0.0)
+{}
+
+// R = B - A*X, computed in double.
+static void Residual(const ConstMatrixView& A, const Matrix& X, const ConstMatrixView& B, Matrix& R,
+                     unsigned int numThreads)
+{
+	EigenMap(R.View()) = EigenMap(B);
+	glGemmStrided(A.Rows(), X.cols, A.Cols(), -1.0, A.Data(), A.RowStride(), A.ColStride(),
+	              X.matrix, X.cols, 1, 1.0, R.matrix, R.cols, numThreads);
+}
+
+// Largest normwise backward error of the columns, infinity if an element of R
+// or X is not finite.
+static double BackwardError(double normA, const Matrix& R, const Matrix& X, const ConstMatrixView& B)
+{
+	double _error = 0.0;
+	for(size_t j=0 ; j<X.cols ; ++j)
+	{
+		double _r = 0.0, _x = 0.0, _b = 0.0;
+		for(size_t i=0 ; i<X.rows ; ++i)
+		{
+			const double _ri = R.matrix[i*R.cols+j];
+			const double _xi = X.matrix[i*X.cols+j];
+			
+			// std::max() would drop NaNs.
+			if(!std::isfinite(_ri) || !std::isfinite(_xi))
+			{
+				return std::numeric_limits<double>::infinity();
+			}
+			_r = std::max(_r, std::fabs(_ri));
+			_x = std::max(_x, std::fabs(_xi));
+			_b = std::max(_b, std::fabs(B(i, j)));
+		}
+		
+		const double _denominator = normA*_x + _b;
+		const double _e           = _denominator > 0.0 ? _r / _denominator : _r;
+		_error = std::max(_error, _e);
+	}
+	return _error;
+}
+
+MixedSolveResult glSolveMixedPrecision(const ConstMatrixView& A, const ConstMatrixView& B, Matrix& X,
+                                       const MixedSolveOptions& options)
+{
+	if(A.Rows() != A.Cols() || A.Rows() != B.Rows())
+	{
+		char _msg[] = "A must be square with as many rows as B in glSolveMixedPrecision";
+		throw SUtils::Exceptions::InvalidArgumentException(_msg);
+	}
+	
+	const size_t _n    = A.Rows();
+	const size_t _nrhs = B.Cols();
+	if(X.rows != _n || X.cols != _nrhs)
+	{
+		X = Matrix(_n, _nrhs, MatrixType::Null);
+	}
+	MixedSolveResult _result;
+	if(_n == 0 || _nrhs == 0)
+	{
+		_result.converged = true;
+		return _result;
+	}
+	
+	const double _tolerance = options.tolerance > 0.0 ? options.tolerance : std::sqrt(double(_n)) * DBL_EPSILON;
+	const ConstMapXd _A     = EigenMap(A);
+	const double     _normA = _A.cwiseAbs().rowwise().sum().maxCoeff();
+	MapXd            _X     = EigenMap(X.View());
+	Matrix           _R(_n, _nrhs, MatrixType::Null);
+	
+	// the elements of A must be representable in float, NaNs fail the test.
+	if(_A.cwiseAbs().maxCoeff() < double(FLT_MAX))
+	{
+		Eigen::PartialPivLU<Eigen::MatrixXf> _lu(_A.cast<float>());
+		_X = _lu.solve(EigenMap(B).cast<float>()).cast<double>();
+		
+		// each sweep solves for the correction with the float factors. The
+		// refinement is stopped when the error does not at least halve, which
+		// includes an infinite error from NaNs of a singular float LU.
+		double _previous = std::numeric_limits<double>::infinity();
+		for(;;)
+		{
+			Residual(A, X, B, _R, options.numThreads);
+			_result.backwardError = BackwardError(_normA, _R, X, B);
+			if(_result.backwardError <= _tolerance)
+			{
+				_result.converged = true;
+				return _result;
+			}
+			if(!(_result.backwardError < 0.5*_previous) || _result.iterations == options.maxIterations)
+			{
+				break;
+			}
+			_previous = _result.backwardError;
+			_X += _lu.solve(EigenMap(_R.View()).cast<float>()).cast<double>();
+			++_result.iterations;
+		}
+	}
+	
+	// fall back to the factorization in double.
+	_result.fallback = true;
+	LUFactorization(A).Solve(B, X);
+	Residual(A, X, B, _R, options.numThreads);
+	_result.backwardError = BackwardError(_normA, _R, X, B);
+	_result.converged     = _result.backwardError <= _tolerance;
+	return _result;
+}
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+
+};	// End namespace SMathLib.
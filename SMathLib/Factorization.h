@@ -0,0 +1,190 @@
+// 
+// This file is part of SLogLib; you can redistribute it and/or 
+// modify it under the terms of the MIT License.
+// Author: Saurabh Garg (saurabhgarg@mysoc.net)
+// 
+
+#ifndef _SMATHLIB_FACTORIZATION_H_
+#define _SMATHLIB_FACTORIZATION_H_
+
+#include "SMathLib/Config.h"
+#include "SMathLib/Matrix.h"
+#include "SMathLib/MatrixView.h"
+
+namespace SMathLib {
+;
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+// Factorizations of a matrix A which are computed once and then used to solve
+// A*X = B for any number of right-hand sides without factorizing A again:
+//
+//     LUFactorization _lu(A);
+//     for(...)
+//     {
+//         _lu.Solve(b, x);    // No factorization and no allocation.
+//     }
+//
+// B can have one column (a single right-hand side) or many. The overloads of
+// Solve() which take X write the solution into existing storage, X can also
+// be B itself to solve in place. The factorizations can be moved but not
+// copied.
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+struct LUFactorizationPriv;
+
+//! LU factorization with partial pivoting, P*A = L*U, of a square invertible
+//! matrix.
+class SMATHLIB_DLL_API LUFactorization
+{
+public:  // Constructors.
+
+	LUFactorization();
+	explicit LUFactorization(const ConstMatrixView& A);
+	LUFactorization(LUFactorization&& B);
+	LUFactorization& operator=(LUFactorization&& B);
+	~LUFactorization();
+	
+	LUFactorization(const LUFactorization&) = delete;
+	LUFactorization& operator=(const LUFactorization&) = delete;
+
+public:  // Factorization.
+
+	//! Factorize A, reusing the storage of the previous factorization.
+	void   Compute(const ConstMatrixView& A);
+	size_t Size() const;
+
+public:  // Use the factorization.
+
+	Matrix Solve(const ConstMatrixView& B) const;
+	void   Solve(const ConstMatrixView& B, MatrixView X) const;
+	double Determinant() const;
+	Matrix Inverse() const;
+
+private:
+
+	LUFactorizationPriv* mPriv;
+};
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+struct CholeskyFactorizationPriv;
+
+//! Cholesky factorization, A = L*L^T, of a symmetric positive definite matrix.
+//! Only the lower triangle of A is read. Compute() throws
+//! SUtils::Exceptions::InvalidArgumentException if A is not positive definite.
+class SMATHLIB_DLL_API CholeskyFactorization
+{
+public:  // Constructors.
+
+	CholeskyFactorization();
+	explicit CholeskyFactorization(const ConstMatrixView& A);
+	CholeskyFactorization(CholeskyFactorization&& B);
+	CholeskyFactorization& operator=(CholeskyFactorization&& B);
+	~CholeskyFactorization();
+	
+	CholeskyFactorization(const CholeskyFactorization&) = delete;
+	CholeskyFactorization& operator=(const CholeskyFactorization&) = delete;
+
+public:  // Factorization.
+
+	//! Factorize A, reusing the storage of the previous factorization.
+	void   Compute(const ConstMatrixView& A);
+	size_t Size() const;
+
+public:  // Use the factorization.
+
+	Matrix Solve(const ConstMatrixView& B) const;
+	void   Solve(const ConstMatrixView& B, MatrixView X) const;
+	double Determinant() const;
+	Matrix Inverse() const;
+
+private:
+
+	CholeskyFactorizationPriv* mPriv;
+};
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+struct QRFactorizationPriv;
+
+//! QR factorization with column pivoting, A*P = Q*R, of a m x n matrix with
+//! m >= n. For m > n Solve() returns the least-squares solution which minimizes
+//! |A*X - B|. Determinant() and Inverse() require a square matrix. Solve()
+//! uses a buffer stored in the factorization, so a QRFactorization must not be
+//! used by several threads at the same time.
+class SMATHLIB_DLL_API QRFactorization
+{
+public:  // Constructors.
+
+	QRFactorization();
+	explicit QRFactorization(const ConstMatrixView& A);
+	QRFactorization(QRFactorization&& B);
+	QRFactorization& operator=(QRFactorization&& B);
+	~QRFactorization();
+	
+	QRFactorization(const QRFactorization&) = delete;
+	QRFactorization& operator=(const QRFactorization&) = delete;
+
+public:  // Factorization.
+
+	//! Factorize A, reusing the storage of the previous factorization.
+	void   Compute(const ConstMatrixView& A);
+	size_t Rows() const;
+	size_t Cols() const;
+	size_t Rank() const;
+
+public:  // Use the factorization.
+
+	Matrix Solve(const ConstMatrixView& B) const;
+	void   Solve(const ConstMatrixView& B, MatrixView X) const;
+	double Determinant() const;
+	Matrix Inverse() const;
+
+private:
+
+	QRFactorizationPriv* mPriv;
+};
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+//! Options of glSolveMixedPrecision().
+struct SMATHLIB_DLL_API MixedSolveOptions
+{
+	MixedSolveOptions();
+	
+	size_t       maxIterations;   ///< Maximum number of refinement sweeps, default 10.
+	double       tolerance;       ///< Backward error to reach, default 0 which means sqrt(n)*DBL_EPSILON.
+	unsigned int numThreads;      ///< Threads of the residual products, 0 means use glGetNumThreads(), the default.
+};
+
+//! Outcome of glSolveMixedPrecision().
+struct SMATHLIB_DLL_API MixedSolveResult
+{
+	MixedSolveResult();
+	
+	bool   converged;       ///< The backward error is at most the tolerance.
+	bool   fallback;        ///< The refinement failed and the system was solved by a double LU.
+	size_t iterations;      ///< Number of refinement sweeps performed.
+	double backwardError;   ///< Largest normwise backward error |b-A*x|/(|A|*|x| + |b|) of the columns, in the infinity norm; infinity if x is not finite.
+};
+
+//! Solve A*X = B for a square A by mixed-precision iterative refinement: A is
+//! factorized by LU with partial pivoting in float, which is about twice as
+//! fast as in double, and the solution is refined with residuals computed in
+//! double until its backward error reaches the tolerance. If A does not fit
+//! in float, the refinement stalls or it does not converge in maxIterations
+//! sweeps, the system is solved again by LU in double. This is as accurate as
+//! SolveAxB() when A is not too ill-conditioned (condition number well below
+//! 1/FLT_EPSILON, about 10^7). X is resized to the size of B.
+SMATHLIB_DLL_API MixedSolveResult glSolveMixedPrecision(const ConstMatrixView& A, const ConstMatrixView& B, Matrix& X,
+                                                        const MixedSolveOptions& options = MixedSolveOptions());
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+
+};	// End namespace SMathLib.
+
+#endif // _SMATHLIB_FACTORIZATION_H_
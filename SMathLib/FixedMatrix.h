@@ -0,0 +1,155 @@
+// 
+// This file is part of SLogLib; you can redistribute it and/or 
+// modify it under the terms of the MIT License.
+// Author: Saurabh Garg (saurabhgarg@mysoc.net)
+// 
+
+#ifndef _SMATHLIB_FIXEDMATRIX_H_
+#define _SMATHLIB_FIXEDMATRIX_H_
+
+#include "SUtils/NoBoundChecking.h"
+#include "SUtils/StaticCheck.h"
+#include "SMathLib/Matrix.h"
+#include "SMathLib/MatrixView.h"
+#include "SMathLib/VectorOnStack.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#include <ostream>
+
+namespace SMathLib {
+;
+
+//! Class for creating a R x C matrix on a stack.
+//! The elements are stored in row-major order. The sizes are known at compile
+//! time, so all the loops of the arithmetic operations are unrolled and no
+//! memory is allocated; the class is meant for small matrices such as 3x3 and
+//! 4x4 transforms. Use Matrix for matrices whose size is known at run time.
+//! \param ET The type of the elements stored in the matrix.
+//! \param R The number of rows of the matrix.
+//! \param C The number of columns of the matrix.
+//! \param CP Bound checking policy for element access.
+template<typename ET, unsigned int R, unsigned int C, typename CP = SUtils::NoBoundChecking>
+class FixedMatrix
+{
+public:    // Typedefs.
+
+	//! Define the type of elements stored in matrix.
+	typedef ET ValueType;
+	typedef ET value_type;
+	
+	//! Define the type of this matrix.
+	typedef FixedMatrix<ET, R, C, CP> FixedMatrixType;
+	
+	//! Define the types of the rows and the columns of this matrix.
+	typedef VectorOnStack<ET, C, CP> RowType;
+	typedef VectorOnStack<ET, R, CP> ColType;
+	
+	//! Number of rows and columns.
+	static const unsigned int ROWS = R;
+	static const unsigned int COLS = C;
+
+public: // Constructors.
+
+	FixedMatrix();
+	explicit FixedMatrix(const ValueType& s);
+	explicit FixedMatrix(const ValueType* const data);
+	explicit FixedMatrix(const ConstMatrixView& B);
+	FixedMatrix(const FixedMatrix& B);
+	FixedMatrix& operator = (const FixedMatrix& B);
+	
+	static FixedMatrixType Identity();
+
+public: // Indexing operators.
+
+	ValueType& operator () (unsigned int r, unsigned int c);
+	const ValueType& operator () (unsigned int r, unsigned int c) const;
+	ValueType& operator [] (unsigned int index);
+	const ValueType& operator [] (unsigned int index) const;
+	
+	RowType Row(unsigned int r) const;
+	ColType Col(unsigned int c) const;
+	void    SetRow(unsigned int r, const RowType& v);
+	void    SetCol(unsigned int c, const ColType& v);
+
+public:	// Logical operators.
+
+	bool operator == (const FixedMatrixType& B) const;
+	bool operator != (const FixedMatrixType& B) const;
+
+public:	// Matrix-Matrix arithmetic operators.
+
+	FixedMatrixType  operator +  (const FixedMatrixType& B) const;
+	FixedMatrixType  operator -  (const FixedMatrixType& B) const;
+	FixedMatrixType& operator += (const FixedMatrixType& B);
+	FixedMatrixType& operator -= (const FixedMatrixType& B);
+	FixedMatrixType  operator -  () const;
+	
+	template<unsigned int C2>
+	FixedMatrix<ET, R, C2, CP> operator * (const FixedMatrix<ET, C, C2, CP>& B) const;
+	FixedMatrixType& operator *= (const FixedMatrix<ET, C, C, CP>& B);
+
+public:	// Matrix-Vector arithmetic operators.
+
+	template<typename CP1>
+	ColType operator * (const VectorOnStack<ET, C, CP1>& v) const;
+
+public:	// Matrix-Scalar arithmetic operators.
+
+	template<typename ST> FixedMatrixType  operator *  (const ST& s) const;
+	template<typename ST> FixedMatrixType  operator /  (const ST& s) const;
+	template<typename ST> FixedMatrixType& operator *= (const ST& s);
+	template<typename ST> FixedMatrixType& operator /= (const ST& s);
+
+public: // Functions.
+
+	FixedMatrix<ET, C, R, CP> Transpose() const;
+	ValueType                 Determinant() const;
+	FixedMatrixType           Inverse() const;
+	ValueType                 Trace() const;
+
+public: // Interoperability with Matrix.
+
+	//! Copy the elements into a dynamic matrix.
+	Matrix ToMatrix() const;
+	
+	//! Views of the elements which can be passed wherever a Matrix is
+	//! accepted as ConstMatrixView or MatrixView. Only for double elements.
+	ConstMatrixView View() const;
+	MatrixView      View();
+
+public: // Inline functions.
+
+	//! Get the const pointer to the internal array.
+	//! \return The const pointer to the internal array storing the matrix.
+	inline const ValueType* ConstData() const {return mMatrixData;}
+	
+	//! Get the pointer to the internal array.
+	//! \return The pointer to the internal array storing the matrix.
+	inline ValueType* Data() {return mMatrixData;}
+	
+	//! Number of rows and columns of the matrix.
+	inline unsigned int Rows() const {return R;}
+	inline unsigned int Cols() const {return C;}
+
+private: // Variables.
+
+	//! Storage space for the matrix.
+	ValueType mMatrixData[R*C];
+};
+
+// Include implementation.
+#include "Impl/FixedMatrix.hpp"
+
+// Define some commonly used type of matrices.
+typedef FixedMatrix<float, 2, 2>  FixedMatrixF2;
+typedef FixedMatrix<float, 3, 3>  FixedMatrixF3;
+typedef FixedMatrix<float, 4, 4>  FixedMatrixF4;
+typedef FixedMatrix<double, 2, 2> FixedMatrixD2;
+typedef FixedMatrix<double, 3, 3> FixedMatrixD3;
+typedef FixedMatrix<double, 4, 4> FixedMatrixD4;
+
+};	// End namespace SMathLib.
+
+#endif // _SMATHLIB_FIXEDMATRIX_H_
@@ -0,0 +1,605 @@
+// 
+// This file is part of SLogLib; you can redistribute it and/or 
+// modify it under the terms of the MIT License.
+// Author: Saurabh Garg (saurabhgarg@mysoc.net)
+// 
+
+#include "Gemm.h"
+#include "Cpu.h"
+#include "Parallel.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+#if defined(SMATHLIB_HAS_AVX2)
+	#include <immintrin.h>
+#endif
+
+namespace SMathLib {
+;
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+// The product is computed as described in "Anatomy of High-Performance Matrix
+// Multiplication" by Goto and van de Geijn. A KC x NC block of B is packed so
+// that it stays in L3 cache, a MC x KC block of A is packed so that it stays in
+// L2 cache, and the micro-kernel computes a MR x NR block of C in registers
+// while streaming through one packed sliver of A and B.
+
+// Size of the block of C computed by the micro-kernel.
+static const size_t gcMR = 6;
+static const size_t gcNR = 8;
+
+// Size of the packed blocks of A and B.
+static const size_t gcMC = 96;
+static const size_t gcKC = 256;
+static const size_t gcNC = 2048;
+
+// Products with less than these many multiply-adds don't benefit from packing.
+static const size_t gcSmallGemm = 32*32*32;
+
+// Minimum number of multiply-adds computed by one thread.
+static const size_t gcParallelGemm = 128*128*128;
+
+// The micro-kernel computes C = alpha*Ap*Bp + beta*C for a MR x NR block of C.
+typedef void (*GemmKernel)(size_t kc, const double* Ap, const double* Bp,
+                           double alpha, double beta, double* C, size_t ldc);
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+// Pack a mc x kc block of A into slivers of MR rows. Each sliver is stored
+// column by column and the last sliver is padded with zeros.
+static void PackA(size_t mc, size_t kc, const double* A, size_t rsa, size_t csa, double* Ap)
+{
+	for(size_t i=0 ; i<mc ; i+=gcMR)
+	{
+		const size_t _mr = std::min(gcMR, mc-i);
+		for(size_t p=0 ; p<kc ; ++p)
+		{
+			const double* _a = A + i*rsa + p*csa;
+			for(size_t r=0 ; r<_mr ; ++r)
+			{
+				Ap[r] = _a[r*rsa];
+			}
+			for(size_t r=_mr ; r<gcMR ; ++r)
+			{
+				Ap[r] = 0.0;
+			}
+			Ap += gcMR;
+		}
+	}
+}
+
+// Pack a kc x nc block of B into slivers of NR columns. Each sliver is stored
+// row by row and the last sliver is padded with zeros.
+static void PackB(size_t kc, size_t nc, const double* B, size_t rsb, size_t csb, double* Bp)
+{
+	for(size_t j=0 ; j<nc ; j+=gcNR)
+	{
+		const size_t _nr = std::min(gcNR, nc-j);
+		for(size_t p=0 ; p<kc ; ++p)
+		{
+			const double* _b = B + p*rsb + j*csb;
+			if(csb == 1 && _nr == gcNR)
+			{
+				memcpy(Bp, _b, gcNR*sizeof(double));
+			}
+			else
+			{
+				for(size_t c=0 ; c<_nr ; ++c)
+				{
+					Bp[c] = _b[c*csb];
+				}
+				for(size_t c=_nr ; c<gcNR ; ++c)
+				{
+					Bp[c] = 0.0;
+				}
+			}
+			Bp += gcNR;
+		}
+	}
+}
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+// Portable micro-kernel.
+static void KernelScalar(size_t kc, const double* Ap, const double* Bp,
+                         double alpha, double beta, double* C, size_t ldc)
+{
+	double _ab[gcMR*gcNR] = {0};
+	for(size_t p=0 ; p<kc ; ++p)
+	{
+		for(size_t i=0 ; i<gcMR ; ++i)
+		{
+			const double _a = Ap[i];
+			for(size_t j=0 ; j<gcNR ; ++j)
+			{
+				_ab[i*gcNR+j] += _a * Bp[j];
+			}
+		}
+		Ap += gcMR;
+		Bp += gcNR;
+	}
+	
+	for(size_t i=0 ; i<gcMR ; ++i)
+	{
+		for(size_t j=0 ; j<gcNR ; ++j)
+		{
+			if(beta == 0.0)
+			{
+				C[i*ldc+j] = alpha * _ab[i*gcNR+j];
+			}
+			else
+			{
+				C[i*ldc+j] = alpha * _ab[i*gcNR+j] + beta * C[i*ldc+j];
+			}
+		}
+	}
+}
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+
+
+#if defined(SMATHLIB_HAS_AVX2)
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+// AVX2/FMA micro-kernel. The 6x8 block of C is kept in 12 ymm registers, which
+// leaves enough registers for one broadcast of A and two rows of B.
+#define SMATHLIB_GEMM_FMA(r)                           \
+	_a = _mm256_broadcast_sd(Ap + r);                   \
+	_c##r##0 = _mm256_fmadd_pd(_a, _b0, _c##r##0);      \
+	_c##r##1 = _mm256_fmadd_pd(_a, _b1, _c##r##1);
+
+#define SMATHLIB_GEMM_STORE(r)                                             \
+	{                                                                       \
+		double* _cr = C + r*ldc;                                            \
+		__m256d _x0 = _mm256_mul_pd(_alpha, _c##r##0);                      \
+		__m256d _x1 = _mm256_mul_pd(_alpha, _c##r##1);                      \
+		if(beta != 0.0)                                                     \
+		{                                                                   \
+			_x0 = _mm256_fmadd_pd(_beta, _mm256_loadu_pd(_cr    ), _x0);    \
+			_x1 = _mm256_fmadd_pd(_beta, _mm256_loadu_pd(_cr + 4), _x1);    \
+		}                                                                   \
+		_mm256_storeu_pd(_cr    , _x0);                                     \
+		_mm256_storeu_pd(_cr + 4, _x1);                                     \
+	}
+
+SMATHLIB_AVX2_TARGET
+static void KernelAvx2(size_t kc, const double* Ap, const double* Bp,
+                       double alpha, double beta, double* C, size_t ldc)
+{
+	__m256d _c00 = _mm256_setzero_pd(), _c01 = _mm256_setzero_pd();
+	__m256d _c10 = _mm256_setzero_pd(), _c11 = _mm256_setzero_pd();
+	__m256d _c20 = _mm256_setzero_pd(), _c21 = _mm256_setzero_pd();
+	__m256d _c30 = _mm256_setzero_pd(), _c31 = _mm256_setzero_pd();
+	__m256d _c40 = _mm256_setzero_pd(), _c41 = _mm256_setzero_pd();
+	__m256d _c50 = _mm256_setzero_pd(), _c51 = _mm256_setzero_pd();
+	
+	for(size_t p=0 ; p<kc ; ++p)
+	{
+		const __m256d _b0 = _mm256_loadu_pd(Bp    );
+		const __m256d _b1 = _mm256_loadu_pd(Bp + 4);
+		__m256d _a;
+		
+		SMATHLIB_GEMM_FMA(0)
+		SMATHLIB_GEMM_FMA(1)
+		SMATHLIB_GEMM_FMA(2)
+		SMATHLIB_GEMM_FMA(3)
+		SMATHLIB_GEMM_FMA(4)
+		SMATHLIB_GEMM_FMA(5)
+		
+		Ap += gcMR;
+		Bp += gcNR;
+	}
+	
+	const __m256d _alpha = _mm256_set1_pd(alpha);
+	const __m256d _beta  = _mm256_set1_pd(beta);
+	SMATHLIB_GEMM_STORE(0)
+	SMATHLIB_GEMM_STORE(1)
+	SMATHLIB_GEMM_STORE(2)
+	SMATHLIB_GEMM_STORE(3)
+	SMATHLIB_GEMM_STORE(4)
+	SMATHLIB_GEMM_STORE(5)
+}
+
+#undef SMATHLIB_GEMM_FMA
+#undef SMATHLIB_GEMM_STORE
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+#endif
+
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+// Scale C with beta; if beta is 0 then C is set to 0 without reading it.
+static void ScaleC(size_t m, size_t n, double beta, double* C, size_t ldc)
+{
+	for(size_t i=0 ; i<m ; ++i)
+	{
+		double* _c = C + i*ldc;
+		if(beta == 0.0)
+		{
+			memset(_c, 0, n*sizeof(double));
+		}
+		else if(beta != 1.0)
+		{
+			for(size_t j=0 ; j<n ; ++j)
+			{
+				_c[j] *= beta;
+			}
+		}
+	}
+}
+
+// Unpacked product for small matrices where packing costs more than it saves.
+static void GemmSmall(size_t m, size_t n, size_t k,
+                      double alpha, const double* A, size_t rsa, size_t csa,
+                                    const double* B, size_t rsb, size_t csb,
+                      double beta ,       double* C, size_t ldc)
+{
+	ScaleC(m, n, beta, C, ldc);
+	for(size_t i=0 ; i<m ; ++i)
+	{
+		double* _c = C + i*ldc;
+		for(size_t p=0 ; p<k ; ++p)
+		{
+			const double  _a = alpha * A[i*rsa + p*csa];
+			const double* _b = B + p*rsb;
+			for(size_t j=0 ; j<n ; ++j)
+			{
+				_c[j] += _a * _b[j*csb];
+			}
+		}
+	}
+}
+
+// Packed and blocked product.
+static void GemmPacked(size_t m, size_t n, size_t k,
+                       double alpha, const double* A, size_t rsa, size_t csa,
+                                     const double* B, size_t rsb, size_t csb,
+                       double beta ,       double* C, size_t ldc)
+{
+	// The packing buffers are reused by all the products on a thread.
+	static thread_local std::vector<double> _bufferA;
+	static thread_local std::vector<double> _bufferB;
+	
+	const size_t _kcMax = std::min(gcKC, k);
+	const size_t _mcMax = std::min(gcMC, (m + gcMR - 1) / gcMR * gcMR);
+	const size_t _ncMax = std::min(gcNC, (n + gcNR - 1) / gcNR * gcNR);
+	if(_bufferA.size() < _mcMax*_kcMax) _bufferA.resize(_mcMax*_kcMax);
+	if(_bufferB.size() < _kcMax*_ncMax) _bufferB.resize(_kcMax*_ncMax);
+	double* _Ap = _bufferA.data();
+	double* _Bp = _bufferB.data();
+	
+	GemmKernel _kernel = KernelScalar;
+#if defined(SMATHLIB_HAS_AVX2)
+	if(glCpuHasAvx2())
+	{
+		_kernel = KernelAvx2;
+	}
+#endif
+
+	for(size_t jc=0 ; jc<n ; jc+=gcNC)
+	{
+		const size_t _nc = std::min(gcNC, n-jc);
+		for(size_t pc=0 ; pc<k ; pc+=gcKC)
+		{
+			const size_t _kc   = std::min(gcKC, k-pc);
+			const double _beta = (pc == 0) ? beta : 1.0;
+			PackB(_kc, _nc, B + pc*rsb + jc*csb, rsb, csb, _Bp);
+			
+			for(size_t ic=0 ; ic<m ; ic+=gcMC)
+			{
+				const size_t _mc = std::min(gcMC, m-ic);
+				PackA(_mc, _kc, A + ic*rsa + pc*csa, rsa, csa, _Ap);
+				
+				for(size_t jr=0 ; jr<_nc ; jr+=gcNR)
+				{
+					const size_t _nr = std::min(gcNR, _nc-jr);
+					for(size_t ir=0 ; ir<_mc ; ir+=gcMR)
+					{
+						const size_t  _mr = std::min(gcMR, _mc-ir);
+						const double* _a  = _Ap + ir*_kc;
+						const double* _b  = _Bp + jr*_kc;
+						double*       _c  = C + (ic+ir)*ldc + jc+jr;
+						
+						if(_mr == gcMR && _nr == gcNR)
+						{
+							_kernel(_kc, _a, _b, alpha, _beta, _c, ldc);
+						}
+						else
+						{
+							// Compute the full block in a buffer and only copy
+							// the part which lies inside C.
+							double _ab[gcMR*gcNR];
+							_kernel(_kc, _a, _b, 1.0, 0.0, _ab, gcNR);
+							for(size_t i=0 ; i<_mr ; ++i)
+							{
+								for(size_t j=0 ; j<_nr ; ++j)
+								{
+									double& _cij = _c[i*ldc+j];
+									_cij = (_beta == 0.0) ? alpha*_ab[i*gcNR+j]
+									                      : alpha*_ab[i*gcNR+j] + _beta*_cij;
+								}
+							}
+						}
+					}
+				}
+			}
+		}
+	}
+}
+
+// Product of matrices with arbitrary row and column strides.
+static void GemmStrided(size_t m, size_t n, size_t k,
+                        double alpha, const double* A, size_t rsa, size_t csa,
+                                      const double* B, size_t rsb, size_t csb,
+                        double beta ,       double* C, size_t ldc)
+{
+	if(m == 0 || n == 0)
+	{
+		return;
+	}
+	
+	if(k == 0 || alpha == 0.0)
+	{
+		ScaleC(m, n, beta, C, ldc);
+	}
+	else if(m*n*k < gcSmallGemm)
+	{
+		GemmSmall(m, n, k, alpha, A, rsa, csa, B, rsb, csb, beta, C, ldc);
+	}
+	else
+	{
+		GemmPacked(m, n, k, alpha, A, rsa, csa, B, rsb, csb, beta, C, ldc);
+	}
+}
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+// Split C into a grid of tiles and compute each tile on a separate thread. The
+// shape of the grid follows the shape of C to reduce the parts of A and B which
+// are packed by more than one thread. Every element of C is computed by exactly
+// the same sequence of operations for a given number of threads.
+static void GemmParallel(size_t m, size_t n, size_t k,
+                         double alpha, const double* A, size_t rsa, size_t csa,
+                                       const double* B, size_t rsb, size_t csb,
+                         double beta ,       double* C, size_t ldc,
+                         unsigned int numThreads)
+{
+	if(numThreads == 0)
+	{
+		numThreads = glGetNumThreads();
+	}
+	
+	const size_t _numTiles = std::min<size_t>(numThreads, m*n*k / gcParallelGemm);
+	if(_numTiles <= 1)
+	{
+		GemmStrided(m, n, k, alpha, A, rsa, csa, B, rsb, csb, beta, C, ldc);
+		return;
+	}
+	
+	size_t _tr = size_t(std::sqrt(double(_numTiles) * double(m) / double(n)) + 0.5);
+	_tr = std::min(std::max<size_t>(_tr, 1), _numTiles);
+	size_t _tc = std::max<size_t>(_numTiles / _tr, 1);
+	
+	const size_t _tileM = ((m + _tr - 1) / _tr + gcMR - 1) / gcMR * gcMR;
+	const size_t _tileN = ((n + _tc - 1) / _tc + gcNR - 1) / gcNR * gcNR;
+	const size_t _gridM = (m + _tileM - 1) / _tileM;
+	const size_t _gridN = (n + _tileN - 1) / _tileN;
+	
+	glParallelFor(0, _gridM*_gridN, 1, [&](size_t t1, size_t t2)
+	{
+		for(size_t t=t1 ; t<t2 ; ++t)
+		{
+			const size_t i = (t / _gridN) * _tileM;
+			const size_t j = (t % _gridN) * _tileN;
+			GemmStrided(std::min(_tileM, m-i), std::min(_tileN, n-j), k,
+			            alpha, A + i*rsa, rsa, csa,
+			                   B + j*csb, rsb, csb,
+			            beta , C + i*ldc + j, ldc);
+		}
+	}, numThreads);
+}
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+// Symmetric rank-k update and triangular solve. Both are split into blocks of
+// gcMC rows, so that all the work outside the diagonal blocks is done by the
+// product kernels.
+
+// Row and column strides of op(A) for a matrix A with leading dimension lda.
+static inline void OpStrides(GemmOp op, size_t lda, size_t& rs, size_t& cs)
+{
+	rs = (op == GemmOp::None) ? lda : 1;
+	cs = (op == GemmOp::None) ? 1   : lda;
+}
+
+// Compute the block row [i0, i1) of the triangle uplo of C = alpha*P*P^T + beta*C,
+// where the element (i, p) of P is P[i*rs + p*cs].
+static void SyrkBlockRow(GemmTriangle uplo, size_t n, size_t k, size_t i0, size_t i1,
+                         double alpha, const double* P, size_t rs, size_t cs,
+                         double beta, double* C, size_t ldc)
+{
+	const size_t _mb = i1 - i0;
+	
+	// The block outside the diagonal is a plain product with P^T, whose
+	// strides are those of P exchanged.
+	if(uplo == GemmTriangle::Lower)
+	{
+		GemmStrided(_mb, i0, k, alpha, P + i0*rs, rs, cs, P, cs, rs, beta, C + i0*ldc, ldc);
+	}
+	else
+	{
+		GemmStrided(_mb, n-i1, k, alpha, P + i0*rs, rs, cs, P + i1*rs, cs, rs, beta, C + i0*ldc + i1, ldc);
+	}
+	
+	// The diagonal block is computed in full into a buffer, only its triangle
+	// is stored into C.
+	static thread_local std::vector<double> _buffer;
+	if(_buffer.size() < _mb*_mb) _buffer.resize(_mb*_mb);
+	double* _D = _buffer.data();
+	GemmStrided(_mb, _mb, k, alpha, P + i0*rs, rs, cs, P + i0*rs, cs, rs, 0.0, _D, _mb);
+	for(size_t i=0 ; i<_mb ; ++i)
+	{
+		const size_t _j1 = (uplo == GemmTriangle::Lower) ? 0     : i;
+		const size_t _j2 = (uplo == GemmTriangle::Lower) ? i + 1 : _mb;
+		double*      _c  = C + (i0+i)*ldc + i0;
+		for(size_t j=_j1 ; j<_j2 ; ++j)
+		{
+			_c[j] = (beta == 0.0) ? _D[i*_mb+j] : _D[i*_mb+j] + beta*_c[j];
+		}
+	}
+}
+
+// Solve the diagonal block [k0, k1) of op(T)*X = B by substitution, the element
+// (i, j) of op(T) is T[i*rs + j*cs]. The columns of B are independent and are
+// solved in parallel.
+static void TrsmDiagonalBlock(bool lower, bool unitDiagonal, size_t k0, size_t k1, size_t nrhs,
+                              const double* T, size_t rs, size_t cs, double* B, size_t ldb,
+                              unsigned int numThreads)
+{
+	const size_t _kb    = k1 - k0;
+	const size_t _grain = std::max<size_t>(1, gcSmallGemm / (_kb*_kb));
+	glParallelFor(0, nrhs, _grain, [&](size_t c1, size_t c2)
+	{
+		for(size_t s=0 ; s<_kb ; ++s)
+		{
+			const size_t _i = lower ? k0 + s : k1 - 1 - s;
+			double*      _x = B + _i*ldb;
+			
+			// Rows of the block which are already solved.
+			const size_t _j1 = lower ? k0 : _i + 1;
+			const size_t _j2 = lower ? _i : k1;
+			for(size_t j=_j1 ; j<_j2 ; ++j)
+			{
+				const double  _t  = T[_i*rs + j*cs];
+				const double* _xj = B + j*ldb;
+				for(size_t c=c1 ; c<c2 ; ++c)
+				{
+					_x[c] -= _t * _xj[c];
+				}
+			}
+			if(!unitDiagonal)
+			{
+				const double _inv = 1.0 / T[_i*rs + _i*cs];
+				for(size_t c=c1 ; c<c2 ; ++c)
+				{
+					_x[c] *= _inv;
+				}
+			}
+		}
+	}, numThreads);
+}
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+void glGemm(size_t m, size_t n, size_t k,
+            double alpha, const double* A, size_t lda,
+                          const double* B, size_t ldb,
+            double beta ,       double* C, size_t ldc,
+            unsigned int numThreads)
+{
+	GemmParallel(m, n, k, alpha, A, lda, 1, B, ldb, 1, beta, C, ldc, numThreads);
+}
+
+void glGemmStrided(size_t m, size_t n, size_t k,
+                   double alpha, const double* A, size_t rsa, size_t csa,
+                                 const double* B, size_t rsb, size_t csb,
+                   double beta ,       double* C, size_t ldc,
+                   unsigned int numThreads)
+{
+	GemmParallel(m, n, k, alpha, A, rsa, csa, B, rsb, csb, beta, C, ldc, numThreads);
+}
+
+void glGemm(GemmOp opA, GemmOp opB, size_t m, size_t n, size_t k,
+            double alpha, const double* A, size_t lda,
+                          const double* B, size_t ldb,
+            double beta ,       double* C, size_t ldc,
+            unsigned int numThreads)
+{
+	size_t _rsa, _csa, _rsb, _csb;
+	OpStrides(opA, lda, _rsa, _csa);
+	OpStrides(opB, ldb, _rsb, _csb);
+	GemmParallel(m, n, k, alpha, A, _rsa, _csa, B, _rsb, _csb, beta, C, ldc, numThreads);
+}
+
+void glSyrk(GemmTriangle uplo, GemmOp opA, size_t n, size_t k,
+            double alpha, const double* A, size_t lda,
+            double beta ,       double* C, size_t ldc,
+            unsigned int numThreads)
+{
+	if(n == 0)
+	{
+		return;
+	}
+	size_t _rs, _cs;
+	OpStrides(opA, lda, _rs, _cs);
+	
+	// The block rows of the lower triangle grow with their index and those of
+	// the upper triangle shrink, so the first and the last block rows are
+	// paired to give every task about the same amount of work.
+	const size_t _numBlocks = (n + gcMC - 1) / gcMC;
+	const size_t _numPairs  = (_numBlocks + 1) / 2;
+	const size_t _pairWork  = std::max<size_t>(1, gcMC * n * std::max<size_t>(k, 1));
+	glParallelFor(0, _numPairs, std::max<size_t>(1, gcParallelGemm / _pairWork), [&](size_t p1, size_t p2)
+	{
+		for(size_t p=p1 ; p<p2 ; ++p)
+		{
+			const size_t _blocks[2] = {p, _numBlocks - 1 - p};
+			for(size_t b=0 ; b<(_blocks[0] == _blocks[1] ? 1u : 2u) ; ++b)
+			{
+				const size_t _i0 = _blocks[b] * gcMC;
+				SyrkBlockRow(uplo, n, k, _i0, std::min(n, _i0 + gcMC), alpha, A, _rs, _cs, beta, C, ldc);
+			}
+		}
+	}, numThreads);
+}
+
+void glTrsm(GemmTriangle uplo, GemmOp opT, bool unitDiagonal, size_t n, size_t nrhs,
+            double alpha, const double* T, size_t ldt,
+                                double* B, size_t ldb,
+            unsigned int numThreads)
+{
+	if(n == 0 || nrhs == 0)
+	{
+		return;
+	}
+	if(alpha != 1.0)
+	{
+		ScaleC(n, nrhs, alpha, B, ldb);
+		if(alpha == 0.0)
+		{
+			return;
+		}
+	}
+	
+	// op(T) is lower triangular if T is lower and not transposed or upper and
+	// transposed. Lower systems are solved from the top block down, upper ones
+	// from the bottom block up; after a block is solved it is eliminated from
+	// the remaining rows of B with one product.
+	size_t _rs, _cs;
+	OpStrides(opT, ldt, _rs, _cs);
+	const bool   _lower     = (uplo == GemmTriangle::Lower) == (opT == GemmOp::None);
+	const size_t _numBlocks = (n + gcMC - 1) / gcMC;
+	for(size_t b=0 ; b<_numBlocks ; ++b)
+	{
+		const size_t _k0 = _lower ? b*gcMC : (_numBlocks - 1 - b)*gcMC;
+		const size_t _k1 = std::min(n, _k0 + gcMC);
+		TrsmDiagonalBlock(_lower, unitDiagonal, _k0, _k1, nrhs, T, _rs, _cs, B, ldb, numThreads);
+		if(_lower && _k1 < n)
+		{
+			GemmParallel(n - _k1, nrhs, _k1 - _k0, -1.0, T + _k1*_rs + _k0*_cs, _rs, _cs,
+			             B + _k0*ldb, ldb, 1, 1.0, B + _k1*ldb, ldb, numThreads);
+		}
+		else if(!_lower && _k0 > 0)
+		{
+			GemmParallel(_k0, nrhs, _k1 - _k0, -1.0, T + _k0*_cs, _rs, _cs,
+			             B + _k0*ldb, ldb, 1, 1.0, B, ldb, numThreads);
+		}
+	}
+}
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+
+};	// End namespace SMathLib.
@@ -0,0 +1,103 @@
+// 
+// This file is part of SLogLib; you can redistribute it and/or 
+// modify it under the terms of the MIT License.
+// Author: Saurabh Garg (saurabhgarg@mysoc.net)
+// 
+
+#ifndef _SMATHLIB_GEMM_H_
+#define _SMATHLIB_GEMM_H_
+
+#include "SMathLib/Config.h"
+#include <cstddef>
+
+namespace SMathLib {
+;
+
+//! Operation applied to an operand before it is used, op(A) = A or A^T. The
+//! transpose is read in place, without copying the operand.
+enum class GemmOp
+{
+	None,
+	Transpose
+};
+
+//! Triangle of a matrix which is computed or read.
+enum class GemmTriangle
+{
+	Lower,
+	Upper
+};
+
+//! General matrix-matrix multiplication, C = alpha*A*B + beta*C.
+//! All the matrices are stored in row-major order.
+//! \param m Number of rows of A and C.
+//! \param n Number of columns of B and C.
+//! \param k Number of columns of A and rows of B.
+//! \param alpha Scalar multiplied with the product A*B.
+//! \param A Pointer to the first element of the m x k matrix A.
+//! \param lda Distance between two consecutive rows of A.
+//! \param B Pointer to the first element of the k x n matrix B.
+//! \param ldb Distance between two consecutive rows of B.
+//! \param beta Scalar multiplied with C, if beta is 0 then C is not read.
+//! \param C Pointer to the first element of the m x n matrix C.
+//! \param ldc Distance between two consecutive rows of C.
+//! \param numThreads Number of threads to use, 0 means use glGetNumThreads().
+//! The product is computed by a packed, cache-blocked kernel which uses
+//! AVX2/FMA instructions when the CPU supports them. Large products are split
+//! into tiles of C which are computed in parallel.
+SMATHLIB_DLL_API void glGemm(size_t m, size_t n, size_t k,
+                             double alpha, const double* A, size_t lda,
+                                           const double* B, size_t ldb,
+                             double beta ,       double* C, size_t ldc,
+                             unsigned int numThreads = 0);
+
+//! General matrix-matrix multiplication, C = alpha*A*B + beta*C, where A and B
+//! have arbitrary row and column strides, e.g. transposed or strided views.
+//! The element (i, j) of A is A[i*rsa + j*csa] and similarly for B. C is
+//! stored in row-major order. The other parameters are the same as glGemm().
+SMATHLIB_DLL_API void glGemmStrided(size_t m, size_t n, size_t k,
+                                    double alpha, const double* A, size_t rsa, size_t csa,
+                                                  const double* B, size_t rsb, size_t csb,
+                                    double beta ,       double* C, size_t ldc,
+                                    unsigned int numThreads = 0);
+
+//! General matrix-matrix multiplication with transposed operands,
+//! C = alpha*op(A)*op(B) + beta*C, like the BLAS dgemm. op(A) is m x k, so A
+//! is stored as a m x k matrix for GemmOp::None and as a k x m matrix for
+//! GemmOp::Transpose; similarly for B. A^T*B and A*B^T cost the same as A*B.
+//! The other parameters are the same as glGemm().
+SMATHLIB_DLL_API void glGemm(GemmOp opA, GemmOp opB, size_t m, size_t n, size_t k,
+                             double alpha, const double* A, size_t lda,
+                                           const double* B, size_t ldb,
+                             double beta ,       double* C, size_t ldc,
+                             unsigned int numThreads = 0);
+
+//! Symmetric rank-k update, C = alpha*op(A)*op(A)^T + beta*C, like the BLAS
+//! dsyrk. op(A) is n x k: GemmOp::None computes A*A^T of a n x k matrix A and
+//! GemmOp::Transpose computes A^T*A of a k x n matrix A, e.g. the matrix of the
+//! normal equations. Only the given triangle of the n x n matrix C, including
+//! the diagonal, is computed and read; the other triangle is not touched. This
+//! takes about half the work of the full product. The other parameters are
+//! the same as glGemm().
+SMATHLIB_DLL_API void glSyrk(GemmTriangle uplo, GemmOp opA, size_t n, size_t k,
+                             double alpha, const double* A, size_t lda,
+                             double beta ,       double* C, size_t ldc,
+                             unsigned int numThreads = 0);
+
+//! Triangular solve with multiple right-hand sides, op(T)*X = alpha*B, like
+//! the BLAS dtrsm for the left side. T is a n x n triangular matrix of which
+//! only the given triangle is read; GemmOp::Transpose solves with T^T without
+//! copying it. B is a n x nrhs matrix which is overwritten by X. If
+//! unitDiagonal is true the diagonal of T is taken as 1 and not read. For
+//! X*op(T) = alpha*B solve op(T)^T*X^T = alpha*B^T instead. Diagonal blocks are
+//! solved by substitution and the rest of B is updated with glGemm(), so
+//! forward and back substitution run at the speed of the product. A zero on
+//! the diagonal gives infinite or NaN solutions.
+SMATHLIB_DLL_API void glTrsm(GemmTriangle uplo, GemmOp opT, bool unitDiagonal, size_t n, size_t nrhs,
+                             double alpha, const double* T, size_t ldt,
+                                                 double* B, size_t ldb,
+                             unsigned int numThreads = 0);
+
+};	// End namespace SMathLib.
+
+#endif // _SMATHLIB_GEMM_H_
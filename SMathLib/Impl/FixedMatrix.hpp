@@ -0,0 +1,708 @@
+// 
+// This file is part of SLogLib; you can redistribute it and/or 
+// modify it under the terms of the MIT License.
+// Author: Saurabh Garg (saurabhgarg@mysoc.net)
+// 
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+//! Call func(I), func(I+1), ..., func(N-1). The calls are expanded at compile
+//! time, so after inlining the loop is completely unrolled.
+template<unsigned int I, unsigned int N>
+struct FixedMatrixUnroll
+{
+	template<typename Func>
+	static inline void Run(const Func& func)
+	{
+		func(I);
+		FixedMatrixUnroll<I+1, N>::Run(func);
+	}
+};
+
+template<unsigned int N>
+struct FixedMatrixUnroll<N, N>
+{
+	template<typename Func>
+	static inline void Run(const Func&)
+	{
+	}
+};
+
+//! Call func(i) for i in [0, N).
+template<unsigned int N, typename Func>
+inline void glFixedMatrixUnroll(Func func)
+{
+	FixedMatrixUnroll<0, N>::Run(func);
+}
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+//! Determinant and inverse of a N x N row-major array. The sizes up to 4 use
+//! closed forms, larger sizes use Gaussian elimination with partial pivoting.
+//! The inverse of a singular matrix contains infinities, like Matrix::Inverse().
+template<typename ET, unsigned int N>
+struct FixedMatrixSquare
+{
+	static ET Determinant(const ET* a)
+	{
+		ET _lu[N*N];
+		memcpy(_lu, a, sizeof(ET)*N*N);
+		
+		ET _det = ET(1);
+		for(unsigned int k=0 ; k<N ; ++k)
+		{
+			unsigned int _p = k;
+			for(unsigned int i=k+1 ; i<N ; ++i)
+			{
+				if(std::abs(_lu[i*N+k]) > std::abs(_lu[_p*N+k]))
+				{
+					_p = i;
+				}
+			}
+			if(_lu[_p*N+k] == ET(0))
+			{
+				return ET(0);
+			}
+			if(_p != k)
+			{
+				for(unsigned int j=0 ; j<N ; ++j)
+				{
+					std::swap(_lu[k*N+j], _lu[_p*N+j]);
+				}
+				_det = -_det;
+			}
+			
+			_det *= _lu[k*N+k];
+			for(unsigned int i=k+1 ; i<N ; ++i)
+			{
+				const ET _l = _lu[i*N+k] / _lu[k*N+k];
+				for(unsigned int j=k+1 ; j<N ; ++j)
+				{
+					_lu[i*N+j] -= _l * _lu[k*N+j];
+				}
+			}
+		}
+		return _det;
+	}
+	
+	static void Inverse(const ET* a, ET* inv)
+	{
+		// Gauss-Jordan elimination on [a | I].
+		ET _a[N*N];
+		memcpy(_a, a, sizeof(ET)*N*N);
+		for(unsigned int i=0 ; i<N ; ++i)
+		{
+			for(unsigned int j=0 ; j<N ; ++j)
+			{
+				inv[i*N+j] = (i == j) ? ET(1) : ET(0);
+			}
+		}
+		
+		for(unsigned int k=0 ; k<N ; ++k)
+		{
+			unsigned int _p = k;
+			for(unsigned int i=k+1 ; i<N ; ++i)
+			{
+				if(std::abs(_a[i*N+k]) > std::abs(_a[_p*N+k]))
+				{
+					_p = i;
+				}
+			}
+			if(_p != k)
+			{
+				for(unsigned int j=0 ; j<N ; ++j)
+				{
+					std::swap(_a[k*N+j], _a[_p*N+j]);
+					std::swap(inv[k*N+j], inv[_p*N+j]);
+				}
+			}
+			
+			const ET _invPivot = ET(1) / _a[k*N+k];
+			for(unsigned int j=0 ; j<N ; ++j)
+			{
+				_a[k*N+j]  *= _invPivot;
+				inv[k*N+j] *= _invPivot;
+			}
+			for(unsigned int i=0 ; i<N ; ++i)
+			{
+				if(i != k)
+				{
+					const ET _l = _a[i*N+k];
+					for(unsigned int j=0 ; j<N ; ++j)
+					{
+						_a[i*N+j]  -= _l * _a[k*N+j];
+						inv[i*N+j] -= _l * inv[k*N+j];
+					}
+				}
+			}
+		}
+	}
+};
+
+template<typename ET>
+struct FixedMatrixSquare<ET, 1>
+{
+	static ET Determinant(const ET* a)
+	{
+		return a[0];
+	}
+	
+	static void Inverse(const ET* a, ET* inv)
+	{
+		inv[0] = ET(1) / a[0];
+	}
+};
+
+template<typename ET>
+struct FixedMatrixSquare<ET, 2>
+{
+	static ET Determinant(const ET* a)
+	{
+		return a[0]*a[3] - a[1]*a[2];
+	}
+	
+	static void Inverse(const ET* a, ET* inv)
+	{
+		const ET _invDet = ET(1) / Determinant(a);
+		inv[0] =  a[3] * _invDet;
+		inv[1] = -a[1] * _invDet;
+		inv[2] = -a[2] * _invDet;
+		inv[3] =  a[0] * _invDet;
+	}
+};
+
+template<typename ET>
+struct FixedMatrixSquare<ET, 3>
+{
+	static ET Determinant(const ET* a)
+	{
+		return a[0] * (a[4]*a[8] - a[5]*a[7]) -
+		       a[1] * (a[3]*a[8] - a[5]*a[6]) +
+		       a[2] * (a[3]*a[7] - a[4]*a[6]);
+	}
+	
+	static void Inverse(const ET* a, ET* inv)
+	{
+		// Cofactors of the first row give the determinant.
+		const ET _c00 = a[4]*a[8] - a[5]*a[7];
+		const ET _c01 = a[5]*a[6] - a[3]*a[8];
+		const ET _c02 = a[3]*a[7] - a[4]*a[6];
+		const ET _invDet = ET(1) / (a[0]*_c00 + a[1]*_c01 + a[2]*_c02);
+		
+		inv[0] = _c00 * _invDet;
+		inv[1] = (a[2]*a[7] - a[1]*a[8]) * _invDet;
+		inv[2] = (a[1]*a[5] - a[2]*a[4]) * _invDet;
+		inv[3] = _c01 * _invDet;
+		inv[4] = (a[0]*a[8] - a[2]*a[6]) * _invDet;
+		inv[5] = (a[2]*a[3] - a[0]*a[5]) * _invDet;
+		inv[6] = _c02 * _invDet;
+		inv[7] = (a[1]*a[6] - a[0]*a[7]) * _invDet;
+		inv[8] = (a[0]*a[4] - a[1]*a[3]) * _invDet;
+	}
+};
+
+template<typename ET>
+struct FixedMatrixSquare<ET, 4>
+{
+	// Determinants of the 2x2 sub-matrices of the top two rows (s) and the
+	// bottom two rows (c), the determinant and the inverse are expressed with
+	// these.
+	static void SubDeterminants(const ET* a, ET s[6], ET c[6])
+	{
+		s[0] = a[0]*a[5]  - a[4]*a[1];
+		s[1] = a[0]*a[6]  - a[4]*a[2];
+		s[2] = a[0]*a[7]  - a[4]*a[3];
+		s[3] = a[1]*a[6]  - a[5]*a[2];
+		s[4] = a[1]*a[7]  - a[5]*a[3];
+		s[5] = a[2]*a[7]  - a[6]*a[3];
+		c[0] = a[8]*a[13] - a[12]*a[9];
+		c[1] = a[8]*a[14] - a[12]*a[10];
+		c[2] = a[8]*a[15] - a[12]*a[11];
+		c[3] = a[9]*a[14] - a[13]*a[10];
+		c[4] = a[9]*a[15] - a[13]*a[11];
+		c[5] = a[10]*a[15] - a[14]*a[11];
+	}
+	
+	static ET Determinant(const ET* a)
+	{
+		ET s[6], c[6];
+		SubDeterminants(a, s, c);
+		return s[0]*c[5] - s[1]*c[4] + s[2]*c[3] + s[3]*c[2] - s[4]*c[1] + s[5]*c[0];
+	}
+	
+	static void Inverse(const ET* a, ET* inv)
+	{
+		ET s[6], c[6];
+		SubDeterminants(a, s, c);
+		const ET _invDet = ET(1) / (s[0]*c[5] - s[1]*c[4] + s[2]*c[3] + s[3]*c[2] - s[4]*c[1] + s[5]*c[0]);
+		
+		inv[0]  = ( a[5]*c[5]  - a[6]*c[4]  + a[7]*c[3])  * _invDet;
+		inv[1]  = (-a[1]*c[5]  + a[2]*c[4]  - a[3]*c[3])  * _invDet;
+		inv[2]  = ( a[13]*s[5] - a[14]*s[4] + a[15]*s[3]) * _invDet;
+		inv[3]  = (-a[9]*s[5]  + a[10]*s[4] - a[11]*s[3]) * _invDet;
+		inv[4]  = (-a[4]*c[5]  + a[6]*c[2]  - a[7]*c[1])  * _invDet;
+		inv[5]  = ( a[0]*c[5]  - a[2]*c[2]  + a[3]*c[1])  * _invDet;
+		inv[6]  = (-a[12]*s[5] + a[14]*s[2] - a[15]*s[1]) * _invDet;
+		inv[7]  = ( a[8]*s[5]  - a[10]*s[2] + a[11]*s[1]) * _invDet;
+		inv[8]  = ( a[4]*c[4]  - a[5]*c[2]  + a[7]*c[0])  * _invDet;
+		inv[9]  = (-a[0]*c[4]  + a[1]*c[2]  - a[3]*c[0])  * _invDet;
+		inv[10] = ( a[12]*s[4] - a[13]*s[2] + a[15]*s[0]) * _invDet;
+		inv[11] = (-a[8]*s[4]  + a[9]*s[2]  - a[11]*s[0]) * _invDet;
+		inv[12] = (-a[4]*c[3]  + a[5]*c[1]  - a[6]*c[0])  * _invDet;
+		inv[13] = ( a[0]*c[3]  - a[1]*c[1]  + a[2]*c[0])  * _invDet;
+		inv[14] = (-a[12]*s[3] + a[13]*s[1] - a[14]*s[0]) * _invDet;
+		inv[15] = ( a[8]*s[3]  - a[9]*s[1]  + a[10]*s[0]) * _invDet;
+	}
+};
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+//! Default constructor.
+//! Initializes each element of matrix with 0.
+template<typename ET, unsigned int R, unsigned int C, typename CP>
+FixedMatrix<ET, R, C, CP>::FixedMatrix()
+{
+	glFixedMatrixUnroll<R*C>([&](unsigned int i) { mMatrixData[i] = ET(0); });
+}
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+//! Initialize each element of matrix with a value.
+//! \param s The value of the elements.
+template<typename ET, unsigned int R, unsigned int C, typename CP>
+FixedMatrix<ET, R, C, CP>::FixedMatrix(const ValueType& s)
+{
+	glFixedMatrixUnroll<R*C>([&](unsigned int i) { mMatrixData[i] = s; });
+}
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+//! Initialize matrix with a given array of values.
+//! \param data The array of R*C values in row-major order.
+template<typename ET, unsigned int R, unsigned int C, typename CP>
+FixedMatrix<ET, R, C, CP>::FixedMatrix(const ValueType* const data)
+{
+	if(data != 0)
+	{
+		memcpy(mMatrixData, data, sizeof(ValueType) * R * C);
+	}
+}
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+//! Initialize matrix with the elements of a dynamic matrix or a view.
+//! \param B The matrix to copy, it must be R x C.
+template<typename ET, unsigned int R, unsigned int C, typename CP>
+FixedMatrix<ET, R, C, CP>::FixedMatrix(const ConstMatrixView& B)
+{
+	assert(B.Rows() == R && B.Cols() == C);
+	for(unsigned int i=0 ; i<R ; ++i)
+	{
+		for(unsigned int j=0 ; j<C ; ++j)
+		{
+			mMatrixData[i*C+j] = ValueType(B(i, j));
+		}
+	}
+}
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+//! Copy constructor.
+//! \param B The matrix from which to create a copy.
+template<typename ET, unsigned int R, unsigned int C, typename CP>
+FixedMatrix<ET, R, C, CP>::FixedMatrix(const FixedMatrix<ET, R, C, CP>& B)
+{
+	memcpy(mMatrixData, B.mMatrixData, sizeof(ValueType) * R * C);
+}
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+//! Assignment operator.
+//! \param B The matrix from which to create a copy.
+//! \return The reference to this matrix.
+template<typename ET, unsigned int R, unsigned int C, typename CP>
+FixedMatrix<ET, R, C, CP>&
+FixedMatrix<ET, R, C, CP>::operator = (const FixedMatrix<ET, R, C, CP>& B)
+{
+	if(&B != this)
+	{
+		memcpy(mMatrixData, B.mMatrixData, sizeof(ValueType) * R * C);
+	}
+	return *this;
+}
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+//! Create an identity matrix.
+template<typename ET, unsigned int R, unsigned int C, typename CP>
+FixedMatrix<ET, R, C, CP> FixedMatrix<ET, R, C, CP>::Identity()
+{
+	FixedMatrix<ET, R, C, CP> _I;
+	glFixedMatrixUnroll<(R < C ? R : C)>([&](unsigned int i) { _I.mMatrixData[i*C+i] = ET(1); });
+	return _I;
+}
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+template<typename ET, unsigned int R, unsigned int C, typename CP>
+ET& FixedMatrix<ET, R, C, CP>::operator () (unsigned int r, unsigned int c)
+{
+	CP::Check(r, 0, R-1, "FixedMatrix: Row index out of bounds.");
+	CP::Check(c, 0, C-1, "FixedMatrix: Column index out of bounds.");
+	return mMatrixData[r*C+c];
+}
+
+template<typename ET, unsigned int R, unsigned int C, typename CP>
+const ET& FixedMatrix<ET, R, C, CP>::operator () (unsigned int r, unsigned int c) const
+{
+	CP::Check(r, 0, R-1, "FixedMatrix: Row index out of bounds.");
+	CP::Check(c, 0, C-1, "FixedMatrix: Column index out of bounds.");
+	return mMatrixData[r*C+c];
+}
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+//! Access the elements in row-major order.
+template<typename ET, unsigned int R, unsigned int C, typename CP>
+ET& FixedMatrix<ET, R, C, CP>::operator [] (unsigned int index)
+{
+	CP::Check(index, 0, R*C-1, "FixedMatrix: Index out of bounds.");
+	return mMatrixData[index];
+}
+
+template<typename ET, unsigned int R, unsigned int C, typename CP>
+const ET& FixedMatrix<ET, R, C, CP>::operator [] (unsigned int index) const
+{
+	CP::Check(index, 0, R*C-1, "FixedMatrix: Index out of bounds.");
+	return mMatrixData[index];
+}
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+//! Get a row of the matrix as a vector.
+template<typename ET, unsigned int R, unsigned int C, typename CP>
+VectorOnStack<ET, C, CP> FixedMatrix<ET, R, C, CP>::Row(unsigned int r) const
+{
+	CP::Check(r, 0, R-1, "FixedMatrix: Row index out of bounds.");
+	return RowType(mMatrixData + r*C);
+}
+
+//! Get a column of the matrix as a vector.
+template<typename ET, unsigned int R, unsigned int C, typename CP>
+VectorOnStack<ET, R, CP> FixedMatrix<ET, R, C, CP>::Col(unsigned int c) const
+{
+	CP::Check(c, 0, C-1, "FixedMatrix: Column index out of bounds.");
+	ColType _v;
+	glFixedMatrixUnroll<R>([&](unsigned int i) { _v[i] = mMatrixData[i*C+c]; });
+	return _v;
+}
+
+//! Set a row of the matrix from a vector.
+template<typename ET, unsigned int R, unsigned int C, typename CP>
+void FixedMatrix<ET, R, C, CP>::SetRow(unsigned int r, const RowType& v)
+{
+	CP::Check(r, 0, R-1, "FixedMatrix: Row index out of bounds.");
+	glFixedMatrixUnroll<C>([&](unsigned int j) { mMatrixData[r*C+j] = v[j]; });
+}
+
+//! Set a column of the matrix from a vector.
+template<typename ET, unsigned int R, unsigned int C, typename CP>
+void FixedMatrix<ET, R, C, CP>::SetCol(unsigned int c, const ColType& v)
+{
+	CP::Check(c, 0, C-1, "FixedMatrix: Column index out of bounds.");
+	glFixedMatrixUnroll<R>([&](unsigned int i) { mMatrixData[i*C+c] = v[i]; });
+}
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+//! Check if two matrices are equal, A == B.
+//! \param B Matrix on the R.H.S. of the == sign.
+//! \return True if all the elements of two matrices are equal, false otherwise.
+template<typename ET, unsigned int R, unsigned int C, typename CP>
+bool FixedMatrix<ET, R, C, CP>::operator == (const FixedMatrix<ET, R, C, CP>& B) const
+{
+	for(unsigned int i=0 ; i<R*C ; i++)
+	{
+		if(mMatrixData[i] != B.mMatrixData[i])
+		{
+			return false;
+		}
+	}
+	
+	return true;
+}
+
+//! Check if two matrices are unequal, A != B.
+//! \param B Matrix on the R.H.S. of the != sign.
+//! \return True if any element of two matrices is unequal, false otherwise.
+template<typename ET, unsigned int R, unsigned int C, typename CP>
+bool FixedMatrix<ET, R, C, CP>::operator != (const FixedMatrix<ET, R, C, CP>& B) const
+{
+	return !(*this == B);
+}
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+//! Add two matrices, C = A + B.
+template<typename ET, unsigned int R, unsigned int C, typename CP>
+FixedMatrix<ET, R, C, CP>
+FixedMatrix<ET, R, C, CP>::operator + (const FixedMatrix<ET, R, C, CP>& B) const
+{
+	FixedMatrix<ET, R, C, CP> _C;
+	glFixedMatrixUnroll<R*C>([&](unsigned int i) { _C.mMatrixData[i] = mMatrixData[i] + B.mMatrixData[i]; });
+	return _C;
+}
+
+//! Subtract two matrices, C = A - B.
+template<typename ET, unsigned int R, unsigned int C, typename CP>
+FixedMatrix<ET, R, C, CP>
+FixedMatrix<ET, R, C, CP>::operator - (const FixedMatrix<ET, R, C, CP>& B) const
+{
+	FixedMatrix<ET, R, C, CP> _C;
+	glFixedMatrixUnroll<R*C>([&](unsigned int i) { _C.mMatrixData[i] = mMatrixData[i] - B.mMatrixData[i]; });
+	return _C;
+}
+
+//! Add a matrix to this matrix, A += B.
+template<typename ET, unsigned int R, unsigned int C, typename CP>
+FixedMatrix<ET, R, C, CP>&
+FixedMatrix<ET, R, C, CP>::operator += (const FixedMatrix<ET, R, C, CP>& B)
+{
+	glFixedMatrixUnroll<R*C>([&](unsigned int i) { mMatrixData[i] += B.mMatrixData[i]; });
+	return *this;
+}
+
+//! Subtract a matrix from this matrix, A -= B.
+template<typename ET, unsigned int R, unsigned int C, typename CP>
+FixedMatrix<ET, R, C, CP>&
+FixedMatrix<ET, R, C, CP>::operator -= (const FixedMatrix<ET, R, C, CP>& B)
+{
+	glFixedMatrixUnroll<R*C>([&](unsigned int i) { mMatrixData[i] -= B.mMatrixData[i]; });
+	return *this;
+}
+
+//! Negate a matrix, B = -A.
+template<typename ET, unsigned int R, unsigned int C, typename CP>
+FixedMatrix<ET, R, C, CP>
+FixedMatrix<ET, R, C, CP>::operator - () const
+{
+	FixedMatrix<ET, R, C, CP> _C;
+	glFixedMatrixUnroll<R*C>([&](unsigned int i) { _C.mMatrixData[i] = -mMatrixData[i]; });
+	return _C;
+}
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+//! Multiply two matrices, D = A * B.
+//! \param B A C x C2 matrix.
+//! \return The R x C2 product.
+template<typename ET, unsigned int R, unsigned int C, typename CP>
+template<unsigned int C2>
+FixedMatrix<ET, R, C2, CP>
+FixedMatrix<ET, R, C, CP>::operator * (const FixedMatrix<ET, C, C2, CP>& B) const
+{
+	FixedMatrix<ET, R, C2, CP> _D;
+	ET*       _d = _D.Data();
+	const ET* _b = B.ConstData();
+	glFixedMatrixUnroll<R>([&](unsigned int i)
+	{
+		glFixedMatrixUnroll<C2>([&](unsigned int j)
+		{
+			ET _s = mMatrixData[i*C] * _b[j];
+			FixedMatrixUnroll<1, C>::Run([&](unsigned int k) { _s += mMatrixData[i*C+k] * _b[k*C2+j]; });
+			_d[i*C2+j] = _s;
+		});
+	});
+	return _D;
+}
+
+//! Multiply this matrix with a square matrix, A = A * B.
+template<typename ET, unsigned int R, unsigned int C, typename CP>
+FixedMatrix<ET, R, C, CP>&
+FixedMatrix<ET, R, C, CP>::operator *= (const FixedMatrix<ET, C, C, CP>& B)
+{
+	*this = *this * B;
+	return *this;
+}
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+//! Multiply a matrix with a column vector, u = A * v.
+template<typename ET, unsigned int R, unsigned int C, typename CP>
+template<typename CP1>
+VectorOnStack<ET, R, CP>
+FixedMatrix<ET, R, C, CP>::operator * (const VectorOnStack<ET, C, CP1>& v) const
+{
+	ColType _u;
+	glFixedMatrixUnroll<R>([&](unsigned int i)
+	{
+		ET _s = mMatrixData[i*C] * v[0];
+		FixedMatrixUnroll<1, C>::Run([&](unsigned int k) { _s += mMatrixData[i*C+k] * v[k]; });
+		_u[i] = _s;
+	});
+	return _u;
+}
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+//! Multiply a matrix with a scalar, B = A * s.
+template<typename ET, unsigned int R, unsigned int C, typename CP>
+template<typename ST>
+FixedMatrix<ET, R, C, CP> FixedMatrix<ET, R, C, CP>::operator * (const ST& s) const
+{
+	FixedMatrix<ET, R, C, CP> _C;
+	glFixedMatrixUnroll<R*C>([&](unsigned int i) { _C.mMatrixData[i] = mMatrixData[i] * s; });
+	return _C;
+}
+
+//! Divide a matrix with a scalar, B = A / s.
+template<typename ET, unsigned int R, unsigned int C, typename CP>
+template<typename ST>
+FixedMatrix<ET, R, C, CP> FixedMatrix<ET, R, C, CP>::operator / (const ST& s) const
+{
+	FixedMatrix<ET, R, C, CP> _C;
+	glFixedMatrixUnroll<R*C>([&](unsigned int i) { _C.mMatrixData[i] = mMatrixData[i] / s; });
+	return _C;
+}
+
+//! Multiply this matrix with a scalar, A *= s.
+template<typename ET, unsigned int R, unsigned int C, typename CP>
+template<typename ST>
+FixedMatrix<ET, R, C, CP>& FixedMatrix<ET, R, C, CP>::operator *= (const ST& s)
+{
+	glFixedMatrixUnroll<R*C>([&](unsigned int i) { mMatrixData[i] *= s; });
+	return *this;
+}
+
+//! Divide this matrix with a scalar, A /= s.
+template<typename ET, unsigned int R, unsigned int C, typename CP>
+template<typename ST>
+FixedMatrix<ET, R, C, CP>& FixedMatrix<ET, R, C, CP>::operator /= (const ST& s)
+{
+	glFixedMatrixUnroll<R*C>([&](unsigned int i) { mMatrixData[i] /= s; });
+	return *this;
+}
+
+//! Multiply a scalar with a matrix, B = s * A.
+template<typename ST, typename ET, unsigned int R, unsigned int C, typename CP>
+FixedMatrix<ET, R, C, CP> operator * (const ST& s, const FixedMatrix<ET, R, C, CP>& A)
+{
+	return A * s;
+}
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+//! Transpose of the matrix.
+template<typename ET, unsigned int R, unsigned int C, typename CP>
+FixedMatrix<ET, C, R, CP> FixedMatrix<ET, R, C, CP>::Transpose() const
+{
+	FixedMatrix<ET, C, R, CP> _T;
+	ET* _t = _T.Data();
+	glFixedMatrixUnroll<R>([&](unsigned int i)
+	{
+		glFixedMatrixUnroll<C>([&](unsigned int j) { _t[j*R+i] = mMatrixData[i*C+j]; });
+	});
+	return _T;
+}
+
+//! Determinant of a square matrix.
+template<typename ET, unsigned int R, unsigned int C, typename CP>
+ET FixedMatrix<ET, R, C, CP>::Determinant() const
+{
+	SUTILS_STATIC_ASSERT(R==C, FixedMatrix_Determinant_Of_Non_Square_Matrix);
+	return FixedMatrixSquare<ET, R>::Determinant(mMatrixData);
+}
+
+//! Inverse of a square matrix.
+template<typename ET, unsigned int R, unsigned int C, typename CP>
+FixedMatrix<ET, R, C, CP> FixedMatrix<ET, R, C, CP>::Inverse() const
+{
+	SUTILS_STATIC_ASSERT(R==C, FixedMatrix_Inverse_Of_Non_Square_Matrix);
+	FixedMatrix<ET, R, C, CP> _inverse;
+	FixedMatrixSquare<ET, R>::Inverse(mMatrixData, _inverse.mMatrixData);
+	return _inverse;
+}
+
+//! Sum of the diagonal elements of a square matrix.
+template<typename ET, unsigned int R, unsigned int C, typename CP>
+ET FixedMatrix<ET, R, C, CP>::Trace() const
+{
+	SUTILS_STATIC_ASSERT(R==C, FixedMatrix_Trace_Of_Non_Square_Matrix);
+	ET _trace = ET(0);
+	glFixedMatrixUnroll<R>([&](unsigned int i) { _trace += mMatrixData[i*C+i]; });
+	return _trace;
+}
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+template<typename ET, unsigned int R, unsigned int C, typename CP>
+Matrix FixedMatrix<ET, R, C, CP>::ToMatrix() const
+{
+	Matrix _A(R, C, MatrixType::Null);
+	for(unsigned int i=0 ; i<R*C ; ++i)
+	{
+		_A.matrix[i] = double(mMatrixData[i]);
+	}
+	return _A;
+}
+
+template<typename ET, unsigned int R, unsigned int C, typename CP>
+ConstMatrixView FixedMatrix<ET, R, C, CP>::View() const
+{
+	return ConstMatrixView(mMatrixData, R, C, C, 1);
+}
+
+template<typename ET, unsigned int R, unsigned int C, typename CP>
+MatrixView FixedMatrix<ET, R, C, CP>::View()
+{
+	return MatrixView(mMatrixData, R, C, C, 1);
+}
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+//! Stream matrix to a output character stream, in the same format as Matrix.
+template<typename ET, unsigned int R, unsigned int C, typename CP>
+std::ostream& operator << (std::ostream& out, const FixedMatrix<ET, R, C, CP>& B)
+{
+	out << R << " " << C;
+	for(unsigned int i=0 ; i<R ; ++i)
+	{
+		out << std::endl;
+		for(unsigned int j=0 ; j<C ; ++j)
+		{
+			out << B(i, j) << " ";
+		}
+	}
+	return out;
+}
+
+//! Stream matrix from a input character stream, the R*C elements are read in
+//! row-major order.
+template<typename ET, unsigned int R, unsigned int C, typename CP>
+std::istream& operator >> (std::istream& in, FixedMatrix<ET, R, C, CP>& B)
+{
+	for(unsigned int i=0 ; i<R*C ; ++i)
+	{
+		in >> B[i];
+	}
+	return in;
+}
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
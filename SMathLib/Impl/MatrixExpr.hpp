@@ -0,0 +1,666 @@
+// 
+// This file is part of SLogLib; you can redistribute it and/or 
+// modify it under the terms of the MIT License.
+// Author: Saurabh Garg (saurabhgarg@mysoc.net)
+// 
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+//! Traits to treat matrices and expressions uniformly in the operators.
+//! Kind is eMatrixExpr_None for the types which are not matrix expressions.
+template<typename T, typename Enable = void>
+struct MatrixExprTraits
+{
+	enum {Kind = eMatrixExpr_None};
+};
+
+//! Check if T is a matrix or a view, which are the leaves of the expressions.
+template<typename T>
+struct MatrixExprIsLeaf
+{
+	static const bool value = std::is_same<T, Matrix>::value || std::is_same<T, ConstMatrixView>::value ||
+	                          std::is_same<T, MatrixView>::value;
+};
+
+template<typename T>
+struct MatrixExprTraits<T, typename std::enable_if<MatrixExprIsLeaf<T>::value>::type>
+{
+	enum {Kind = eMatrixExpr_Elementwise};
+	typedef MatrixRefExpr Type;
+	static inline Type Get(const ConstMatrixView& A) {return MatrixRefExpr(A);}
+};
+
+template<typename T>
+struct MatrixExprTraits<T, typename std::enable_if<std::is_base_of<MatrixExpr<T>, T>::value>::type>
+{
+	enum {Kind = T::Kind};
+	typedef T Type;
+	static inline const T& Get(const T& e) {return e;}
+};
+
+//! Check if T is an element-wise expression, a matrix or a view.
+template<typename T>
+struct MatrixExprIsElementwise
+{
+	static const bool value = int(MatrixExprTraits<T>::Kind) == int(eMatrixExpr_Elementwise);
+};
+
+//! Check if L and R are element-wise operands and at least one of them is an
+//! expression. Operations on two matrices are handled by Matrix itself.
+template<typename L, typename R>
+struct MatrixExprIsElementwisePair
+{
+	static const bool value = MatrixExprIsElementwise<L>::value && MatrixExprIsElementwise<R>::value &&
+	                          !(std::is_same<L, Matrix>::value && std::is_same<R, Matrix>::value);
+};
+
+//! Traits for operands of a product: a matrix optionally multiplied by a scalar.
+template<typename T, typename Enable = void>
+struct MatrixProductOperand
+{
+	static const bool value = false;
+};
+
+template<typename T>
+struct MatrixProductOperand<T, typename std::enable_if<MatrixExprIsLeaf<T>::value>::type>
+{
+	static const bool value = true;
+	static inline double          Scale(const ConstMatrixView&  ) {return 1.0;}
+	static inline ConstMatrixView Get  (const ConstMatrixView& A) {return A;}
+};
+
+template<>
+struct MatrixProductOperand<MatrixRefExpr>
+{
+	static const bool value = true;
+	static inline double                 Scale(const MatrixRefExpr&  ) {return 1.0;}
+	static inline const ConstMatrixView& Get  (const MatrixRefExpr& A) {return A.Get();}
+};
+
+template<>
+struct MatrixProductOperand<MatrixScaleExpr<MatrixRefExpr> >
+{
+	static const bool value = true;
+	static inline double                 Scale(const MatrixScaleExpr<MatrixRefExpr>& A) {return A.Scale();}
+	static inline const ConstMatrixView& Get  (const MatrixScaleExpr<MatrixRefExpr>& A) {return A.Expr().Get();}
+};
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+//! Element-wise sum, L + R.
+template<typename L, typename R>
+typename std::enable_if<MatrixExprIsElementwisePair<L, R>::value,
+                        MatrixSumExpr<typename MatrixExprTraits<L>::Type, typename MatrixExprTraits<R>::Type> >::type
+operator + (const L& l, const R& r)
+{
+	typedef MatrixSumExpr<typename MatrixExprTraits<L>::Type, typename MatrixExprTraits<R>::Type> ResultType;
+	return ResultType(MatrixExprTraits<L>::Get(l), MatrixExprTraits<R>::Get(r));
+}
+
+//! Element-wise difference, L - R.
+template<typename L, typename R>
+typename std::enable_if<MatrixExprIsElementwisePair<L, R>::value,
+                        MatrixDifferenceExpr<typename MatrixExprTraits<L>::Type, typename MatrixExprTraits<R>::Type> >::type
+operator - (const L& l, const R& r)
+{
+	typedef MatrixDifferenceExpr<typename MatrixExprTraits<L>::Type, typename MatrixExprTraits<R>::Type> ResultType;
+	return ResultType(MatrixExprTraits<L>::Get(l), MatrixExprTraits<R>::Get(r));
+}
+
+//! Overloads for a temporary matrix on the left, which would otherwise be
+//! ambiguous with the operators of Matrix for temporaries.
+template<typename R>
+typename std::enable_if<MatrixExprIsElementwisePair<Matrix, R>::value,
+                        MatrixSumExpr<MatrixRefExpr, typename MatrixExprTraits<R>::Type> >::type
+operator + (Matrix&& l, const R& r)
+{
+	return static_cast<const Matrix&>(l) + r;
+}
+template<typename R>
+typename std::enable_if<MatrixExprIsElementwisePair<Matrix, R>::value,
+                        MatrixDifferenceExpr<MatrixRefExpr, typename MatrixExprTraits<R>::Type> >::type
+operator - (Matrix&& l, const R& r)
+{
+	return static_cast<const Matrix&>(l) - r;
+}
+
+//! Multiply an expression or a matrix with a scalar, s * E.
+template<typename E>
+typename std::enable_if<MatrixExprIsElementwise<E>::value, MatrixScaleExpr<typename MatrixExprTraits<E>::Type> >::type
+operator * (double s, const E& e)
+{
+	return MatrixScaleExpr<typename MatrixExprTraits<E>::Type>(s, MatrixExprTraits<E>::Get(e));
+}
+
+//! Multiply a scaled expression with a scalar, s * (t * E) = (s*t) * E.
+template<typename E>
+MatrixScaleExpr<E> operator * (double s, const MatrixScaleExpr<E>& e)
+{
+	return MatrixScaleExpr<E>(s * e.Scale(), e.Expr());
+}
+
+//! Multiply an expression with a scalar, E * s.
+template<typename E>
+typename std::enable_if<MatrixExprIsElementwise<E>::value && !std::is_same<E, Matrix>::value,
+                        MatrixScaleExpr<typename MatrixExprTraits<E>::Type> >::type
+operator * (const E& e, double s)
+{
+	return s * e;
+}
+
+//! Divide an expression by a scalar, E / s.
+template<typename E>
+typename std::enable_if<MatrixExprIsElementwise<E>::value && !std::is_same<E, Matrix>::value,
+                        MatrixDivideExpr<typename MatrixExprTraits<E>::Type> >::type
+operator / (const E& e, double s)
+{
+	return MatrixDivideExpr<typename MatrixExprTraits<E>::Type>(MatrixExprTraits<E>::Get(e), s);
+}
+
+//! Negate an expression or a matrix, -E.
+template<typename E>
+typename std::enable_if<MatrixExprIsElementwise<E>::value, MatrixScaleExpr<typename MatrixExprTraits<E>::Type> >::type
+operator - (const E& e)
+{
+	return -1.0 * e;
+}
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+//! Product of two, optionally scaled, matrices, (s*A) * (t*B).
+template<typename L, typename R>
+typename std::enable_if<MatrixProductOperand<L>::value && MatrixProductOperand<R>::value &&
+                        !(std::is_same<L, Matrix>::value && std::is_same<R, Matrix>::value),
+                        MatrixProductExpr>::type
+operator * (const L& l, const R& r)
+{
+	return MatrixProductExpr(MatrixProductOperand<L>::Scale(l) * MatrixProductOperand<R>::Scale(r),
+	                         MatrixProductOperand<L>::Get(l), MatrixProductOperand<R>::Get(r));
+}
+
+//! Multiply a product with a scalar.
+inline MatrixProductExpr operator * (double s, const MatrixProductExpr& P)
+{
+	return MatrixProductExpr(s * P.Alpha(), P.A(), P.B());
+}
+inline MatrixProductExpr operator * (const MatrixProductExpr& P, double s)
+{
+	return MatrixProductExpr(s * P.Alpha(), P.A(), P.B());
+}
+inline MatrixProductExpr operator - (const MatrixProductExpr& P)
+{
+	return MatrixProductExpr(-P.Alpha(), P.A(), P.B());
+}
+
+//! Sum of a product and an element-wise expression, alpha*A*B + E.
+template<typename E>
+typename std::enable_if<MatrixExprIsElementwise<E>::value, MatrixGemmExpr<typename MatrixExprTraits<E>::Type> >::type
+operator + (const MatrixProductExpr& P, const E& e)
+{
+	return MatrixGemmExpr<typename MatrixExprTraits<E>::Type>(P, MatrixExprTraits<E>::Get(e));
+}
+template<typename E>
+typename std::enable_if<MatrixExprIsElementwise<E>::value, MatrixGemmExpr<typename MatrixExprTraits<E>::Type> >::type
+operator + (const E& e, const MatrixProductExpr& P)
+{
+	return MatrixGemmExpr<typename MatrixExprTraits<E>::Type>(P, MatrixExprTraits<E>::Get(e));
+}
+
+//! Difference of a product and an element-wise expression.
+template<typename E>
+typename std::enable_if<MatrixExprIsElementwise<E>::value, MatrixGemmExpr<MatrixScaleExpr<typename MatrixExprTraits<E>::Type> > >::type
+operator - (const MatrixProductExpr& P, const E& e)
+{
+	return MatrixGemmExpr<MatrixScaleExpr<typename MatrixExprTraits<E>::Type> >(P, -1.0 * e);
+}
+template<typename E>
+typename std::enable_if<MatrixExprIsElementwise<E>::value, MatrixGemmExpr<typename MatrixExprTraits<E>::Type> >::type
+operator - (const E& e, const MatrixProductExpr& P)
+{
+	return MatrixGemmExpr<typename MatrixExprTraits<E>::Type>(-P, MatrixExprTraits<E>::Get(e));
+}
+
+//! Sum and difference of two products, evaluated as two glGemm calls.
+inline MatrixGemmExpr<MatrixProductExpr> operator + (const MatrixProductExpr& P1, const MatrixProductExpr& P2)
+{
+	return MatrixGemmExpr<MatrixProductExpr>(P1, P2);
+}
+inline MatrixGemmExpr<MatrixProductExpr> operator - (const MatrixProductExpr& P1, const MatrixProductExpr& P2)
+{
+	return MatrixGemmExpr<MatrixProductExpr>(P1, -P2);
+}
+
+//! Multiply a sum of two products with a scalar, which scales both alphas;
+//! used by the negation in M -= alpha*A*B + beta*C*D.
+inline MatrixGemmExpr<MatrixProductExpr> operator * (double s, const MatrixGemmExpr<MatrixProductExpr>& G)
+{
+	return MatrixGemmExpr<MatrixProductExpr>(s * G.Product(), s * G.Addend());
+}
+inline MatrixGemmExpr<MatrixProductExpr> operator * (const MatrixGemmExpr<MatrixProductExpr>& G, double s)
+{
+	return s * G;
+}
+inline MatrixGemmExpr<MatrixProductExpr> operator - (const MatrixGemmExpr<MatrixProductExpr>& G)
+{
+	return -1.0 * G;
+}
+
+//! Add an element-wise expression to alpha*A*B + X.
+template<typename X, typename E>
+typename std::enable_if<MatrixExprIsElementwise<X>::value && MatrixExprIsElementwise<E>::value,
+                        MatrixGemmExpr<MatrixSumExpr<X, typename MatrixExprTraits<E>::Type> > >::type
+operator + (const MatrixGemmExpr<X>& G, const E& e)
+{
+	return G.Product() + (G.Addend() + e);
+}
+template<typename X, typename E>
+typename std::enable_if<MatrixExprIsElementwise<X>::value && MatrixExprIsElementwise<E>::value,
+                        MatrixGemmExpr<MatrixSumExpr<typename MatrixExprTraits<E>::Type, X> > >::type
+operator + (const E& e, const MatrixGemmExpr<X>& G)
+{
+	return G.Product() + (e + G.Addend());
+}
+template<typename X, typename E>
+typename std::enable_if<MatrixExprIsElementwise<X>::value && MatrixExprIsElementwise<E>::value,
+                        MatrixGemmExpr<MatrixDifferenceExpr<X, typename MatrixExprTraits<E>::Type> > >::type
+operator - (const MatrixGemmExpr<X>& G, const E& e)
+{
+	return G.Product() + (G.Addend() - e);
+}
+template<typename X, typename E>
+typename std::enable_if<MatrixExprIsElementwise<X>::value && MatrixExprIsElementwise<E>::value,
+                        MatrixGemmExpr<MatrixDifferenceExpr<typename MatrixExprTraits<E>::Type, X> > >::type
+operator - (const E& e, const MatrixGemmExpr<X>& G)
+{
+	return -G.Product() + (e - G.Addend());
+}
+
+//! Multiply alpha*A*B + X with a scalar.
+template<typename X>
+typename std::enable_if<MatrixExprIsElementwise<X>::value, MatrixGemmExpr<MatrixScaleExpr<X> > >::type
+operator * (double s, const MatrixGemmExpr<X>& G)
+{
+	return MatrixGemmExpr<MatrixScaleExpr<X> >(s * G.Product(), MatrixScaleExpr<X>(s, G.Addend()));
+}
+template<typename X>
+typename std::enable_if<MatrixExprIsElementwise<X>::value, MatrixGemmExpr<MatrixScaleExpr<X> > >::type
+operator * (const MatrixGemmExpr<X>& G, double s)
+{
+	return s * G;
+}
+template<typename X>
+typename std::enable_if<MatrixExprIsElementwise<X>::value, MatrixGemmExpr<MatrixScaleExpr<X> > >::type
+operator - (const MatrixGemmExpr<X>& G)
+{
+	return -1.0 * G;
+}
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+
+
+
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+//! Minimum number of elements evaluated by a thread.
+static const size_t gcMatrixExprGrain = 32768;
+
+//! Resize dst to r x c without initializing it, if it has a different size.
+inline void glMatrixExprResize(Matrix& dst, size_t r, size_t c)
+{
+	if(dst.matrix == nullptr || dst.rows != r || dst.cols != c)
+	{
+		dst = Matrix(r, c, MatrixType::Null);
+	}
+}
+
+//! Check if the elements of two views are stored in overlapping memory.
+inline bool glMatrixExprOverlaps(const ConstMatrixView& A, const ConstMatrixView& B)
+{
+	if(A.Rows() == 0 || A.Cols() == 0 || B.Rows() == 0 || B.Cols() == 0)
+	{
+		return false;
+	}
+	const double* _aEnd = &A(A.Rows()-1, A.Cols()-1) + 1;
+	const double* _bEnd = &B(B.Rows()-1, B.Cols()-1) + 1;
+	return A.Data() < _bEnd && B.Data() < _aEnd;
+}
+
+//! Check if two views refer to exactly the same elements.
+inline bool glMatrixExprSame(const ConstMatrixView& A, const ConstMatrixView& B)
+{
+	return A.Data() == B.Data() && A.Rows() == B.Rows() && A.Cols() == B.Cols() &&
+	       A.RowStride() == B.RowStride() && A.ColStride() == B.ColStride();
+}
+
+//! Check if an operand of an expression overlaps dst. If ExceptSame is true,
+//! the operands which refer to exactly the same elements as dst, and can be
+//! evaluated in place, are not counted.
+template<bool ExceptSame>
+inline bool glMatrixExprReads(const ConstMatrixView& dst, const MatrixRefExpr& e)
+{
+	return glMatrixExprOverlaps(dst, e.Get()) && !(ExceptSame && glMatrixExprSame(dst, e.Get()));
+}
+template<bool ExceptSame, typename L, typename R>
+inline bool glMatrixExprReads(const ConstMatrixView& dst, const MatrixSumExpr<L, R>& e)
+{
+	return glMatrixExprReads<ExceptSame>(dst, e.Left()) || glMatrixExprReads<ExceptSame>(dst, e.Right());
+}
+template<bool ExceptSame, typename L, typename R>
+inline bool glMatrixExprReads(const ConstMatrixView& dst, const MatrixDifferenceExpr<L, R>& e)
+{
+	return glMatrixExprReads<ExceptSame>(dst, e.Left()) || glMatrixExprReads<ExceptSame>(dst, e.Right());
+}
+template<bool ExceptSame, typename E>
+inline bool glMatrixExprReads(const ConstMatrixView& dst, const MatrixScaleExpr<E>& e)
+{
+	return glMatrixExprReads<ExceptSame>(dst, e.Expr());
+}
+template<bool ExceptSame, typename E>
+inline bool glMatrixExprReads(const ConstMatrixView& dst, const MatrixDivideExpr<E>& e)
+{
+	return glMatrixExprReads<ExceptSame>(dst, e.Expr());
+}
+template<bool ExceptSame>
+inline bool glMatrixExprReads(const ConstMatrixView& dst, const MatrixProductExpr& P)
+{
+	return glMatrixExprOverlaps(dst, P.A()) || glMatrixExprOverlaps(dst, P.B());
+}
+template<bool ExceptSame, typename E>
+inline bool glMatrixExprReads(const ConstMatrixView& dst, const MatrixGemmExpr<E>& G)
+{
+	return glMatrixExprReads<ExceptSame>(dst, G.Product()) || glMatrixExprReads<ExceptSame>(dst, G.Addend());
+}
+
+//! Check if the product in an expression reads from dst. Element-wise
+//! expressions can be evaluated in place and never need a temporary.
+template<typename E>
+inline bool glMatrixExprProductReads(const ConstMatrixView&, const E&)
+{
+	return false;
+}
+inline bool glMatrixExprProductReads(const ConstMatrixView& dst, const MatrixProductExpr& P)
+{
+	return glMatrixExprOverlaps(dst, P.A()) || glMatrixExprOverlaps(dst, P.B());
+}
+template<typename E>
+inline bool glMatrixExprProductReads(const ConstMatrixView& dst, const MatrixGemmExpr<E>& G)
+{
+	return glMatrixExprProductReads(dst, G.Product());
+}
+
+//! Accumulator of a glGemm call: the expression is beta*C for a matrix C.
+template<typename E>
+struct MatrixGemmAccumulator
+{
+	static const bool value = false;
+};
+
+template<>
+struct MatrixGemmAccumulator<MatrixRefExpr>
+{
+	static const bool value = true;
+	static inline double                 Beta(const MatrixRefExpr&  ) {return 1.0;}
+	static inline const ConstMatrixView& Get (const MatrixRefExpr& C) {return C.Get();}
+};
+
+template<>
+struct MatrixGemmAccumulator<MatrixScaleExpr<MatrixRefExpr> >
+{
+	static const bool value = true;
+	static inline double                 Beta(const MatrixScaleExpr<MatrixRefExpr>& C) {return C.Scale();}
+	static inline const ConstMatrixView& Get (const MatrixScaleExpr<MatrixRefExpr>& C) {return C.Expr().Get();}
+};
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+//! Evaluate an element-wise expression into dst, or add it to dst, in one pass.
+template<bool Accumulate, typename E>
+void glMatrixExprEvaluate(const MatrixView& dst, const E& e)
+{
+	assert(dst.Rows() == e.Rows() && dst.Cols() == e.Cols());
+	
+	double*      _dst  = dst.Data();
+	const size_t _rs   = dst.RowStride();
+	const size_t _cs   = dst.ColStride();
+	const size_t _cols = dst.Cols();
+	glParallelFor(0, dst.Rows(), std::max<size_t>(1, gcMatrixExprGrain / std::max<size_t>(_cols, 1)), [&](size_t r1, size_t r2)
+	{
+		for(size_t r=r1 ; r<r2 ; ++r)
+		{
+			double* _d = _dst + r*_rs;
+			for(size_t c=0 ; c<_cols ; ++c)
+			{
+				if(Accumulate) _d[c*_cs] += e.Coeff(r, c);
+				else           _d[c*_cs]  = e.Coeff(r, c);
+			}
+		}
+	});
+}
+
+//! Compute dst = alpha*A*B + beta*dst with one glGemmStrided call, beta = 0
+//! means dst is not read. dst must not overlap the operands of the product.
+inline void glMatrixExprGemm(MatrixView dst, const MatrixProductExpr& P, double beta)
+{
+	assert(dst.Rows() == P.Rows() && dst.Cols() == P.Cols());
+	
+	const ConstMatrixView& A = P.A();
+	const ConstMatrixView& B = P.B();
+	if(dst.ColStride() == 1)
+	{
+		glGemmStrided(P.Rows(), P.Cols(), A.Cols(),
+		              P.Alpha(), A.Data(), A.RowStride(), A.ColStride(), B.Data(), B.RowStride(), B.ColStride(),
+		              beta, dst.Data(), dst.RowStride());
+		return;
+	}
+	
+	// The rows of dst are not contiguous, e.g. dst is a transposed view, so
+	// compute the product into a temporary.
+	Matrix _temp(P.Rows(), P.Cols(), MatrixType::Null);
+	glGemmStrided(P.Rows(), P.Cols(), A.Cols(),
+	              P.Alpha(), A.Data(), A.RowStride(), A.ColStride(), B.Data(), B.RowStride(), B.ColStride(),
+	              0.0, _temp.matrix, _temp.cols);
+	if(beta == 0.0)
+	{
+		dst = _temp;
+	}
+	else
+	{
+		if(beta != 1.0)
+		{
+			dst *= beta;
+		}
+		dst += _temp;
+	}
+}
+
+//! Evaluate an element-wise expression into dst.
+template<typename E>
+typename std::enable_if<MatrixExprIsElementwise<E>::value>::type
+glMatrixExprAssign(MatrixView dst, const E& e)
+{
+	// An operand which overlaps dst partially would read overwritten elements.
+	if(glMatrixExprReads<true>(dst, MatrixExprTraits<E>::Get(e)))
+	{
+		dst = Matrix(MatrixExprTraits<E>::Get(e));
+		return;
+	}
+	glMatrixExprEvaluate<false>(dst, MatrixExprTraits<E>::Get(e));
+}
+
+//! Add an element-wise expression to dst.
+template<typename E>
+typename std::enable_if<MatrixExprIsElementwise<E>::value>::type
+glMatrixExprAddTo(MatrixView dst, const E& e)
+{
+	if(glMatrixExprReads<true>(dst, MatrixExprTraits<E>::Get(e)))
+	{
+		dst += Matrix(MatrixExprTraits<E>::Get(e));
+		return;
+	}
+	glMatrixExprEvaluate<true>(dst, MatrixExprTraits<E>::Get(e));
+}
+
+//! Evaluate alpha*A*B into dst with one glGemm call.
+inline void glMatrixExprAssign(MatrixView dst, const MatrixProductExpr& P)
+{
+	if(glMatrixExprProductReads(dst, P))
+	{
+		dst = Matrix(P);
+		return;
+	}
+	glMatrixExprGemm(dst, P, 0.0);
+}
+
+//! Add alpha*A*B to dst with one glGemm call.
+inline void glMatrixExprAddTo(MatrixView dst, const MatrixProductExpr& P)
+{
+	if(glMatrixExprProductReads(dst, P))
+	{
+		dst += Matrix(P);
+		return;
+	}
+	glMatrixExprGemm(dst, P, 1.0);
+}
+
+//! Evaluate alpha*A*B + beta*C with one glGemm call.
+template<typename E>
+typename std::enable_if<MatrixGemmAccumulator<E>::value>::type
+glMatrixExprAssignGemm(MatrixView dst, const MatrixGemmExpr<E>& G)
+{
+	const ConstMatrixView& C     = MatrixGemmAccumulator<E>::Get(G.Addend());
+	const double           _beta = MatrixGemmAccumulator<E>::Beta(G.Addend());
+	
+	// Accumulate directly into C when it is the destination, otherwise
+	// start from a copy of C.
+	if(!glMatrixExprSame(C, dst))
+	{
+		dst = C;
+	}
+	glMatrixExprGemm(dst, G.Product(), _beta);
+}
+
+//! Evaluate alpha*A*B + E by evaluating E into dst and accumulating the product.
+template<typename E>
+typename std::enable_if<!MatrixGemmAccumulator<E>::value>::type
+glMatrixExprAssignGemm(MatrixView dst, const MatrixGemmExpr<E>& G)
+{
+	glMatrixExprAssign(dst, G.Addend());
+	glMatrixExprGemm(dst, G.Product(), 1.0);
+}
+
+//! Evaluate alpha*A*B + E into dst.
+template<typename E>
+void glMatrixExprAssign(MatrixView dst, const MatrixGemmExpr<E>& G)
+{
+	// dst is overwritten before the product is computed so it must not be an
+	// operand of the product, nor overlap the accumulator partially.
+	if(glMatrixExprProductReads(dst, G) || glMatrixExprReads<true>(dst, G.Addend()))
+	{
+		dst = Matrix(G);
+		return;
+	}
+	glMatrixExprAssignGemm(dst, G);
+}
+
+//! Add alpha*A*B + E to dst.
+template<typename E>
+void glMatrixExprAddTo(MatrixView dst, const MatrixGemmExpr<E>& G)
+{
+	if(glMatrixExprProductReads(dst, G))
+	{
+		dst += Matrix(G);
+		return;
+	}
+	glMatrixExprAddTo(dst, G.Addend());
+	glMatrixExprGemm(dst, G.Product(), 1.0);
+}
+
+//! Evaluate an expression into a matrix, resizing it if needed.
+template<typename E>
+void glMatrixExprAssign(Matrix& dst, const E& e)
+{
+	// Evaluate into a temporary if the product reads from dst, or if dst is
+	// resized while an operand refers to its elements.
+	const bool _resize = dst.matrix == nullptr || dst.rows != e.Rows() || dst.cols != e.Cols();
+	if(glMatrixExprProductReads(dst, e) || (_resize && glMatrixExprReads<false>(dst, e)))
+	{
+		Matrix _temp;
+		glMatrixExprAssign(_temp, e);
+		dst.Swap(_temp);
+		return;
+	}
+	glMatrixExprResize(dst, e.Rows(), e.Cols());
+	glMatrixExprAssign(dst.View(), e);
+}
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+//! Construct a matrix by evaluating an expression.
+template<typename T>
+template<typename E>
+MatrixT<T>::MatrixT(const MatrixExpr<E>& expr)
+{
+	rows    = 0;
+	cols    = 0;
+	matType = MatrixType::Null;
+	matrix  = nullptr;
+	
+	glMatrixExprAssign(*this, expr.Self());
+}
+
+//! Assign an expression to the matrix.
+template<typename T>
+template<typename E>
+MatrixT<T>& MatrixT<T>::operator =(const MatrixExpr<E>& expr)
+{
+	glMatrixExprAssign(*this, expr.Self());
+	return *this;
+}
+
+//! Add an expression to the matrix.
+template<typename T>
+template<typename E>
+MatrixT<T>& MatrixT<T>::operator +=(const MatrixExpr<E>& expr)
+{
+	glMatrixExprAddTo(View(), expr.Self());
+	return *this;
+}
+
+//! Subtract an expression from the matrix.
+template<typename T>
+template<typename E>
+MatrixT<T>& MatrixT<T>::operator -=(const MatrixExpr<E>& expr)
+{
+	glMatrixExprAddTo(View(), -expr.Self());
+	return *this;
+}
+
+//! Assign an expression to the elements of the view.
+template<typename T>
+template<typename E>
+MatrixViewT<T>& MatrixViewT<T>::operator =(const MatrixExpr<E>& expr)
+{
+	glMatrixExprAssign(*this, expr.Self());
+	return *this;
+}
+
+//! Add an expression to the elements of the view.
+template<typename T>
+template<typename E>
+MatrixViewT<T>& MatrixViewT<T>::operator +=(const MatrixExpr<E>& expr)
+{
+	glMatrixExprAddTo(*this, expr.Self());
+	return *this;
+}
+
+//! Subtract an expression from the elements of the view.
+template<typename T>
+template<typename E>
+MatrixViewT<T>& MatrixViewT<T>::operator -=(const MatrixExpr<E>& expr)
+{
+	glMatrixExprAddTo(*this, -expr.Self());
+	return *this;
+}
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
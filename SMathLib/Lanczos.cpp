@@ -0,0 +1,310 @@
+// 
+// This file is part of SLogLib; you can redistribute it and/or 
+// modify it under the terms of the MIT License.
+// Author: Saurabh Garg (saurabhgarg@mysoc.net)
+// 
+
+#include "Lanczos.h"
+#include "Gemm.h"
+#include "Parallel.h"
+#include "SUtils/Exceptions/InvalidArgumentException.h"
+#include <Eigen/Dense>
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace SMathLib {
+;
+
+// a new vector whose norm drops below this fraction of A*v after the
+// orthogonalization is treated as a breakdown of the Lanczos recurrence.
+static const double gcBreakdown = 1e-10;
+
+static double Norm(size_t n, const double* x)
+{
+	double _s = 0.0;
+	for(size_t i=0 ; i<n ; ++i)
+	{
+		_s += x[i]*x[i];
+	}
+	return std::sqrt(_s);
+}
+
+// h = V*w for the first count rows of V (count x n).
+static void Project(const double* V, size_t count, size_t n, const double* w, double* h, unsigned int numThreads)
+{
+	glParallelFor(0, count, 1, [&](size_t b, size_t e)
+	{
+		for(size_t i=b ; i<e ; ++i)
+		{
+			const double* _v = V + i*n;
+			double        _s = 0.0;
+			for(size_t t=0 ; t<n ; ++t)
+			{
+				_s += _v[t]*w[t];
+			}
+			h[i] = _s;
+		}
+	}, numThreads);
+}
+
+// w -= V^T*h for the first count rows of V.
+static void Subtract(const double* V, size_t count, size_t n, const double* h, double* w, unsigned int numThreads)
+{
+	glParallelFor(0, n, 4096, [&](size_t b, size_t e)
+	{
+		for(size_t i=0 ; i<count ; ++i)
+		{
+			const double* _v = V + i*n;
+			const double  _s = h[i];
+			for(size_t t=b ; t<e ; ++t)
+			{
+				w[t] -= _s*_v[t];
+			}
+		}
+	}, numThreads);
+}
+
+// orthogonalize w against the first count rows of V with classical
+// Gram-Schmidt, repeated once if the norm of w drops by more than 1/sqrt(2)
+// (the DGKS criterion). h receives the projections of w on the rows, returns
+// the norm of w before and after the orthogonalization. The products are
+// matrix-vector products bound by the memory bandwidth, so they stream over V
+// directly instead of going through glGemm.
+static void Orthogonalize(const double* V, size_t count, size_t n, double* w, double* h,
+                          double* normBefore, double* normAfter, unsigned int numThreads)
+{
+	*normBefore = Norm(n, w);
+	Project(V, count, n, w, h, numThreads);
+	Subtract(V, count, n, h, w, numThreads);
+	*normAfter = Norm(n, w);
+	if(*normAfter < 0.7071067811865476 * *normBefore)
+	{
+		std::vector<double> _h(count);
+		Project(V, count, n, w, _h.data(), numThreads);
+		Subtract(V, count, n, _h.data(), w, numThreads);
+		for(size_t i=0 ; i<count ; ++i)
+		{
+			h[i] += _h[i];
+		}
+		*normAfter = Norm(n, w);
+	}
+}
+
+
+// options.
+// ------------------------------------------------------------------------- //
+LanczosOptions::LanczosOptions()
+	: which(LanczosWhich::Largest), subspaceSize(0), maxRestarts(1000), tolerance(1e-10), seed(0), numThreads(0)
+{}
+
+LanczosResult::LanczosResult()
+	: converged(false), restarts(0), products(0)
+{}
+// ------------------------------------------------------------------------- //
+
+
+// lanczos.
+// ------------------------------------------------------------------------- //
+LanczosResult glLanczosEigen(size_t n, const LanczosOperator& A, size_t k, Matrix* values, Matrix* vectors,
+                             const LanczosOptions& options)
+{
+	if(k > n)
+	{
+		char _msg[] = "k is larger than the size of the operator in glLanczosEigen";
+		throw SUtils::Exceptions::InvalidArgumentException(_msg);
+	}
+	
+	LanczosResult _result;
+	if(k == 0)
+	{
+		_result.converged = true;
+		if(values != nullptr)
+		{
+			*values = Matrix(0, 1);
+		}
+		if(vectors != nullptr)
+		{
+			*vectors = Matrix(n, 0);
+		}
+		return _result;
+	}
+	
+	// the subspace must hold more than k vectors to restart, unless it is the
+	// whole space.
+	const size_t       _m  = std::min(n, std::max(k+1, options.subspaceSize == 0 ? std::max(2*k+1, k+20)
+	                                                                            : options.subspaceSize));
+	const unsigned int _nt = options.numThreads;
+	
+	// the basis vectors are the rows of V, row m holds the residual vector.
+	std::vector<double>              _V((_m+1)*n, 0.0);
+	std::vector<double>              _h(_m);
+	Eigen::MatrixXd                  _H = Eigen::MatrixXd::Zero(Eigen::Index(_m), Eigen::Index(_m));
+	std::mt19937_64                  _engine(options.seed);
+	std::normal_distribution<double> _normal;
+	auto _random = [&](double* v, size_t count)
+	{
+		for(size_t i=0 ; i<n ; ++i)
+		{
+			v[i] = _normal(_engine);
+		}
+		double _norm0, _norm;
+		Orthogonalize(_V.data(), count, n, v, _h.data(), &_norm0, &_norm, _nt);
+		for(size_t i=0 ; i<n ; ++i)
+		{
+			v[i] /= _norm;
+		}
+	};
+	_random(_V.data(), 0);
+	
+	// position of the i-th wanted Ritz value in the increasing eigenvalues of H.
+	auto _wanted = [&](size_t i) -> Eigen::Index
+	{
+		return Eigen::Index(options.which == LanczosWhich::Largest ? _m-1-i : i);
+	};
+	
+	Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> _eigen;
+	size_t _start = 0;
+	double _beta  = 0.0;
+	while(true)
+	{
+		// extend the basis to m vectors, H = V^T*A*V is built column by column
+		// from the projections.
+		for(size_t j=_start ; j<_m ; ++j)
+		{
+			double* _w = _V.data() + (j+1)*n;
+			A(_V.data() + j*n, _w);
+			++_result.products;
+			
+			double _wNorm;
+			Orthogonalize(_V.data(), j+1, n, _w, _h.data(), &_wNorm, &_beta, _nt);
+			for(size_t i=0 ; i<=j ; ++i)
+			{
+				_H(Eigen::Index(i), Eigen::Index(j)) = _h[i];
+				_H(Eigen::Index(j), Eigen::Index(i)) = _h[i];
+			}
+			
+			if(_beta > gcBreakdown*_wNorm)
+			{
+				for(size_t i=0 ; i<n ; ++i)
+				{
+					_w[i] /= _beta;
+				}
+			}
+			else
+			{
+				// the basis spans an invariant subspace, continue with a new
+				// random direction.
+				_beta = 0.0;
+				if(j+1 < _m)
+				{
+					_random(_w, j+1);
+				}
+				else
+				{
+					std::fill(_w, _w+n, 0.0);
+				}
+			}
+		}
+		
+		// Ritz values and the residuals |A*x - l*x| = beta*|last element of y|.
+		_eigen.compute(_H);
+		const Eigen::VectorXd& _theta = _eigen.eigenvalues();
+		const Eigen::MatrixXd& _Y     = _eigen.eigenvectors();
+		const double           _scale = std::max(std::fabs(_theta(0)), std::fabs(_theta(Eigen::Index(_m)-1)));
+		bool _converged = true;
+		for(size_t i=0 ; i<k ; ++i)
+		{
+			_converged = _converged &&
+			             std::fabs(_beta * _Y(Eigen::Index(_m)-1, _wanted(i))) <= options.tolerance * _scale;
+		}
+		if(_converged || _result.restarts == options.maxRestarts)
+		{
+			_result.converged = _converged;
+			break;
+		}
+		
+		// thick restart: keep the p best Ritz vectors and the residual vector,
+		// H becomes diagonal and its next column is filled by the projections.
+		const size_t _p = std::min(_m-1, k + (_m-k)/2);
+		Matrix _Yt(_p, _m, MatrixType::Null);
+		for(size_t i=0 ; i<_p ; ++i)
+		{
+			for(size_t r=0 ; r<_m ; ++r)
+			{
+				_Yt(i, r) = _Y(Eigen::Index(r), _wanted(i));
+			}
+		}
+		std::vector<double> _ritz(_p*n);
+		glGemm(_p, n, _m, 1.0, _Yt.matrix, _m, _V.data(), n, 0.0, _ritz.data(), n, _nt);
+		std::copy(_ritz.begin(), _ritz.end(), _V.begin());
+		std::copy(_V.begin() + _m*n, _V.begin() + (_m+1)*n, _V.begin() + _p*n);
+		
+		_H.setZero();
+		for(size_t i=0 ; i<_p ; ++i)
+		{
+			_H(Eigen::Index(i), Eigen::Index(i)) = _theta(_wanted(i));
+		}
+		_start = _p;
+		++_result.restarts;
+	}
+	
+	// the Ritz pairs, x = V^T*y.
+	const Eigen::VectorXd& _theta = _eigen.eigenvalues();
+	const Eigen::MatrixXd& _Y     = _eigen.eigenvectors();
+	if(values != nullptr)
+	{
+		*values = Matrix(k, 1, MatrixType::Null);
+		for(size_t i=0 ; i<k ; ++i)
+		{
+			values->matrix[i] = _theta(_wanted(i));
+		}
+	}
+	if(vectors != nullptr)
+	{
+		Matrix _Yk(_m, k, MatrixType::Null);
+		for(size_t r=0 ; r<_m ; ++r)
+		{
+			for(size_t i=0 ; i<k ; ++i)
+			{
+				_Yk(r, i) = _Y(Eigen::Index(r), _wanted(i));
+			}
+		}
+		*vectors = Matrix(n, k, MatrixType::Null);
+		glGemmStrided(n, k, _m, 1.0, _V.data(), 1, n, _Yk.matrix, k, 1, 0.0, vectors->matrix, k, _nt);
+	}
+	return _result;
+}
+
+LanczosResult glLanczosEigen(const SparseMatrix& A, size_t k, Matrix* values, Matrix* vectors,
+                             const LanczosOptions& options)
+{
+	if(A.Rows() != A.Cols())
+	{
+		char _msg[] = "Matrix is not square in glLanczosEigen";
+		throw SUtils::Exceptions::InvalidArgumentException(_msg);
+	}
+	return glLanczosEigen(A.Rows(), [&](const double* x, double* y)
+	{
+		A.Multiply(x, y, options.numThreads);
+	}, k, values, vectors, options);
+}
+
+LanczosResult glLanczosEigen(const ConstMatrixView& A, size_t k, Matrix* values, Matrix* vectors,
+                             const LanczosOptions& options)
+{
+	if(A.Rows() != A.Cols())
+	{
+		char _msg[] = "Matrix is not square in glLanczosEigen";
+		throw SUtils::Exceptions::InvalidArgumentException(_msg);
+	}
+	return glLanczosEigen(A.Rows(), [&](const double* x, double* y)
+	{
+		glGemmStrided(A.Rows(), 1, A.Cols(), 1.0, A.Data(), A.RowStride(), A.ColStride(), x, 1, 1,
+		              0.0, y, 1, options.numThreads);
+	}, k, values, vectors, options);
+}
+// ------------------------------------------------------------------------- //
+
+};	// End namespace SMathLib.
@@ -0,0 +1,93 @@
+// 
+// This file is part of SLogLib; you can redistribute it and/or 
+// modify it under the terms of the MIT License.
+// Author: Saurabh Garg (saurabhgarg@mysoc.net)
+// 
+
+#ifndef _SMATHLIB_LANCZOS_H_
+#define _SMATHLIB_LANCZOS_H_
+
+#include "SMathLib/Config.h"
+#include "SMathLib/Matrix.h"
+#include "SMathLib/MatrixView.h"
+#include "SMathLib/SparseMatrix.h"
+#include <cstdint>
+#include <functional>
+
+namespace SMathLib {
+;
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+// A few extreme eigenpairs of a large symmetric operator with the thick-restart
+// Lanczos method. The operator is only used through products y = A*x, so it
+// can be a dense matrix, a SparseMatrix or any function:
+//
+//     Matrix _values, _vectors;
+//     glLanczosEigen(n, [&](const double* x, double* y) {...}, 10, &_values, &_vectors);
+//
+// The Krylov basis is fully reorthogonalized, which keeps the Ritz values
+// free of spurious copies at the cost of O(n*m) work per product, where m is
+// the size of the subspace. For all the eigenpairs of a small dense matrix
+// use Matrix::EigenSymmetric().
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+//! Which end of the spectrum glLanczosEigen() computes.
+enum class LanczosWhich
+{
+	Largest,     ///< The algebraically largest eigenvalues.
+	Smallest     ///< The algebraically smallest eigenvalues.
+};
+
+//! Options of glLanczosEigen().
+struct SMATHLIB_DLL_API LanczosOptions
+{
+	LanczosOptions();
+	
+	LanczosWhich which;            ///< Default Largest.
+	size_t       subspaceSize;     ///< Size m of the Krylov subspace, 0 (the default) means max(2k+1, k+20).
+	size_t       maxRestarts;      ///< Default 1000.
+	double       tolerance;        ///< Residual |A*x-l*x| relative to the largest Ritz value, default 1e-10.
+	uint64_t     seed;             ///< Seed of the random start vector, default 0.
+	unsigned int numThreads;       ///< 0 means use glGetNumThreads(), the default.
+};
+
+//! Outcome of glLanczosEigen().
+struct SMATHLIB_DLL_API LanczosResult
+{
+	LanczosResult();
+	
+	bool   converged;      ///< All the k eigenpairs reached the tolerance.
+	size_t restarts;       ///< Number of restarts performed.
+	size_t products;       ///< Number of products with A.
+};
+
+//! Product y = A*x of a symmetric n x n operator, x and y don't overlap.
+typedef std::function<void(const double* x, double* y)> LanczosOperator;
+
+//! Compute k eigenpairs of a symmetric operator.
+//! \param n Size of the operator.
+//! \param A Computes y = A*x.
+//! \param k Number of eigenpairs, at most n.
+//! \param values Receives the eigenvalues as a k x 1 matrix, in decreasing
+//!               order for Largest and increasing order for Smallest.
+//! \param vectors Receives the orthonormal eigenvectors as the columns of a
+//!                n x k matrix, can be nullptr.
+//! If the method does not converge the best approximations are returned.
+//! Throws SUtils::Exceptions::InvalidArgumentException if k > n.
+SMATHLIB_DLL_API LanczosResult glLanczosEigen(size_t n, const LanczosOperator& A, size_t k,
+                                              Matrix* values, Matrix* vectors,
+                                              const LanczosOptions& options = LanczosOptions());
+
+//! Compute k eigenpairs of a symmetric sparse or dense matrix, the products
+//! run on the thread pool.
+SMATHLIB_DLL_API LanczosResult glLanczosEigen(const SparseMatrix& A, size_t k, Matrix* values, Matrix* vectors,
+                                              const LanczosOptions& options = LanczosOptions());
+SMATHLIB_DLL_API LanczosResult glLanczosEigen(const ConstMatrixView& A, size_t k, Matrix* values, Matrix* vectors,
+                                              const LanczosOptions& options = LanczosOptions());
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+
+};	// End namespace SMathLib.
+
+#endif // _SMATHLIB_LANCZOS_H_
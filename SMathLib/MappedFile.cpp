@@ -0,0 +1,344 @@
+// 
+// This file is part of SLogLib; you can redistribute it and/or 
+// modify it under the terms of the MIT License.
+// Author: Saurabh Garg (saurabhgarg@mysoc.net)
+// 
+
+#include "MappedFile.h"
+#include "SUtils/Exceptions/InvalidOperationException.h"
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <utility>
+
+#if defined(SMATHLIB_OS_WINDOWS)
+#	ifndef NOMINMAX
+#		define NOMINMAX
+#	endif
+#	include <windows.h>
+#else
+#	include <fcntl.h>
+#	include <sys/mman.h>
+#	include <sys/stat.h>
+#	include <unistd.h>
+#endif
+
+namespace SMathLib {
+;
+
+struct MappedFilePriv
+{
+	MappedFilePriv() : base(nullptr), size(0), writable(false), open(false)
+#if defined(SMATHLIB_OS_WINDOWS)
+		, file(INVALID_HANDLE_VALUE), mapping(nullptr)
+#else
+		, fd(-1)
+#endif
+	{}
+	
+	char*  base;      // start of the mapping, nullptr for empty files.
+	size_t size;
+	bool   writable;
+	bool   open;
+#if defined(SMATHLIB_OS_WINDOWS)
+	HANDLE file;
+	HANDLE mapping;
+#else
+	int    fd;
+#endif
+};
+
+static void ThrowMappingError(const char* what, const std::string& fileName, const char* func)
+{
+	std::string _msg = std::string(what) + " " + fileName + " in " + func;
+	throw SUtils::Exceptions::InvalidOperationException(_msg.c_str());
+}
+
+static size_t PageSize()
+{
+#if defined(SMATHLIB_OS_WINDOWS)
+	SYSTEM_INFO _info;
+	GetSystemInfo(&_info);
+	return size_t(_info.dwPageSize);
+#else
+	return size_t(sysconf(_SC_PAGESIZE));
+#endif
+}
+
+// expand [offset, offset+length) to whole pages inside the mapping, returns
+// false if the range is empty.
+static bool PageRange(const MappedFilePriv& priv, size_t offset, size_t length, char*& begin, size_t& size)
+{
+	if(priv.base == nullptr || offset >= priv.size || length == 0)
+	{
+		return false;
+	}
+	const size_t _page  = PageSize();
+	const size_t _first = offset / _page * _page;
+	const size_t _last  = std::min(priv.size, offset + std::min(length, priv.size - offset));
+	begin = priv.base + _first;
+	size  = _last - _first;
+	return true;
+}
+
+static void Unmap(MappedFilePriv& priv)
+{
+#if defined(SMATHLIB_OS_WINDOWS)
+	if(priv.base != nullptr)
+	{
+		if(priv.writable)
+		{
+			FlushViewOfFile(priv.base, 0);
+		}
+		UnmapViewOfFile(priv.base);
+	}
+	if(priv.mapping != nullptr)
+	{
+		CloseHandle(priv.mapping);
+	}
+	if(priv.file != INVALID_HANDLE_VALUE)
+	{
+		CloseHandle(priv.file);
+	}
+#else
+	if(priv.base != nullptr)
+	{
+		munmap(priv.base, priv.size);
+	}
+	if(priv.fd >= 0)
+	{
+		close(priv.fd);
+	}
+#endif
+	priv = MappedFilePriv();
+}
+
+// map the file which is open in priv, with size priv.size.
+static void Map(MappedFilePriv& priv, const std::string& fileName, const char* func)
+{
+	if(priv.size == 0)
+	{
+		return;
+	}
+
+#if defined(SMATHLIB_OS_WINDOWS)
+	priv.mapping = CreateFileMappingA(priv.file, nullptr, priv.writable ? PAGE_READWRITE : PAGE_READONLY,
+	                                  DWORD(uint64_t(priv.size) >> 32), DWORD(priv.size & 0xffffffffu), nullptr);
+	if(priv.mapping != nullptr)
+	{
+		priv.base = static_cast<char*>(MapViewOfFile(priv.mapping, priv.writable ? FILE_MAP_WRITE : FILE_MAP_READ,
+		                                             0, 0, 0));
+	}
+	if(priv.base == nullptr)
+	{
+		Unmap(priv);
+		ThrowMappingError("Unable to map", fileName, func);
+	}
+#else
+	void* _base = mmap(nullptr, priv.size, priv.writable ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, priv.fd, 0);
+	if(_base == MAP_FAILED)
+	{
+		Unmap(priv);
+		ThrowMappingError("Unable to map", fileName, func);
+	}
+	priv.base = static_cast<char*>(_base);
+#endif
+}
+
+
+// constructors.
+// ------------------------------------------------------------------------- //
+MappedFile::MappedFile()
+	: mPriv(new MappedFilePriv())
+{}
+
+MappedFile::MappedFile(MappedFile&& B)
+	: mPriv(B.mPriv)
+{
+	B.mPriv = new MappedFilePriv();
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& B)
+{
+	std::swap(mPriv, B.mPriv);
+	return *this;
+}
+
+MappedFile::~MappedFile()
+{
+	Unmap(*mPriv);
+	delete mPriv;
+}
+// ------------------------------------------------------------------------- //
+
+
+// mapping.
+// ------------------------------------------------------------------------- //
+void MappedFile::Open(const std::string& fileName, bool writable)
+{
+	Close();
+	
+	MappedFilePriv _priv;
+	_priv.writable = writable;
+	_priv.open     = true;
+#if defined(SMATHLIB_OS_WINDOWS)
+	_priv.file = CreateFileA(fileName.c_str(), writable ? GENERIC_READ | GENERIC_WRITE : GENERIC_READ,
+	                         FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	LARGE_INTEGER _fileSize;
+	if(_priv.file == INVALID_HANDLE_VALUE || !GetFileSizeEx(_priv.file, &_fileSize))
+	{
+		Unmap(_priv);
+		ThrowMappingError("Unable to open", fileName, "MappedFile::Open");
+	}
+	_priv.size = size_t(_fileSize.QuadPart);
+	Map(_priv, fileName, "MappedFile::Open");
+#else
+	_priv.fd = open(fileName.c_str(), writable ? O_RDWR : O_RDONLY);
+	struct stat _stat;
+	if(_priv.fd < 0 || fstat(_priv.fd, &_stat) != 0)
+	{
+		Unmap(_priv);
+		ThrowMappingError("Unable to open", fileName, "MappedFile::Open");
+	}
+	_priv.size = size_t(_stat.st_size);
+	Map(_priv, fileName, "MappedFile::Open");
+#endif
+	*mPriv = _priv;
+}
+
+void MappedFile::Create(const std::string& fileName, size_t size)
+{
+	Close();
+	
+	MappedFilePriv _priv;
+	_priv.writable = true;
+	_priv.open     = true;
+	_priv.size     = size;
+#if defined(SMATHLIB_OS_WINDOWS)
+	// the file mapping extends the file to its size.
+	_priv.file = CreateFileA(fileName.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr,
+	                         CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if(_priv.file == INVALID_HANDLE_VALUE)
+	{
+		ThrowMappingError("Unable to create", fileName, "MappedFile::Create");
+	}
+	DWORD _returned = 0;
+	DeviceIoControl(_priv.file, FSCTL_SET_SPARSE, nullptr, 0, nullptr, 0, &_returned, nullptr);
+	Map(_priv, fileName, "MappedFile::Create");
+#else
+	_priv.fd = open(fileName.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+	if(_priv.fd < 0 || ftruncate(_priv.fd, off_t(size)) != 0)
+	{
+		Unmap(_priv);
+		ThrowMappingError("Unable to create", fileName, "MappedFile::Create");
+	}
+	Map(_priv, fileName, "MappedFile::Create");
+#endif
+	*mPriv = _priv;
+}
+
+void MappedFile::Close()
+{
+	Unmap(*mPriv);
+}
+
+bool MappedFile::IsOpen() const
+{
+	return mPriv->open;
+}
+
+bool MappedFile::IsWritable() const
+{
+	return mPriv->writable;
+}
+
+size_t MappedFile::Size() const
+{
+	return mPriv->size;
+}
+
+const char* MappedFile::Data() const
+{
+	return mPriv->base;
+}
+
+char* MappedFile::WritableData()
+{
+	assert(mPriv->writable);
+	return mPriv->base;
+}
+// ------------------------------------------------------------------------- //
+
+
+// paging hints.
+// ------------------------------------------------------------------------- //
+void MappedFile::Prefetch(size_t offset, size_t length) const
+{
+	char*  _begin = nullptr;
+	size_t _size  = 0;
+	if(!PageRange(*mPriv, offset, length, _begin, _size))
+	{
+		return;
+	}
+#if defined(SMATHLIB_OS_WINDOWS)
+#	if defined(_WIN32_WINNT) && _WIN32_WINNT >= 0x0602
+	WIN32_MEMORY_RANGE_ENTRY _range = {_begin, _size};
+	PrefetchVirtualMemory(GetCurrentProcess(), 1, &_range, 0);
+#	endif
+#else
+	madvise(_begin, _size, MADV_WILLNEED);
+#endif
+}
+
+void MappedFile::Evict(size_t offset, size_t length) const
+{
+	char*  _begin = nullptr;
+	size_t _size  = 0;
+	if(!PageRange(*mPriv, offset, length, _begin, _size))
+	{
+		return;
+	}
+#if defined(SMATHLIB_OS_WINDOWS)
+	// unlocking pages which are not locked removes them from the working set.
+	if(mPriv->writable)
+	{
+		FlushViewOfFile(_begin, _size);
+	}
+	VirtualUnlock(_begin, _size);
+#else
+	// the mapping is shared, so the modified pages stay in the page cache and
+	// are written back by the kernel.
+	if(mPriv->writable)
+	{
+		msync(_begin, _size, MS_ASYNC);
+	}
+	madvise(_begin, _size, MADV_DONTNEED);
+#endif
+}
+
+void MappedFile::Flush(size_t offset, size_t length, bool wait) const
+{
+	char*  _begin = nullptr;
+	size_t _size  = 0;
+	if(!mPriv->writable || !PageRange(*mPriv, offset, length, _begin, _size))
+	{
+		return;
+	}
+#if defined(SMATHLIB_OS_WINDOWS)
+	FlushViewOfFile(_begin, _size);
+	if(wait)
+	{
+		FlushFileBuffers(mPriv->file);
+	}
+#else
+	msync(_begin, _size, wait ? MS_SYNC : MS_ASYNC);
+#endif
+}
+
+void MappedFile::Flush() const
+{
+	Flush(0, mPriv->size, true);
+}
+// ------------------------------------------------------------------------- //
+
+};	// End namespace SMathLib.
@@ -0,0 +1,82 @@
+// 
+// This file is part of SLogLib; you can redistribute it and/or 
+// modify it under the terms of the MIT License.
+// Author: Saurabh Garg (saurabhgarg@mysoc.net)
+// 
+
+#ifndef _SMATHLIB_MAPPEDFILE_H_
+#define _SMATHLIB_MAPPEDFILE_H_
+
+#include "SMathLib/Config.h"
+#include <cstddef>
+#include <string>
+
+namespace SMathLib {
+;
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+struct MappedFilePriv;
+
+//! A file mapped in memory, with mmap() on Linux and macOS and file mappings
+//! on Windows. The whole file is mapped, the operating system pages it in
+//! when it is accessed and writes the modified pages back to the file.
+//! Errors throw SUtils::Exceptions::InvalidOperationException.
+class SMATHLIB_DLL_API MappedFile
+{
+public:  // Constructors.
+
+	MappedFile();
+	MappedFile(MappedFile&& B);
+	MappedFile& operator=(MappedFile&& B);
+	~MappedFile();
+	
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+public:  // Mapping.
+
+	//! Map an existing file, read-only or for reading and writing.
+	void Open(const std::string& fileName, bool writable = false);
+	
+	//! Create a file of size bytes, or truncate an existing one, and map it for
+	//! reading and writing. The file is filled with zeros; where the file
+	//! system supports it the file is sparse and takes no space until written.
+	void Create(const std::string& fileName, size_t size);
+	
+	//! Write the modified pages back and unmap the file.
+	void Close();
+	
+	bool   IsOpen() const;
+	bool   IsWritable() const;
+	size_t Size() const;
+	
+	const char* Data() const;
+	
+	//! Pointer to the mapping for writing, the file must be writable.
+	char* WritableData();
+
+public:  // Paging hints.
+
+	//! Ask the operating system to read the bytes [offset, offset+length) ahead
+	//! of their use. This returns immediately.
+	void Prefetch(size_t offset, size_t length) const;
+	
+	//! Tell the operating system that the bytes [offset, offset+length) are not
+	//! needed any more so that their pages can be dropped from memory. Modified
+	//! pages are written back first, the contents stay valid.
+	void Evict(size_t offset, size_t length) const;
+	
+	//! Write the modified pages in [offset, offset+length) back to the file,
+	//! waiting for the writes to complete if wait is true.
+	void Flush(size_t offset, size_t length, bool wait = true) const;
+	void Flush() const;
+
+private:
+
+	MappedFilePriv* mPriv;
+};
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+
+};	// End namespace SMathLib.
+
+#endif // _SMATHLIB_MAPPEDFILE_H_
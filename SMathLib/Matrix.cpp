@@ -5,23 +5,143 @@
 // 
 
 #include "Matrix.h"
+#include "BandedMatrix.h"
 #include "CompareDouble.h"
+#include "EigenInterop.h"
+#include "Gemm.h"
+#include "MatrixAllocator.h"
+#include "Parallel.h"
+#include "Reduce.h"
+#include "TextParser.h"
+#include "Transpose.h"
+#include "SUtils/Exceptions/InvalidArgumentException.h"
 #include <Eigen/Dense>
 #include <Eigen/SVD>
 #include <Eigen/LU>
+#include <Eigen/QR>
+#include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <cmath>
 #include <ctime>
 #include <cstring>
+#include <utility>
+#include <vector>
 
 namespace SMathLib {
 ;
 
+// minimum number of elements processed by a thread in element-wise operations.
+static const size_t gcParallelGrain = 32768;
+
+// SolveAxB() with SolveMode::Auto uses banded LU if the width of the band of A
+// is at most 1/gcBandedSolveRatio of its size.
+static const size_t gcBandedSolveRatio = 4;
+
+// number of rows which have at least gcParallelGrain elements.
+static size_t RowGrain(size_t cols)
+{
+	return cols == 0 ? 1 : (gcParallelGrain + cols - 1) / cols;
+}
+
+// number of element arrays allocated by all the matrices.
+static std::atomic<size_t> gAllocationCount(0);
+
+
+// product C = A*B of row-major matrices, C is m x n and A is m x k.
+static void Product(size_t m, size_t n, size_t k, const double* A, const double* B, double* C)
+{
+	glGemm(m, n, k, 1.0, A, k, B, n, 0.0, C, n);
+}
+
+// glGemm() only multiplies doubles, products of floats go through Eigen.
+static void Product(size_t m, size_t n, size_t k, const float* A, const float* B, float* C)
+{
+	typedef EigenTypes<float>::ConstMap ConstMap;
+	EigenTypes<float>::Map(C, m, n).noalias() = ConstMap(A, m, k) * ConstMap(B, k, n);
+}
+
+// C = A^T*A, C is n x n with the lower triangle computed.
+static void GramLower(const ConstMatrixView& A, Matrix& C)
+{
+	// A row-major A gives A^T*A directly, a column-major one (e.g. a transposed
+	// view) is the row-major B = A^T and gives B*B^T; others are copied first.
+	if(A.ColStride() == 1)
+	{
+		glSyrk(GemmTriangle::Lower, GemmOp::Transpose, A.Cols(), A.Rows(), 1.0, A.Data(), A.RowStride(),
+		       0.0, C.matrix, C.cols);
+	}
+	else if(A.RowStride() == 1)
+	{
+		glSyrk(GemmTriangle::Lower, GemmOp::None, A.Cols(), A.Rows(), 1.0, A.Data(), A.ColStride(),
+		       0.0, C.matrix, C.cols);
+	}
+	else
+	{
+		GramLower(Matrix(A), C);
+	}
+}
+
+static void GramLower(const ConstMatrixViewF& A, MatrixF& C)
+{
+	C.AsEigen().template triangularView<Eigen::Lower>() = A.AsEigen().transpose() * A.AsEigen();
+}
+
+// X = op(A)^-1*X for a triangular A.
+static void SolveTriangular(const ConstMatrixView& A, GemmTriangle uplo, GemmOp op, bool unitDiagonal, Matrix& X)
+{
+	// a column-major A is the transpose of a row-major matrix.
+	if(A.ColStride() == 1 || A.RowStride() == 1)
+	{
+		const bool _rowMajor = A.ColStride() == 1;
+		if(!_rowMajor)
+		{
+			uplo = (uplo == GemmTriangle::Lower) ? GemmTriangle::Upper : GemmTriangle::Lower;
+			op   = (op   == GemmOp::None)        ? GemmOp::Transpose   : GemmOp::None;
+		}
+		glTrsm(uplo, op, unitDiagonal, A.Rows(), X.cols, 1.0, A.Data(), _rowMajor ? A.RowStride() : A.ColStride(),
+		       X.matrix, X.cols);
+	}
+	else
+	{
+		SolveTriangular(Matrix(A), uplo, op, unitDiagonal, X);
+	}
+}
+
+static void SolveTriangular(const ConstMatrixViewF& A, GemmTriangle uplo, GemmOp op, bool unitDiagonal, MatrixF& X)
+{
+	// Eigen's triangular views are selected at compile time.
+	auto _solve = [&](auto _A)
+	{
+		if(uplo == GemmTriangle::Lower)
+		{
+			if(unitDiagonal) _A.template triangularView<Eigen::UnitLower>().solveInPlace(X.AsEigen());
+			else             _A.template triangularView<Eigen::Lower>().solveInPlace(X.AsEigen());
+		}
+		else
+		{
+			if(unitDiagonal) _A.template triangularView<Eigen::UnitUpper>().solveInPlace(X.AsEigen());
+			else             _A.template triangularView<Eigen::Upper>().solveInPlace(X.AsEigen());
+		}
+	};
+	if(op == GemmOp::None)
+	{
+		_solve(A.AsEigen());
+	}
+	else
+	{
+		// the transpose of the triangle uplo of A.
+		uplo = (uplo == GemmTriangle::Lower) ? GemmTriangle::Upper : GemmTriangle::Lower;
+		_solve(A.AsEigen().transpose());
+	}
+}
+
 // constructors and destructor.
 // ------------------------------------------------------------------------- //
 
 // default constructor.
-Matrix::Matrix()
+template<typename T>
+MatrixT<T>::MatrixT()
 {
 	rows    = 0;
 	cols    = 0;
@@ -30,13 +150,15 @@ Matrix::Matrix()
 }
 
 // creates r*c matrix. default type is M_ZEROS
-Matrix::Matrix(size_t r, size_t c, MatrixType type)
+template<typename T>
+MatrixT<T>::MatrixT(size_t r, size_t c, MatrixType type)
 {
 	// rows and cols must be non-negative.
 	assert(r>=0 && c>=0);
 	
-	rows = r;
-	cols = c;
+	rows    = r;
+	cols    = c;
+	matType = type;
 	
 	if(rows == cols)
 	{
@@ -51,13 +173,12 @@ Matrix::Matrix(size_t r, size_t c, MatrixType type)
 		matType = MatrixType::ColumnVector;
 	}
 	
-	matrix = new double[rows*cols];
-	assert(matrix);
+	matrix = AllocateElements(rows*cols);
 	
 	// initialize matrix based on type.
 	if(type == MatrixType::Zero)
 	{
-		memset(matrix, 0, rows * cols * sizeof(double));
+		memset(matrix, 0, rows * cols * sizeof(T));
 	}
 	
 	else if(type == MatrixType::Identity)
@@ -85,7 +206,7 @@ Matrix::Matrix(size_t r, size_t c, MatrixType type)
 		{
 			for(size_t j=0 ; j<cols ; j++)
 			{
-				matrix[i * cols + j] = (double)(rand() % 100) / 100.0;
+				matrix[i * cols + j] = T(rand() % 100) / T(100);
 			}
 		}
 	}
@@ -100,13 +221,15 @@ Matrix::Matrix(size_t r, size_t c, MatrixType type)
 }
 
 // constructs a matrix using a linear array.
-Matrix::Matrix(size_t r, size_t c, const double* data)
+template<typename T>
+MatrixT<T>::MatrixT(size_t r, size_t c, const T* data)
 {
 	// rows and cols must be non-negative.
 	assert(r>=0 && c>=0);
 	
-	rows = r;
-	cols = c;
+	rows    = r;
+	cols    = c;
+	matType = MatrixType::Null;
 	
 	if (rows == cols)
 	{
@@ -121,14 +244,22 @@ Matrix::Matrix(size_t r, size_t c, const double* data)
 		matType = MatrixType::ColumnVector;
 	}
 	
-	matrix = new double[rows*cols];
-	assert(matrix && data);	// check if memory was allocated.
-	
-	memcpy(matrix, data, rows*cols*sizeof(double));
+	assert(data);
+	matrix = AllocateElements(rows*cols);
+	memcpy(matrix, data, rows*cols*sizeof(T));
+}
+
+// constructs a matrix by copying the elements of a view.
+template<typename T>
+MatrixT<T>::MatrixT(const ConstMatrixViewT<T>& B)
+	: MatrixT(B.Rows(), B.Cols(), MatrixType::Null)
+{
+	View() = B;
 }
 
 // copy constructor.
-Matrix::Matrix(const Matrix& B)
+template<typename T>
+MatrixT<T>::MatrixT(const MatrixT& B)
 {
 	rows    = 0;
 	cols    = 0;
@@ -139,13 +270,95 @@ Matrix::Matrix(const Matrix& B)
 	*this = B;
 }
 
+// move constructor, takes the elements of B and leaves B as a null matrix.
+// inline elements are copied.
+template<typename T>
+MatrixT<T>::MatrixT(MatrixT&& B)
+{
+	rows    = B.rows;
+	cols    = B.cols;
+	matType = B.matType;
+	matrix  = B.matrix;
+	
+	if(B.IsInline())
+	{
+		memcpy(mInline, B.mInline, rows*cols*sizeof(T));
+		matrix = mInline;
+	}
+	
+	B.rows    = 0;
+	B.cols    = 0;
+	B.matType = MatrixType::Null;
+	B.matrix  = nullptr;
+}
+
 // destructor.
-Matrix::~Matrix()
+template<typename T>
+MatrixT<T>::~MatrixT()
+{
+	FreeElements();
+}
+
+// exchange the contents of two matrices, the inline elements are exchanged
+// by copying them.
+template<typename T>
+void MatrixT<T>::Swap(MatrixT& B)
+{
+	const bool _inline  = IsInline();
+	const bool _inlineB = B.IsInline();
+	if(_inline || _inlineB)
+	{
+		std::swap(mInline, B.mInline);
+	}
+	
+	std::swap(rows   , B.rows);
+	std::swap(cols   , B.cols);
+	std::swap(matType, B.matType);
+	std::swap(matrix , B.matrix);
+	
+	if(_inline)
+	{
+		B.matrix = B.mInline;
+	}
+	if(_inlineB)
+	{
+		matrix = mInline;
+	}
+}
+
+// storage of count elements, the inline array of the matrix if they fit and
+// otherwise an array from the current allocator of the thread, see
+// MatrixAllocator.h.
+template<typename T>
+T* MatrixT<T>::AllocateElements(size_t count)
+{
+	if(count <= gcMatrixInlineElements)
+	{
+		return mInline;
+	}
+	++gAllocationCount;
+	T* _elements = static_cast<T*>(glAllocateMatrixElements(count*sizeof(T)));
+	assert(_elements);
+	return _elements;
+}
+
+// release the elements of the matrix, an allocated array is returned to the
+// allocator which allocated it.
+template<typename T>
+void MatrixT<T>::FreeElements()
 {
-	if(matrix)
+	if(matrix && !IsInline())
 	{
-		delete[] matrix;
+		glFreeMatrixElements(matrix);
 	}
+	matrix = nullptr;
+}
+
+// number of element arrays allocated so far.
+template<typename T>
+size_t MatrixT<T>::GetAllocationCount()
+{
+	return gAllocationCount;
 }
 // ------------------------------------------------------------------------- //
 
@@ -156,33 +369,53 @@ Matrix::~Matrix()
 // ------------------------------------------------------------------------- //
 
 // assignment operator.
-Matrix& Matrix::operator =(const Matrix& B)
+template<typename T>
+MatrixT<T>& MatrixT<T>::operator =(const MatrixT& B)
 {
+	if(this == &B)
+	{
+		return *this;
+	}
+	
 	if((B.rows == 0 && B.cols == 0) || B.matrix == nullptr)
 	{
-		rows   = 0;
-		cols   = 0;
-		matrix = nullptr;
+		FreeElements();
+		rows    = 0;
+		cols    = 0;
+		matType = MatrixType::Null;
 		return *this;
 	}
 	
+	// reuse the existing array if it has the right size.
+	if(matrix == nullptr || rows*cols != B.rows*B.cols)
+	{
+		FreeElements();
+		matrix = AllocateElements(B.rows*B.cols);
+	}
+	
 	rows    = B.rows;
 	cols    = B.cols;
 	matType = B.matType;
 	
-	if(this->matrix)
+	memcpy(this->matrix, B.matrix, rows*cols*sizeof(T));
+	return *this;
+}
+
+// move assignment operator.
+template<typename T>
+MatrixT<T>& MatrixT<T>::operator =(MatrixT&& B)
+{
+	if(this != &B)
 	{
-		delete[]this->matrix;
+		MatrixT _temp(std::move(B));
+		Swap(_temp);
 	}
-	this->matrix = new double[rows*cols];
-	assert(this->matrix);
-	
-	memcpy(this->matrix, B.matrix, rows*cols*sizeof(double));
 	return *this;
 }
 
 // indexing operator.
-double& Matrix::operator ()(size_t r, size_t c) const
+template<typename T>
+T& MatrixT<T>::operator ()(size_t r, size_t c) const
 {
 	assert(r>=0 && r<rows && c>=0 && c<cols);
 	assert(matrix);
@@ -191,7 +424,8 @@ double& Matrix::operator ()(size_t r, size_t c) const
 }
 
 // indexing operator
-double& Matrix::operator [](size_t index) const
+template<typename T>
+T& MatrixT<T>::operator [](size_t index) const
 {
 	assert(index>=0 && index<rows*cols);
 	assert(matrix != nullptr);
@@ -200,11 +434,12 @@ double& Matrix::operator [](size_t index) const
 }
 
 // sub-matrix indexing operator.
-Matrix Matrix::operator ()(size_t r1, size_t c1, size_t r2, size_t c2) const
+template<typename T>
+MatrixT<T> MatrixT<T>::operator ()(size_t r1, size_t c1, size_t r2, size_t c2) const
 {
 	assert(r1>=0 && r2<rows && c1>=0 && c1<cols);
 	
-	Matrix submatrix;
+	MatrixT submatrix;
 	submatrix.rows = r2 - r1 + 1;
 	submatrix.cols = c2 - c1 + 1;
 	
@@ -221,8 +456,7 @@ Matrix Matrix::operator ()(size_t r1, size_t c1, size_t r2, size_t c2) const
 		submatrix.matType = MatrixType::ColumnVector;
 	}
 	
-	submatrix.matrix = new double[submatrix.rows*submatrix.cols];
-	assert(submatrix.matrix);
+	submatrix.matrix = submatrix.AllocateElements(submatrix.rows*submatrix.cols);
 	
 	size_t x = 0, y = 0;
 	for(size_t i=r1 ; i<=r2 ; i++)
@@ -246,172 +480,239 @@ Matrix Matrix::operator ()(size_t r1, size_t c1, size_t r2, size_t c2) const
 // arithmetic operators.
 // ------------------------------------------------------------------------- //
 // addition operator.
-Matrix Matrix::operator +(const Matrix& B) const
+template<typename T>
+MatrixT<T> MatrixT<T>::operator +(const MatrixT& B) const &
 {
 	assert(rows==B.rows && cols==B.cols);
 	assert(matrix && B.matrix);
 	
-	Matrix temp(rows,cols);
-	for (size_t i = 0; i < rows; i++)
+	MatrixT temp(rows,cols);
+	glParallelFor(0, rows, RowGrain(cols), [&](size_t r1, size_t r2)
 	{
-		for (size_t j = 0; j < cols; j++)
+		for (size_t i = r1; i < r2; i++)
 		{
-			temp.matrix[i * cols + j] = matrix[i * cols + j] + B.matrix[i * cols + j];
+			for (size_t j = 0; j < cols; j++)
+			{
+				temp.matrix[i * cols + j] = matrix[i * cols + j] + B.matrix[i * cols + j];
+			}
 		}
-	}
+	});
 	return temp;
 }
 
+// addition operator, adds B to the temporary and returns it.
+template<typename T>
+MatrixT<T> MatrixT<T>::operator +(const MatrixT& B) &&
+{
+	*this += B;
+	return std::move(*this);
+}
+
 // addition operator.
-Matrix& Matrix::operator +=(const Matrix& B)
+template<typename T>
+MatrixT<T>& MatrixT<T>::operator +=(const MatrixT& B)
 {
 	assert(rows==B.rows && cols==B.cols);
 	assert(matrix && B.matrix);
 	
-	for (size_t i = 0; i < rows; i++)
+	glParallelFor(0, rows, RowGrain(cols), [&](size_t r1, size_t r2)
 	{
-		for (size_t j = 0; j < cols; j++)
+		for (size_t i = r1; i < r2; i++)
 		{
-			matrix[i * cols + j] = matrix[i * cols + j] + B.matrix[i * cols + j];
+			for (size_t j = 0; j < cols; j++)
+			{
+				matrix[i * cols + j] = matrix[i * cols + j] + B.matrix[i * cols + j];
+			}
 		}
-	}
+	});
 	
 	return *this;
 }
 
+// addition operator for a view, which can overlap the matrix only if it
+// refers to exactly the same elements.
+template<typename T>
+MatrixT<T>& MatrixT<T>::operator +=(const ConstMatrixViewT<T>& B)
+{
+	View() += B;
+	return *this;
+}
+
 // subtraction operator
-Matrix Matrix::operator -(const Matrix& B) const
+template<typename T>
+MatrixT<T> MatrixT<T>::operator -(const MatrixT& B) const &
 {
 	assert(rows==B.rows && cols==B.cols);
 	assert(matrix && B.matrix);
 	
-	Matrix temp(rows,cols);
-	for (size_t i = 0; i < rows; i++)
+	MatrixT temp(rows,cols);
+	glParallelFor(0, rows, RowGrain(cols), [&](size_t r1, size_t r2)
 	{
-		for (size_t j = 0; j < cols; j++)
+		for (size_t i = r1; i < r2; i++)
 		{
-			temp.matrix[i * cols + j] = this->matrix[i * cols + j] - B.matrix[i * cols + j];
+			for (size_t j = 0; j < cols; j++)
+			{
+				temp.matrix[i * cols + j] = this->matrix[i * cols + j] - B.matrix[i * cols + j];
+			}
 		}
-	}
+	});
 	return temp;
 }
 
+// subtraction operator, subtracts B from the temporary and returns it.
+template<typename T>
+MatrixT<T> MatrixT<T>::operator -(const MatrixT& B) &&
+{
+	*this -= B;
+	return std::move(*this);
+}
+
 // subtraction operator.
-Matrix& Matrix::operator -=(const Matrix& B)
+template<typename T>
+MatrixT<T>& MatrixT<T>::operator -=(const MatrixT& B)
 {
 	assert(rows==B.rows && cols==B.cols);
 	assert(matrix && B.matrix);
 	
-	for (size_t i = 0; i < rows; i++)
+	glParallelFor(0, rows, RowGrain(cols), [&](size_t r1, size_t r2)
 	{
-		for (size_t j = 0; j < cols; j++)
+		for (size_t i = r1; i < r2; i++)
 		{
-			matrix[i * cols + j] = this->matrix[i * cols + j] - B.matrix[i * cols + j];
+			for (size_t j = 0; j < cols; j++)
+			{
+				matrix[i * cols + j] = this->matrix[i * cols + j] - B.matrix[i * cols + j];
+			}
 		}
-	}
+	});
 	
 	return *this;
 }
 
+// subtraction operator for a view.
+template<typename T>
+MatrixT<T>& MatrixT<T>::operator -=(const ConstMatrixViewT<T>& B)
+{
+	View() -= B;
+	return *this;
+}
+
 // scalar multiplication.
-Matrix Matrix::operator *(double s) const
+template<typename T>
+MatrixT<T> MatrixT<T>::operator *(T s) const &
 {
 	assert(matrix);
 	
-	Matrix temp(rows, cols);
-	for (size_t i = 0; i < rows; i++)
+	MatrixT temp(rows, cols);
+	glParallelFor(0, rows, RowGrain(cols), [&](size_t r1, size_t r2)
 	{
-		for (size_t j = 0; j < cols; j++)
+		for (size_t i = r1; i < r2; i++)
 		{
-			temp.matrix[i * cols + j] = this->matrix[i * cols + j] * s;
+			for (size_t j = 0; j < cols; j++)
+			{
+				temp.matrix[i * cols + j] = this->matrix[i * cols + j] * s;
+			}
 		}
-	}
+	});
 	return temp;
 }
 
+// scalar multiplication, scales the temporary and returns it.
+template<typename T>
+MatrixT<T> MatrixT<T>::operator *(T s) &&
+{
+	*this *= s;
+	return std::move(*this);
+}
+
 // scalar multiplication.
-Matrix& Matrix::operator *=(double s)
+template<typename T>
+MatrixT<T>& MatrixT<T>::operator *=(T s)
 {
 	assert(matrix);
 	
-	for (size_t i = 0; i < rows; i++)
+	glParallelFor(0, rows, RowGrain(cols), [&](size_t r1, size_t r2)
 	{
-		for (size_t j = 0; j < cols; j++)
+		for (size_t i = r1; i < r2; i++)
 		{
-			matrix[i * cols + j] = this->matrix[i * cols + j] * s;
+			for (size_t j = 0; j < cols; j++)
+			{
+				matrix[i * cols + j] = this->matrix[i * cols + j] * s;
+			}
 		}
-	}
+	});
 	
 	return *this;
 }
 
 // scalar division.
-Matrix Matrix::operator /(double s) const
+template<typename T>
+MatrixT<T> MatrixT<T>::operator /(T s) const &
 {
 	assert(matrix);
 	
-	Matrix temp(rows, cols);
-	for (size_t i = 0; i < rows; i++)
+	MatrixT temp(rows, cols);
+	glParallelFor(0, rows, RowGrain(cols), [&](size_t r1, size_t r2)
 	{
-		for (size_t j = 0; j < cols; j++)
+		for (size_t i = r1; i < r2; i++)
 		{
-			temp.matrix[i * cols + j] = this->matrix[i * cols + j] / s;
+			for (size_t j = 0; j < cols; j++)
+			{
+				temp.matrix[i * cols + j] = this->matrix[i * cols + j] / s;
+			}
 		}
-	}
+	});
 
 	return temp;
 }
 
-Matrix& Matrix::operator /=(double s)
+// scalar division, scales the temporary and returns it.
+template<typename T>
+MatrixT<T> MatrixT<T>::operator /(T s) &&
+{
+	*this /= s;
+	return std::move(*this);
+}
+
+template<typename T>
+MatrixT<T>& MatrixT<T>::operator /=(T s)
 {
 	assert(matrix);
 	
-	for (size_t i = 0; i < rows; i++)
+	glParallelFor(0, rows, RowGrain(cols), [&](size_t r1, size_t r2)
 	{
-		for (size_t j = 0; j < cols; j++)
+		for (size_t i = r1; i < r2; i++)
 		{
-			matrix[i * cols + j] = this->matrix[i * cols + j] / s;
+			for (size_t j = 0; j < cols; j++)
+			{
+				matrix[i * cols + j] = this->matrix[i * cols + j] / s;
+			}
 		}
-	}
+	});
 	
 	return *this;
 }
 
 // matrix multiplication.
-Matrix Matrix::operator *(const Matrix& B) const
+template<typename T>
+MatrixT<T> MatrixT<T>::operator *(const MatrixT& B) const
 {
 	assert(cols == B.rows);
 	
-	Matrix temp(rows, B.cols, MatrixType::Zero);
-	for(size_t i=0 ; i<rows ; i++)
-	{
-		for (size_t j = 0; j < B.cols; j++)
-		{
-			for (size_t l = 0; l < cols; l++)
-			{
-				temp(i, j) = temp(i, j) + matrix[i * cols + l] * B.matrix[l * (B.cols) + j];
-			}
-		}
-	}
+	MatrixT temp(rows, B.cols, MatrixType::Zero);
+	Product(rows, B.cols, cols, matrix, B.matrix, temp.matrix);
 	
 	return temp;
 }
 
-Matrix& Matrix::operator *=(const Matrix& B)
+template<typename T>
+MatrixT<T>& MatrixT<T>::operator *=(const MatrixT& B)
 {
 	assert(cols == B.rows);
 	
-	Matrix temp(rows, B.cols);
-	for(size_t i=0 ; i<rows ; i++)
-	{
-		for(size_t j=0 ; j<B.cols ; j++)
-			for(size_t l=0 ; l<cols ; l++)
-			{
-				temp(i,j) = temp(i,j)+matrix[i*cols+l]*B.matrix[l*(B.cols)+j];
-			}
-	}
+	MatrixT temp(rows, B.cols);
+	Product(rows, B.cols, cols, matrix, B.matrix, temp.matrix);
 	
-	*this = temp;
+	Swap(temp);
 	return *this;
 }
 // ------------------------------------------------------------------------- //
@@ -423,7 +724,8 @@ Matrix& Matrix::operator *=(const Matrix& B)
 // ------------------------------------------------------------------------- //
 
 // check if two vectors are equal.
-bool Matrix::operator ==(const Matrix& B) const
+template<typename T>
+bool MatrixT<T>::operator ==(const MatrixT& B) const
 {
 	assert(B.matrix && B.rows>=0 && B.cols>=0);
 	assert(rows==B.rows && cols==B.cols);
@@ -440,7 +742,8 @@ bool Matrix::operator ==(const Matrix& B) const
 }
 
 // check if two vectors are not equal.
-bool Matrix::operator !=(const Matrix& B) const
+template<typename T>
+bool MatrixT<T>::operator !=(const MatrixT& B) const
 {
 	assert(B.matrix && B.rows>=0 && B.cols>=0);
 	assert(rows==B.rows && cols==B.cols);
@@ -457,7 +760,8 @@ bool Matrix::operator !=(const Matrix& B) const
 }
 
 // check equivalence of two matrices.
-bool Matrix::IsEqual(const Matrix& B, double tolerance) const
+template<typename T>
+bool MatrixT<T>::IsEqual(const MatrixT& B, double tolerance) const
 {
 	assert(B.matrix && B.rows>=0 && B.cols>=0);
 	assert(rows==B.rows && cols==B.cols);
@@ -474,7 +778,8 @@ bool Matrix::IsEqual(const Matrix& B, double tolerance) const
 }
 
 // check equivalence of two matrices.
-bool Matrix::IsNotEqual(const Matrix& B, double tolerance)	const
+template<typename T>
+bool MatrixT<T>::IsNotEqual(const MatrixT& B, double tolerance)	const
 {
 	return !this->IsEqual(B, tolerance);
 }
@@ -487,103 +792,124 @@ bool Matrix::IsNotEqual(const Matrix& B, double tolerance)	const
 // ------------------------------------------------------------------------- //
 
 // set submatrix of a matrix.
-void Matrix::SetSubMatrix(size_t r1, size_t c1, size_t r2, size_t c2, const Matrix &B)
+template<typename T>
+void MatrixT<T>::SetSubMatrix(size_t r1, size_t c1, size_t r2, size_t c2, const ConstMatrixViewT<T> &B)
 {
 	assert(r1>=0 && r2<rows && c1>=0 && c2<cols);
 	
-	size_t x = 0, y = 0;
-	for(size_t i=r1 ; i<=r2 ; i++)
-	{
-		y = 0;
-		for(size_t j=c1 ; j<=c2 ; j++)
-		{
-			matrix[i*cols+j] = B.matrix[x*B.cols+y];
-			y++;
-		}
-		x++;
-	}
+	Block(r1, c1, r2, c2) = B;
 }
 
 // set a row of the matrix.
-void Matrix::SetRow(size_t r, const Matrix &B)
+template<typename T>
+void MatrixT<T>::SetRow(size_t r, const ConstMatrixViewT<T> &B)
 {
 	assert(r>=0 && r<rows);
+	assert(B.Rows()*B.Cols() == cols);
 	
-	for (size_t j = 0; j <= cols; j++)
+	// B can be a row or a column vector.
+	MatrixViewT<T> _row = Row(r);
+	if(B.Rows() == 1)
+	{
+		_row = B;
+	}
+	else
 	{
-		matrix[r * cols + j] = B.matrix[j];
+		_row = B.Transpose();
 	}
 }
 
 // set a col of the matrix.
-void Matrix::SetCol(size_t c, const Matrix &B)
+template<typename T>
+void MatrixT<T>::SetCol(size_t c, const ConstMatrixViewT<T> &B)
 {
 	assert(c>=0 && c<cols);
+	assert(B.Rows()*B.Cols() == rows);
 	
-	for (size_t i = 0; i <= rows; i++)
+	// B can be a row or a column vector.
+	MatrixViewT<T> _col = Col(c);
+	if(B.Cols() == 1)
 	{
-		matrix[i * cols + c] = B.matrix[i];
+		_col = B;
+	}
+	else
+	{
+		_col = B.Transpose();
 	}
 }
 
 // Transpose of a matrix
-Matrix Matrix::Transpose() const
+template<typename T>
+MatrixT<T> MatrixT<T>::Transpose() const &
 {
 	assert(matrix);
 	
-	Matrix temp(cols,rows);
-	for (size_t i = 0; i < rows; i++)
-	{
-		for (size_t j = 0; j < cols; j++)
-		{
-			temp.matrix[j * rows + i] = this->matrix[i * cols + j];
-		}
-	}
+	MatrixT temp(cols,rows);
+	glTranspose(rows, cols, matrix, cols, temp.matrix, rows);
 	return temp;
 }
 
-// average elements in a row and return average vector.
-Matrix Matrix::AvgRows() const
+// Transpose of a temporary matrix, reuses its storage when possible.
+template<typename T>
+MatrixT<T> MatrixT<T>::Transpose() &&
 {
-	Matrix avg(rows, 1);
+	assert(matrix);
 	
-	for(size_t i=0 ; i<rows ; i++)
+	// a row vector and a column vector store their elements in the same order.
+	if(rows == 1 || cols == 1)
 	{
-		for(size_t j=0 ; j<cols ; j++)
+		std::swap(rows, cols);
+		if(matType == MatrixType::RowVector)
 		{
-			avg(i, 0) = avg(i, 0) + matrix[i*cols+j];
+			matType = MatrixType::ColumnVector;
 		}
-		avg(i, 0) = avg(i, 0) / cols;
+		else if(matType == MatrixType::ColumnVector)
+		{
+			matType = MatrixType::RowVector;
+		}
+		return std::move(*this);
 	}
 	
-	return avg;
+	// a square matrix is transposed in place. A rectangular one is copied since
+	// following the cycles of the permutation is much slower than a blocked
+	// copy, use TransposeInPlace() to avoid the second buffer.
+	if(rows == cols)
+	{
+		glTransposeInPlace(rows, cols, matrix);
+		return std::move(*this);
+	}
+	
+	return static_cast<const MatrixT&>(*this).Transpose();
 }
 
-// compute 2-norm of the vector.
-double Matrix::VectorNorm()
+// Transpose a matrix without allocating a second matrix.
+template<typename T>
+void MatrixT<T>::TransposeInPlace()
 {
-	// must be a vector.
-	if (rows != 1 && cols != 1)
-	{
-		return -1;
-	}
+	assert(matrix);
 	
-	if (rows == 1 && cols == 1)
+	glTransposeInPlace(rows, cols, matrix);
+	std::swap(rows, cols);
+	if(matType == MatrixType::RowVector)
 	{
-		return matrix[0];
+		matType = MatrixType::ColumnVector;
 	}
-	
-	double norm = 0;
-	for (size_t i = 0; i < rows + cols - 1; i++)
+	else if(matType == MatrixType::ColumnVector)
 	{
-		norm += matrix[i] * matrix[i];
+		matType = MatrixType::RowVector;
 	}
-	
-	return sqrt(norm);
 }
 
-// compute square of 2-norm of the vector.
-double Matrix::VectorNorm2()
+// average elements in a row and return average vector.
+template<typename T>
+MatrixT<T> MatrixT<T>::AvgRows() const
+{
+	return glReduce(View(), ReduceKind::Mean, ReduceAxis::Rows);
+}
+
+// compute 2-norm of the vector.
+template<typename T>
+T MatrixT<T>::VectorNorm()
 {
 	// must be a vector.
 	if (rows != 1 && cols != 1)
@@ -591,24 +917,27 @@ double Matrix::VectorNorm2()
 		return -1;
 	}
 	
-	if (rows == 1 && cols == 1)
-	{
-		return matrix[0];
-	}
-	
-	double norm = 0;
-	for (size_t i = 0; i < rows + cols - 1; i++)
+	return glReduceAll(View(), ReduceKind::Norm2);
+}
+
+// compute square of 2-norm of the vector.
+template<typename T>
+T MatrixT<T>::VectorNorm2()
+{
+	// must be a vector.
+	if (rows != 1 && cols != 1)
 	{
-		norm += matrix[i] * matrix[i];
+		return -1;
 	}
 	
-	return norm;
+	return glReduceAll(View(), ReduceKind::SumSquares);
 }
 
-Matrix Matrix::Diagonal() const
+template<typename T>
+MatrixT<T> MatrixT<T>::Diagonal() const
 {
 	assert(rows == cols);
-	Matrix _diagonal(rows, 1);
+	MatrixT _diagonal(rows, 1);
 	for(size_t i=0 ; i<rows ; ++i)
 	{
 		_diagonal.matrix[i] = matrix[i*cols+i];
@@ -617,140 +946,415 @@ Matrix Matrix::Diagonal() const
 }
 
 // Find Inverse of a square matrix.
-Matrix Matrix::Inverse() const
+template<typename T>
+MatrixT<T> MatrixT<T>::Inverse() const
 {
-	assert(rows>0 && cols>0 && rows==cols);
-	
-	double* _buffer = new double[rows * cols];
-	memcpy(_buffer, matrix, rows * cols * sizeof(double));
-
-	typedef  Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> MatrixXd;
-	Eigen::Map<MatrixXd> _map(_buffer, rows, cols);
-	_map = _map.inverse();
-
-	Matrix _inverse(rows, cols);
-	_inverse.matrix = _buffer;
-	return _inverse;
+	return View().Inverse();
 }
 
 // finds SVD of a matrix.
-Matrix Matrix::Svd(Matrix* S, Matrix* V) const
+template<typename T>
+MatrixT<T> MatrixT<T>::Svd(MatrixT* S, MatrixT* V, SvdMode mode) const
 {
-	typedef  Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> MatrixXd;
-	Eigen::Map<MatrixXd> _map(matrix, rows, cols);
-
-	Eigen::BDCSVD<MatrixXd> _results = _map.bdcSvd(Eigen::ComputeFullU | Eigen::ComputeFullV);
-	const Eigen::MatrixXd&     _U       = _results.matrixU();
-	const Eigen::VectorXd&     _S       = _results.singularValues();
-	const Eigen::MatrixXd&     _V       = _results.matrixV();
+	return View().Svd(S, V, mode);
+}
 
-	Matrix U(size_t(_U.rows()), size_t(_U.cols()), _U.data());
-	*S = Matrix(size_t(_S.rows()), size_t(_S.cols()), _S.data());
-	*V = Matrix(size_t(_V.rows()), size_t(_V.cols()), _V.data());
-	return U;
+// finds the eigen decomposition of a symmetric matrix.
+template<typename T>
+MatrixT<T> MatrixT<T>::EigenSymmetric(MatrixT* values, bool computeVectors) const
+{
+	return View().EigenSymmetric(values, computeVectors);
 }
 
 // return Determinant of matrix.
-double Matrix::Determinant() const
+template<typename T>
+T MatrixT<T>::Determinant() const
 {
-	typedef  Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> MatrixXd;
-	Eigen::Map<MatrixXd> _map(matrix, rows, cols);
-	return _map.determinant();
+	return View().Determinant();
 }
 // ------------------------------------------------------------------------- //
 
 
 // ------------------------------------------------------------------------- //
-Matrix Matrix::SolveAxB(const Matrix& A, const Matrix& B)
+template<typename T>
+MatrixT<T> MatrixT<T>::SolveAxB(const ConstMatrixViewT<T>& A, const ConstMatrixViewT<T>& B)
 {
-	typedef  Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> MatrixXd;
-	Eigen::Map<MatrixXd> _A(A.matrix, A.rows, A.cols);
-	Eigen::Map<MatrixXd> _B(B.matrix, B.rows, B.cols);
+	// the solution is written directly into the row-major result, copying the
+	// column-major storage of a solved Eigen matrix would transpose it.
+	return MatrixT(A.AsEigen().partialPivLu().solve(B.AsEigen()));
+}
 
-	const Eigen::MatrixXd& _X = _A.partialPivLu().solve(_B);
+template<typename T>
+MatrixT<T> MatrixT<T>::SolveTriangular(const ConstMatrixViewT<T>& A, const ConstMatrixViewT<T>& B, GemmTriangle uplo,
+                                       GemmOp op, bool unitDiagonal)
+{
+	if(A.Rows() != A.Cols() || A.Rows() != B.Rows())
+	{
+		char _msg[] = "A must be square with as many rows as B in Matrix::SolveTriangular";
+		throw SUtils::Exceptions::InvalidArgumentException(_msg);
+	}
+	MatrixT _X(B);
+	SMathLib::SolveTriangular(A, uplo, op, unitDiagonal, _X);
+	return _X;
+}
 
-	//const Eigen::MatrixXd& _X = _A.jacobiSvd(Eigen::ComputeThinU | Eigen::ComputeThinV).solve(_B);
-	return Matrix(size_t(_X.rows()), size_t(_X.cols()), _X.data());
+template<typename T>
+MatrixT<T> MatrixT<T>::Gram(const ConstMatrixViewT<T>& A)
+{
+	const size_t _n = A.Cols();
+	MatrixT _C(_n, _n, MatrixType::Null);
+	GramLower(A, _C);
+	for(size_t i=0 ; i<_n ; ++i)
+	{
+		for(size_t j=i+1 ; j<_n ; ++j)
+		{
+			_C.matrix[i*_n+j] = _C.matrix[j*_n+i];
+		}
+	}
+	return _C;
 }
-// ------------------------------------------------------------------------- //
 
+// bandwidths of the square matrix A: the largest distance of a non-zero element
+// below (lower) and above (upper) the diagonal.
+template<typename T>
+static void Bandwidths(const ConstMatrixViewT<T>& A, size_t& lower, size_t& upper)
+{
+	const size_t _n = A.Rows();
+	lower = upper = 0;
+	for(size_t i=0 ; i<_n ; ++i)
+	{
+		// only the elements outside the band found so far need to be checked.
+		for(size_t j=0 ; j+lower<i ; ++j)
+		{
+			if(A(i, j) != T(0))
+			{
+				lower = i - j;
+				break;
+			}
+		}
+		for(size_t j=_n-1 ; j>i+upper ; --j)
+		{
+			if(A(i, j) != T(0))
+			{
+				upper = j - i;
+				break;
+			}
+		}
+	}
+}
 
-// ------------------------------------------------------------------------- //
-// for standard IO.
-std::ostream& operator <<(std::ostream& out, const Matrix &B)
+// check if A is symmetric with a positive diagonal, a necessary condition for
+// positive definiteness. Only the band of A needs to be compared.
+template<typename T>
+static bool IsSymmetricPositiveDiagonal(const ConstMatrixViewT<T>& A, size_t bandwidth)
 {
-	if ((B.rows == 0 && B.cols == 0) || B.matrix == nullptr)
+	const size_t _n = A.Rows();
+	for(size_t i=0 ; i<_n ; ++i)
 	{
-		out << "Null Matrix";
+		if(!(A(i, i) > T(0)))
+		{
+			return false;
+		}
+		const size_t _last = std::min(_n-1, i+bandwidth);
+		for(size_t j=i+1 ; j<=_last ; ++j)
+		{
+			if(A(i, j) != A(j, i))
+			{
+				return false;
+			}
+		}
 	}
-	
-	out << B.rows << " " << B.cols;
-	for(size_t i=0 ; i<B.rows ; i++)
+	return true;
+}
+
+// solve A*X = B in place of X, which holds B, by banded LU of A with lower
+// bandwidth kl and upper bandwidth ku, see glSolveBandedLU().
+template<typename T>
+static bool SolveBanded(const ConstMatrixViewT<T>& A, size_t kl, size_t ku, MatrixT<T>& X)
+{
+	const size_t _n  = A.Rows();
+	const size_t _ld = 2*kl + ku + 1;
+	std::vector<T> _band(_n*_ld, T(0));
+	for(size_t i=0 ; i<_n ; ++i)
 	{
-		out << std::endl;
-		
-		for (size_t j = 0; j < B.cols; j++)
+		const size_t _first = i > kl ? i-kl : 0;
+		const size_t _last  = std::min(_n-1, i+ku);
+		for(size_t j=_first ; j<=_last ; ++j)
 		{
-			out << B(i, j) << " ";
+			_band[i*_ld + j+kl-i] = A(i, j);
 		}
 	}
-	return out;
+	return glSolveBandedLU(_n, kl, ku, _band.data(), X.matrix, X.cols);
 }
 
-std::istream& operator >>(std::istream& in, Matrix &B)
+template<typename T>
+MatrixT<T> MatrixT<T>::SolveAxB(const ConstMatrixViewT<T>& A, const ConstMatrixViewT<T>& B, SolveMode mode,
+                                SolvePath* path)
 {
-//	assert(B.rows!=0 && B.cols!=0 && B.matrix!=NULL);
+	if(A.Rows() != A.Cols() || A.Rows() != B.Rows())
+	{
+		char _msg[] = "A must be square with as many rows as B in Matrix::SolveAxB";
+		throw SUtils::Exceptions::InvalidArgumentException(_msg);
+	}
 	
-	size_t r, c;
-	in >> r >> c;
-	B = Matrix(r, c);
+	SolvePath _path = SolvePath::LU;
+	MatrixT   _X;
+	if(mode == SolveMode::Auto && A.Rows() > 0)
+	{
+		const size_t _n = A.Rows();
+		size_t _kl, _ku;
+		Bandwidths(A, _kl, _ku);
+		if(_kl == 0 && _ku == 0)
+		{
+			_path = SolvePath::Diagonal;
+			_X    = MatrixT(A.AsEigen().diagonal().asDiagonal().inverse() * B.AsEigen());
+		}
+		else if(_kl == 0)
+		{
+			_path = SolvePath::UpperTriangular;
+			_X    = MatrixT(A.AsEigen().template triangularView<Eigen::Upper>().solve(B.AsEigen()));
+		}
+		else if(_ku == 0)
+		{
+			_path = SolvePath::LowerTriangular;
+			_X    = MatrixT(A.AsEigen().template triangularView<Eigen::Lower>().solve(B.AsEigen()));
+		}
+		else if((_kl + _ku + 1) * gcBandedSolveRatio <= _n)
+		{
+			// a zero pivot falls back to LU, like a singular general matrix.
+			_X = MatrixT(B);
+			if(SolveBanded(A, _kl, _ku, _X))
+			{
+				_path = SolvePath::Banded;
+			}
+		}
+		else if(_kl == _ku && IsSymmetricPositiveDiagonal(A, _kl))
+		{
+			// only a failed factorization tells if A is positive definite.
+			typedef Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> ColMajor;
+			Eigen::LLT<ColMajor> _llt(A.AsEigen());
+			if(_llt.info() == Eigen::Success)
+			{
+				_path = SolvePath::Cholesky;
+				_X    = MatrixT(_llt.solve(B.AsEigen()));
+			}
+		}
+	}
+	if(_path == SolvePath::LU)
+	{
+		_X = SolveAxB(A, B);
+	}
 	
-	for (size_t i = 0; i < B.rows; i++)
+	if(path)
+	{
+		*path = _path;
+	}
+	return _X;
+}
+
+// least squares solution by Householder QR of the column-major copy of A.
+// HouseholderQR applies the reflections in blocks for large matrices.
+template<typename T, typename MatA, typename MatB>
+static MatrixT<T> LeastSquares(const MatA& A, const MatB& B, LeastSquaresMethod method, size_t* rank)
+{
+	typedef Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> ColMajor;
+	if(method == LeastSquaresMethod::ColPivQR)
 	{
-		for (size_t j = 0; j < B.cols; j++)
+		Eigen::ColPivHouseholderQR<ColMajor> _qr(A);
+		if(rank)
 		{
-			in >> B(i, j);
+			*rank = size_t(_qr.rank());
 		}
+		return MatrixT<T>(_qr.solve(B));
 	}
-	return in;
+	
+	Eigen::HouseholderQR<ColMajor> _qr(A);
+	if(rank)
+	{
+		*rank = size_t(A.cols());
+	}
+	return MatrixT<T>(_qr.solve(B));
 }
-// ------------------------------------------------------------------------- //
 
+template<typename T>
+static void CheckLeastSquares(const ConstMatrixViewT<T>& A, const ConstMatrixViewT<T>& B)
+{
+	if(A.Rows() != B.Rows())
+	{
+		char _msg[] = "A and B must have the same number of rows in Matrix::SolveLeastSquares";
+		throw SUtils::Exceptions::InvalidArgumentException(_msg);
+	}
+	if(A.Rows() < A.Cols())
+	{
+		char _msg[] = "A has more columns than rows in Matrix::SolveLeastSquares";
+		throw SUtils::Exceptions::InvalidArgumentException(_msg);
+	}
+}
 
-// ------------------------------------------------------------------------- //
-void Matrix::Write(std::ostream& out) const
+template<typename T>
+MatrixT<T> MatrixT<T>::SolveLeastSquares(const ConstMatrixViewT<T>& A, const ConstMatrixViewT<T>& B,
+                                         LeastSquaresMethod method, size_t* rank)
 {
-	if ((rows == 0 && cols == 0) || matrix == nullptr)
+	CheckLeastSquares(A, B);
+	return LeastSquares<T>(A.AsEigen(), B.AsEigen(), method, rank);
+}
+
+template<typename T>
+MatrixT<T> MatrixT<T>::SolveLeastSquares(const ConstMatrixViewT<T>& A, const ConstMatrixViewT<T>& B,
+                                         const ConstMatrixViewT<T>& weights, LeastSquaresMethod method, size_t* rank)
+{
+	CheckLeastSquares(A, B);
+	const size_t _m = A.Rows();
+	if(weights.Rows()*weights.Cols() != _m || (weights.Rows() != 1 && weights.Cols() != 1))
 	{
-		out << "Null Matrix";
+		char _msg[] = "weights must be a vector with one weight per row in Matrix::SolveLeastSquares";
+		throw SUtils::Exceptions::InvalidArgumentException(_msg);
 	}
 	
-	out << rows << " " << cols;
-	for(size_t i=0 ; i<rows ; i++)
+	// scaling the rows by the square roots of the weights turns the problem
+	// into an ordinary least squares problem.
+	typedef Eigen::Matrix<T, Eigen::Dynamic, 1> Vector;
+	Vector _s(_m);
+	for(size_t i=0 ; i<_m ; ++i)
 	{
-		out << std::endl;
-		
-		for (size_t j = 0; j < cols; j++)
+		const T _w = weights.Rows() == 1 ? weights(0, i) : weights(i, 0);
+		if(!(_w >= T(0)))
 		{
-			out << (*this)(i, j) << " ";
+			char _msg[] = "Negative weight in Matrix::SolveLeastSquares";
+			throw SUtils::Exceptions::InvalidArgumentException(_msg);
 		}
+		_s(Eigen::Index(i)) = std::sqrt(_w);
 	}
+	return LeastSquares<T>(_s.asDiagonal() * A.AsEigen(), _s.asDiagonal() * B.AsEigen(), method, rank);
+}
+// ------------------------------------------------------------------------- //
+
+
+// views.
+// ------------------------------------------------------------------------- //
+template<typename T>
+MatrixViewT<T> MatrixT<T>::View()
+{
+	return MatrixViewT<T>(*this);
+}
+
+template<typename T>
+ConstMatrixViewT<T> MatrixT<T>::View() const
+{
+	return ConstMatrixViewT<T>(*this);
+}
+
+template<typename T>
+MatrixViewT<T> MatrixT<T>::Row(size_t r)
+{
+	return View().Row(r);
+}
+
+template<typename T>
+ConstMatrixViewT<T> MatrixT<T>::Row(size_t r) const
+{
+	return View().Row(r);
+}
+
+template<typename T>
+MatrixViewT<T> MatrixT<T>::Col(size_t c)
+{
+	return View().Col(c);
+}
+
+template<typename T>
+ConstMatrixViewT<T> MatrixT<T>::Col(size_t c) const
+{
+	return View().Col(c);
+}
+
+template<typename T>
+MatrixViewT<T> MatrixT<T>::Block(size_t r1, size_t c1, size_t r2, size_t c2)
+{
+	return View().Block(r1, c1, r2, c2);
+}
+
+template<typename T>
+ConstMatrixViewT<T> MatrixT<T>::Block(size_t r1, size_t c1, size_t r2, size_t c2) const
+{
+	return View().Block(r1, c1, r2, c2);
+}
+// ------------------------------------------------------------------------- //
+
+
+// ------------------------------------------------------------------------- //
+// for standard IO.
+std::ostream& operator <<(std::ostream& out, const Matrix& B)
+{
+	B.Write(out);
+	return out;
+}
+
+std::ostream& operator <<(std::ostream& out, const MatrixF& B)
+{
+	B.Write(out);
+	return out;
+}
+
+std::istream& operator >>(std::istream& in, Matrix& B)
+{
+	B.Read(in);
+	return in;
+}
+
+std::istream& operator >>(std::istream& in, MatrixF& B)
+{
+	B.Read(in);
+	return in;
 }
+// ------------------------------------------------------------------------- //
 
-void Matrix::Read(std::istream& in)
+
+// ------------------------------------------------------------------------- //
+template<typename T>
+void MatrixT<T>::Write(std::ostream& out) const
+{
+	View().Write(out);
+}
+
+template<typename T>
+void MatrixT<T>::Read(std::istream& in)
 {
 	size_t r, c;
-	in >> r >> c;
-	*this = Matrix(r, c);
+	if(!(in >> r >> c))
+	{
+		char _msg[] = "Invalid matrix size in Matrix::Read";
+		throw SUtils::Exceptions::InvalidArgumentException(_msg);
+	}
+	*this = MatrixT(r, c, MatrixType::Null);
 	
-	for (size_t i = 0; i < rows; i++)
+	// the elements are parsed in blocks without going through the stream.
+	glReadNumbers(in, matrix, r*c);
+}
+// ------------------------------------------------------------------------- //
+
+
+// ------------------------------------------------------------------------- //
+const char* glSolvePathName(SolvePath path)
+{
+	switch(path)
 	{
-		for (size_t j = 0; j < cols; j++)
-		{
-			in >> (*this)(i, j);
-		}
+	case SolvePath::LU:              return "LU";
+	case SolvePath::Diagonal:        return "Diagonal";
+	case SolvePath::LowerTriangular: return "LowerTriangular";
+	case SolvePath::UpperTriangular: return "UpperTriangular";
+	case SolvePath::Banded:          return "Banded";
+	case SolvePath::Cholesky:        return "Cholesky";
 	}
+	return "Unknown";
 }
 // ------------------------------------------------------------------------- //
 
+
+// instantiations.
+// ------------------------------------------------------------------------- //
+template class SMATHLIB_DLL_API MatrixT<double>;
+template class SMATHLIB_DLL_API MatrixT<float>;
+// ------------------------------------------------------------------------- //
+
 };	// End namespace SMathLib.
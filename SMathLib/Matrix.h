@@ -8,6 +8,9 @@
 #define _SMATHLIB_MATRIX_H_
 
 #include "SMathLib/Config.h"
+#include "SMathLib/Gemm.h"
+#include "SMathLib/MatrixAllocator.h"
+#include "SMathLib/MatrixView.h"
 #include <iostream>
 
 namespace SMathLib {
@@ -26,13 +29,46 @@ enum class MatrixType
 	Identity     = 7
 };
 
+//! Factorization used by MatrixT::SolveLeastSquares().
+enum class LeastSquaresMethod
+{
+	QR,          ///< Blocked Householder QR, A must have full column rank.
+	ColPivQR     ///< Householder QR with column pivoting, reveals the rank of A.
+};
 
-class SMATHLIB_DLL_API Matrix
+//! Solver selection of MatrixT::SolveAxB().
+enum class SolveMode
+{
+	LU,          ///< Always LU with partial pivoting.
+	Auto         ///< Detect the structure of A and use the cheapest solver for it.
+};
+
+//! Solver used by MatrixT::SolveAxB(), see glSolvePathName().
+enum class SolvePath
+{
+	LU,                 ///< LU with partial pivoting, for general matrices.
+	Diagonal,           ///< Division by the diagonal.
+	LowerTriangular,    ///< Forward substitution.
+	UpperTriangular,    ///< Back substitution.
+	Banded,             ///< LU with partial pivoting restricted to the band of A.
+	Cholesky            ///< Cholesky factorization of a symmetric positive definite A.
+};
+
+
+//! Largest number of elements stored inside a matrix object instead of an
+//! allocated array.
+static const size_t gcMatrixInlineElements = 16;
+
+//! A dense matrix stored in row-major order. T is the type of the elements,
+//! the library is built with Matrix (double) and MatrixF (float). The element
+//! arrays are aligned to 64 bytes and come from the current allocator of the
+//! thread, see MatrixAllocator.h. Matrices of at most gcMatrixInlineElements
+//! elements, e.g. 3x3 and 4x4 matrices, store them in the object itself and
+//! allocate nothing; moving or swapping them copies the elements, so that
+//! pointers to their elements do not follow the move.
+template<typename T>
+class MatrixT
 {
-	// for standard IO.
-	SMATHLIB_DLL_API friend std::ostream& operator <<(std::ostream& out, const Matrix &B);
-	SMATHLIB_DLL_API friend std::istream& operator >>(std::istream& in , Matrix &B);
-	
 public:
 	
 	// IO functions.
@@ -40,64 +76,175 @@ public:
 	void Read(std::istream& in);
 	
 	// Functions.
-	double	Determinant() const;
-	Matrix  Svd(Matrix* sigma, Matrix* v) const;
-	Matrix  Inverse() const;
-	Matrix	Transpose() const;
-	Matrix  AvgRows() const;
-	void    SetSubMatrix(size_t r1, size_t c1, size_t r2, size_t c2, const Matrix &B);
-	void    SetRow(size_t r, const Matrix &B);
-	void    SetCol(size_t c, const Matrix &B);
-	double  VectorNorm();
-	double  VectorNorm2();
-	Matrix  Diagonal() const;
+	T       Determinant() const;
+	MatrixT Svd(MatrixT* sigma, MatrixT* v, SvdMode mode = SvdMode::Full) const;
+	MatrixT EigenSymmetric(MatrixT* values, bool computeVectors = true) const;
+	MatrixT Inverse() const;
+	MatrixT	Transpose() const &;
+	MatrixT	Transpose() &&;
+	void    TransposeInPlace();
+	MatrixT AvgRows() const;
+	void    SetSubMatrix(size_t r1, size_t c1, size_t r2, size_t c2, const ConstMatrixViewT<T> &B);
+	void    SetRow(size_t r, const ConstMatrixViewT<T> &B);
+	void    SetCol(size_t c, const ConstMatrixViewT<T> &B);
+	T       VectorNorm();
+	T       VectorNorm2();
+	MatrixT Diagonal() const;
 	
 	// Static functions.
-	static Matrix SolveAxB(const Matrix& A, const Matrix& b);
+	static MatrixT SolveAxB(const ConstMatrixViewT<T>& A, const ConstMatrixViewT<T>& b);
+	
+	//! Solve A*X = B for a square A. SolveMode::Auto first scans A, which
+	//! costs O(n^2), for its bandwidths and symmetry:
+	//!   - diagonal and triangular matrices are solved by substitution;
+	//!   - matrices whose bandwidths are small compared with n by banded LU;
+	//!   - symmetric matrices with a positive diagonal by Cholesky, if the
+	//!     factorization succeeds, that is if A is positive definite;
+	//!   - all the others, including symmetric indefinite matrices, by LU.
+	//! The solver used is stored in path if it is not nullptr.
+	static MatrixT SolveAxB(const ConstMatrixViewT<T>& A, const ConstMatrixViewT<T>& b, SolveMode mode,
+	                        SolvePath* path = nullptr);
+	
+	//! Solve op(A)*X = B for a triangular A, only the given triangle of A is
+	//! read, see glTrsm(). Transposed and strided views are solved in place.
+	static MatrixT SolveTriangular(const ConstMatrixViewT<T>& A, const ConstMatrixViewT<T>& B, GemmTriangle uplo,
+	                               GemmOp op = GemmOp::None, bool unitDiagonal = false);
+	
+	//! Gram matrix A^T*A, e.g. of the normal equations. Only one triangle is
+	//! computed, with glSyrk(), and is then mirrored. Use A.Transpose() for A*A^T.
+	static MatrixT Gram(const ConstMatrixViewT<T>& A);
+	
+	//! Least squares solution X minimizing ||A*X - B|| for a m x n matrix A
+	//! with m >= n, each column of B is solved independently. ColPivQR stores
+	//! the numerical rank of A in rank (if not nullptr); the solution of a rank
+	//! deficient A has zeros for the dependent columns. rank is set to n for QR.
+	//! For many small problems of the same shape see glBatchSolveLeastSquares().
+	static MatrixT SolveLeastSquares(const ConstMatrixViewT<T>& A, const ConstMatrixViewT<T>& B,
+	                                 LeastSquaresMethod method = LeastSquaresMethod::QR, size_t* rank = nullptr);
+	
+	//! Weighted least squares minimizing sum_i weights_i*||A_i*X - B_i||^2,
+	//! where A_i and B_i are the rows of A and B. weights is a vector of m
+	//! non-negative weights.
+	static MatrixT SolveLeastSquares(const ConstMatrixViewT<T>& A, const ConstMatrixViewT<T>& B,
+	                                 const ConstMatrixViewT<T>& weights,
+	                                 LeastSquaresMethod method = LeastSquaresMethod::QR, size_t* rank = nullptr);
+	
+	// Row-major Eigen maps of the elements, see EigenInterop.h.
+	template<typename U = T> typename EigenTypes<U>::Map      AsEigen();
+	template<typename U = T> typename EigenTypes<U>::ConstMap AsEigen() const;
+	
+	// Views of the elements, these don't copy the elements, see MatrixView.h.
+	MatrixViewT<T>      View();
+	ConstMatrixViewT<T> View() const;
+	MatrixViewT<T>      Row(size_t r);
+	ConstMatrixViewT<T> Row(size_t r) const;
+	MatrixViewT<T>      Col(size_t c);
+	ConstMatrixViewT<T> Col(size_t c) const;
+	MatrixViewT<T>      Block(size_t r1, size_t c1, size_t r2, size_t c2);
+	ConstMatrixViewT<T> Block(size_t r1, size_t c1, size_t r2, size_t c2) const;
 	
 	// Logical operators.
-	bool operator ==(const Matrix& B) const;
-	bool operator !=(const Matrix& B) const;
-	bool IsEqual(const Matrix& B, double tolerance) const;
-	bool IsNotEqual(const Matrix& B, double tolerance) const;
-	
-	// Arithmetic operators.
-	Matrix  operator +(const Matrix& B) const;
-	Matrix  operator -(const Matrix& B) const;
-	Matrix  operator *(const Matrix& B) const;
-	Matrix  operator *(double s) const;
-	Matrix  operator /(double s) const;
-	Matrix& operator +=(const Matrix& B);
-	Matrix& operator -=(const Matrix& B);
-	Matrix& operator *=(const Matrix& B);
-	Matrix& operator *=(double s);
-	Matrix& operator /=(double s);
+	bool operator ==(const MatrixT& B) const;
+	bool operator !=(const MatrixT& B) const;
+	bool IsEqual(const MatrixT& B, double tolerance) const;
+	bool IsNotEqual(const MatrixT& B, double tolerance) const;
+	
+	// Arithmetic operators. The overloads for temporaries reuse the storage 
+	// of the temporary for the result.
+	MatrixT  operator +(const MatrixT& B) const &;
+	MatrixT  operator +(const MatrixT& B) &&;
+	MatrixT  operator -(const MatrixT& B) const &;
+	MatrixT  operator -(const MatrixT& B) &&;
+	MatrixT  operator *(const MatrixT& B) const;
+	MatrixT  operator *(T s) const &;
+	MatrixT  operator *(T s) &&;
+	MatrixT  operator /(T s) const &;
+	MatrixT  operator /(T s) &&;
+	MatrixT& operator +=(const MatrixT& B);
+	MatrixT& operator -=(const MatrixT& B);
+	MatrixT& operator +=(const ConstMatrixViewT<T>& B);
+	MatrixT& operator -=(const ConstMatrixViewT<T>& B);
+	MatrixT& operator *=(const MatrixT& B);
+	MatrixT& operator *=(T s);
+	MatrixT& operator /=(T s);
+	
+	// Evaluate lazy expressions in one pass, see MatrixExpr.h. The expressions
+	// are only available for Matrix.
+	template<typename E> MatrixT& operator +=(const MatrixExpr<E>& expr);
+	template<typename E> MatrixT& operator -=(const MatrixExpr<E>& expr);
 	
 	
 	// ------------------------------------------------------------
 	//  Assignment, indexing and casting operators.
-	Matrix& operator =(const Matrix& B);
-	double& operator ()(size_t r, size_t c) const;
-	double& operator [](size_t index) const;
-	Matrix operator ()(size_t r1, size_t c1, size_t r2, size_t c2) const;
+	MatrixT& operator =(const MatrixT& B);
+	MatrixT& operator =(MatrixT&& B);
+	template<typename E> MatrixT& operator =(const MatrixExpr<E>& expr);
+	T&       operator ()(size_t r, size_t c) const;
+	T&       operator [](size_t index) const;
+	MatrixT  operator ()(size_t r1, size_t c1, size_t r2, size_t c2) const;
 	// ------------------------------------------------------------
 	
 	
 	// ------------------------------------------------------------
 	// Constructors and destructor.
-	Matrix();
-	Matrix(size_t r, size_t c, MatrixType type = MatrixType::Zero);
-	Matrix(size_t r, size_t c, const double* data);
-	Matrix(const Matrix& B);
-	virtual ~Matrix();
+	MatrixT();
+	MatrixT(size_t r, size_t c, MatrixType type = MatrixType::Zero);
+	MatrixT(size_t r, size_t c, const T* data);
+	MatrixT(const MatrixT& B);
+	MatrixT(MatrixT&& B);
+	template<typename E> MatrixT(const MatrixExpr<E>& expr);
+	explicit MatrixT(const ConstMatrixViewT<T>& B);
+	
+	// Evaluate an Eigen expression, e.g. the solution of a decomposition,
+	// directly into the new matrix, see EigenInterop.h.
+	template<typename Derived> explicit MatrixT(const Eigen::MatrixBase<Derived>& expr);
+	virtual ~MatrixT();
+	
+	// Exchange the contents of two matrices without copying the elements,
+	// except the elements stored inline.
+	void Swap(MatrixT& B);
+	
+	// Number of element arrays allocated by all the matrices so far, of
+	// either element type.
+	static size_t GetAllocationCount();
 	
 	// Variables.
 	size_t     rows;    // number of rows in matrix.
 	size_t     cols;    // number of cols in matrix.
 	MatrixType matType; // M_SQRMATRIX, M_ROWVECTOR, M_COLVECTOR.
-	double*    matrix;  // array storing matrix.
+	T*         matrix;  // array storing matrix.
+
+private:
+	
+	// Get storage for count elements, inline if they fit, and release it.
+	T*   AllocateElements(size_t count);
+	void FreeElements();
+	
+	inline bool IsInline() const {return matrix == mInline;}
+	
+	// Elements of the small matrices.
+	alignas(gcMatrixAlignment) T mInline[gcMatrixInlineElements];
 };
 
+// the matrices are instantiated for float and double in the library.
+extern template class SMATHLIB_DLL_API MatrixT<double>;
+extern template class SMATHLIB_DLL_API MatrixT<float>;
+
+template<typename T>
+inline void swap(MatrixT<T>& A, MatrixT<T>& B)
+{
+	A.Swap(B);
+}
+
+// for standard IO.
+SMATHLIB_DLL_API std::ostream& operator <<(std::ostream& out, const Matrix&  B);
+SMATHLIB_DLL_API std::ostream& operator <<(std::ostream& out, const MatrixF& B);
+SMATHLIB_DLL_API std::istream& operator >>(std::istream& in , Matrix&  B);
+SMATHLIB_DLL_API std::istream& operator >>(std::istream& in , MatrixF& B);
+
+// name of a solver for logging, e.g. "Cholesky".
+SMATHLIB_DLL_API const char* glSolvePathName(SolvePath path);
+
 };	// End namespace SMathLib.
 
 #endif // _SMATHLIB_MATRIX_H_
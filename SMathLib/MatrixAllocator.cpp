@@ -0,0 +1,370 @@
+// 
+// This file is part of SLogLib; you can redistribute it and/or 
+// modify it under the terms of the MIT License.
+// Author: Saurabh Garg (saurabhgarg@mysoc.net)
+// 
+
+#include "MatrixAllocator.h"
+#include "SUtils/Exceptions/InvalidOperationException.h"
+#include <algorithm>
+#include <cassert>
+#include <new>
+
+namespace SMathLib {
+;
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+// The size classes of the pool are the powers of two from 2^gcPoolMinShift to
+// 2^gcPoolMaxShift bytes.
+static const size_t gcPoolMinShift   = 6;
+static const size_t gcPoolMaxShift   = 26;
+static const size_t gcPoolNumClasses = gcPoolMaxShift - gcPoolMinShift + 1;
+
+// Largest number of bytes cached by the pool of one thread.
+static const size_t gcPoolMaxCachedBytes = size_t(256) << 20;
+
+// Header stored in front of each element array, the elements start
+// gcMatrixAlignment bytes after the block so that they keep its alignment.
+struct ElementsHeader
+{
+	MatrixAllocator* allocator;
+	size_t           bytes;
+};
+static_assert(sizeof(ElementsHeader) <= gcMatrixAlignment, "The header must fit in the alignment");
+
+static void* AlignedNew(size_t bytes)
+{
+	return ::operator new(bytes, std::align_val_t(gcMatrixAlignment));
+}
+
+static void AlignedDelete(void* block)
+{
+	::operator delete(block, std::align_val_t(gcMatrixAlignment));
+}
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+
+
+// statistics.
+// ------------------------------------------------------------------------- //
+static std::atomic<size_t> gAllocations(0);
+static std::atomic<size_t> gDeallocations(0);
+static std::atomic<size_t> gBytesAllocated(0);
+static std::atomic<size_t> gBytesInUse(0);
+static std::atomic<size_t> gPeakBytesInUse(0);
+static std::atomic<size_t> gPoolHits(0);
+static std::atomic<size_t> gPoolMisses(0);
+
+MatrixAllocationStats::MatrixAllocationStats()
+	: allocations(0), deallocations(0), bytesAllocated(0), bytesInUse(0), peakBytesInUse(0), poolHits(0),
+	  poolMisses(0)
+{}
+
+MatrixAllocationStats glGetMatrixAllocationStats()
+{
+	MatrixAllocationStats _stats;
+	_stats.allocations    = gAllocations.load(std::memory_order_relaxed);
+	_stats.deallocations  = gDeallocations.load(std::memory_order_relaxed);
+	_stats.bytesAllocated = gBytesAllocated.load(std::memory_order_relaxed);
+	_stats.bytesInUse     = gBytesInUse.load(std::memory_order_relaxed);
+	_stats.peakBytesInUse = gPeakBytesInUse.load(std::memory_order_relaxed);
+	_stats.poolHits       = gPoolHits.load(std::memory_order_relaxed);
+	_stats.poolMisses     = gPoolMisses.load(std::memory_order_relaxed);
+	return _stats;
+}
+
+void glResetMatrixAllocationStats()
+{
+	gAllocations    = 0;
+	gDeallocations  = 0;
+	gBytesAllocated = 0;
+	gPeakBytesInUse = gBytesInUse.load();
+	gPoolHits       = 0;
+	gPoolMisses     = 0;
+}
+// ------------------------------------------------------------------------- //
+
+
+// default allocator and current allocator.
+// ------------------------------------------------------------------------- //
+MatrixAllocator::~MatrixAllocator()
+{}
+
+class DefaultMatrixAllocator : public MatrixAllocator
+{
+public:
+
+	void* Allocate(size_t bytes) override
+	{
+		return AlignedNew(bytes);
+	}
+	void Deallocate(void* block, size_t) override
+	{
+		AlignedDelete(block);
+	}
+};
+
+// the allocators are never destroyed, static matrices may be freed after
+// the statics of this file.
+MatrixAllocator* glDefaultMatrixAllocator()
+{
+	static MatrixAllocator* _allocator = new DefaultMatrixAllocator;
+	return _allocator;
+}
+
+static thread_local MatrixAllocator* gCurrentAllocator = nullptr;
+
+MatrixAllocator* glSetMatrixAllocator(MatrixAllocator* allocator)
+{
+	MatrixAllocator* _previous = glGetMatrixAllocator();
+	gCurrentAllocator = allocator;
+	return _previous;
+}
+
+MatrixAllocator* glGetMatrixAllocator()
+{
+	return gCurrentAllocator ? gCurrentAllocator : glDefaultMatrixAllocator();
+}
+
+ScopedMatrixAllocator::ScopedMatrixAllocator(MatrixAllocator* allocator)
+	: mPrevious(glSetMatrixAllocator(allocator))
+{}
+
+ScopedMatrixAllocator::~ScopedMatrixAllocator()
+{
+	glSetMatrixAllocator(mPrevious);
+}
+// ------------------------------------------------------------------------- //
+
+
+// pool allocator.
+// ------------------------------------------------------------------------- //
+
+// free blocks cached by a thread, one list per size class.
+struct PoolCache
+{
+	std::vector<void*> free[gcPoolNumClasses];
+	size_t             cachedBytes = 0;
+	
+	PoolCache();
+	~PoolCache();
+};
+
+// state of the cache of the thread: 0 not created, 1 alive, 2 destroyed. A
+// matrix freed by the destructor of another thread-local object after the
+// cache is destroyed is returned directly to the system.
+static thread_local int gPoolCacheState = 0;
+
+PoolCache::PoolCache()
+{
+	gPoolCacheState = 1;
+}
+
+PoolCache::~PoolCache()
+{
+	for(size_t c=0 ; c<gcPoolNumClasses ; ++c)
+	{
+		for(void* _block : free[c])
+		{
+			AlignedDelete(_block);
+		}
+	}
+	gPoolCacheState = 2;
+}
+
+static PoolCache* ThreadPoolCache()
+{
+	if(gPoolCacheState == 2)
+	{
+		return nullptr;
+	}
+	static thread_local PoolCache _cache;
+	return &_cache;
+}
+
+// size class of a block, gcPoolNumClasses if it is too large for the pool.
+static size_t SizeClass(size_t bytes)
+{
+	size_t _shift = gcPoolMinShift;
+	while(_shift <= gcPoolMaxShift && (size_t(1) << _shift) < bytes)
+	{
+		++_shift;
+	}
+	return _shift - gcPoolMinShift;
+}
+
+class PoolMatrixAllocator : public MatrixAllocator
+{
+public:
+
+	void* Allocate(size_t bytes) override
+	{
+		const size_t _class = SizeClass(bytes);
+		if(_class >= gcPoolNumClasses)
+		{
+			++gPoolMisses;
+			return AlignedNew(bytes);
+		}
+		
+		PoolCache* _cache = ThreadPoolCache();
+		if(_cache && !_cache->free[_class].empty())
+		{
+			void* _block = _cache->free[_class].back();
+			_cache->free[_class].pop_back();
+			_cache->cachedBytes -= size_t(1) << (_class + gcPoolMinShift);
+			++gPoolHits;
+			return _block;
+		}
+		++gPoolMisses;
+		return AlignedNew(size_t(1) << (_class + gcPoolMinShift));
+	}
+	
+	void Deallocate(void* block, size_t bytes) override
+	{
+		const size_t _class = SizeClass(bytes);
+		const size_t _size  = size_t(1) << (_class + gcPoolMinShift);
+		PoolCache*   _cache = _class < gcPoolNumClasses ? ThreadPoolCache() : nullptr;
+		if(_cache && _cache->cachedBytes + _size <= gcPoolMaxCachedBytes)
+		{
+			_cache->free[_class].push_back(block);
+			_cache->cachedBytes += _size;
+		}
+		else
+		{
+			AlignedDelete(block);
+		}
+	}
+};
+
+MatrixAllocator* glPoolMatrixAllocator()
+{
+	static MatrixAllocator* _allocator = new PoolMatrixAllocator;
+	return _allocator;
+}
+// ------------------------------------------------------------------------- //
+
+
+// arena.
+// ------------------------------------------------------------------------- //
+MatrixArena::MatrixArena(size_t chunkBytes)
+	: mChunkBytes(std::max(chunkBytes, gcMatrixAlignment)), mBytesUsed(0), mLiveBlocks(0)
+{}
+
+MatrixArena::~MatrixArena()
+{
+	assert(mLiveBlocks == 0);
+	for(const Chunk& _chunk : mChunks)
+	{
+		AlignedDelete(_chunk.data);
+	}
+}
+
+void* MatrixArena::Allocate(size_t bytes)
+{
+	// blocks are rounded up to keep the next one aligned.
+	bytes = (bytes + gcMatrixAlignment - 1) / gcMatrixAlignment * gcMatrixAlignment;
+	if(mChunks.empty() || mChunks.back().size - mChunks.back().used < bytes)
+	{
+		const size_t _size = std::max(mChunkBytes, bytes);
+		mChunks.push_back(Chunk{static_cast<char*>(AlignedNew(_size)), _size, 0});
+	}
+	
+	Chunk& _chunk = mChunks.back();
+	void*  _block = _chunk.data + _chunk.used;
+	_chunk.used += bytes;
+	mBytesUsed  += bytes;
+	++mLiveBlocks;
+	return _block;
+}
+
+void MatrixArena::Deallocate(void*, size_t)
+{
+	--mLiveBlocks;
+}
+
+void MatrixArena::Reset()
+{
+	if(mLiveBlocks != 0)
+	{
+		char _msg[] = "Matrices of the arena are still alive in MatrixArena::Reset";
+		throw SUtils::Exceptions::InvalidOperationException(_msg);
+	}
+	
+	// replace several chunks by one which holds all of them.
+	if(mChunks.size() > 1)
+	{
+		size_t _size = 0;
+		for(const Chunk& _chunk : mChunks)
+		{
+			_size += _chunk.size;
+			AlignedDelete(_chunk.data);
+		}
+		mChunks.clear();
+		mChunks.push_back(Chunk{static_cast<char*>(AlignedNew(_size)), _size, 0});
+	}
+	for(Chunk& _chunk : mChunks)
+	{
+		_chunk.used = 0;
+	}
+	mBytesUsed = 0;
+}
+
+size_t MatrixArena::BytesUsed() const
+{
+	return mBytesUsed;
+}
+
+size_t MatrixArena::BytesReserved() const
+{
+	size_t _size = 0;
+	for(const Chunk& _chunk : mChunks)
+	{
+		_size += _chunk.size;
+	}
+	return _size;
+}
+
+size_t MatrixArena::LiveBlocks() const
+{
+	return mLiveBlocks;
+}
+// ------------------------------------------------------------------------- //
+
+
+// element arrays.
+// ------------------------------------------------------------------------- //
+void* glAllocateMatrixElements(size_t bytes)
+{
+	MatrixAllocator* _allocator = glGetMatrixAllocator();
+	const size_t     _total     = bytes + gcMatrixAlignment;
+	char*            _block     = static_cast<char*>(_allocator->Allocate(_total));
+	assert(reinterpret_cast<size_t>(_block) % gcMatrixAlignment == 0);
+	new(_block) ElementsHeader{_allocator, _total};
+	
+	++gAllocations;
+	gBytesAllocated += _total;
+	const size_t _inUse = gBytesInUse += _total;
+	size_t _peak = gPeakBytesInUse.load(std::memory_order_relaxed);
+	while(_inUse > _peak && !gPeakBytesInUse.compare_exchange_weak(_peak, _inUse))
+	{
+	}
+	return _block + gcMatrixAlignment;
+}
+
+void glFreeMatrixElements(void* elements)
+{
+	if(elements == nullptr)
+	{
+		return;
+	}
+	char*                 _block  = static_cast<char*>(elements) - gcMatrixAlignment;
+	const ElementsHeader* _header = reinterpret_cast<const ElementsHeader*>(_block);
+	MatrixAllocator*      _owner  = _header->allocator;
+	const size_t          _total  = _header->bytes;
+	
+	++gDeallocations;
+	gBytesInUse -= _total;
+	_owner->Deallocate(_block, _total);
+}
+// ------------------------------------------------------------------------- //
+
+};	// End namespace SMathLib.
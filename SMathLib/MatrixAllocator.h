@@ -0,0 +1,177 @@
+// 
+// This file is part of SLogLib; you can redistribute it and/or 
+// modify it under the terms of the MIT License.
+// Author: Saurabh Garg (saurabhgarg@mysoc.net)
+// 
+
+#ifndef _SMATHLIB_MATRIXALLOCATOR_H_
+#define _SMATHLIB_MATRIXALLOCATOR_H_
+
+#include "SMathLib/Config.h"
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+namespace SMathLib {
+;
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+// Allocators of the element arrays of matrices. Each thread has a current
+// allocator which is used by all the matrices created on that thread; it is
+// changed for a scope with ScopedMatrixAllocator:
+//
+//     MatrixArena _arena;
+//     for(...)                                          // Solver iterations.
+//     {
+//         {
+//             ScopedMatrixAllocator _scope(&_arena);
+//             Matrix _r = b - A*x;                      // Temporaries in the arena.
+//             ...
+//         }                                             // Temporaries destroyed.
+//         _arena.Reset();                               // Memory reclaimed at once.
+//     }
+//
+//     ScopedMatrixAllocator _pool(glPoolMatrixAllocator());   // Recycle arrays.
+//
+// Every array is aligned to gcMatrixAlignment bytes. An array remembers its
+// allocator and is always returned to it, whichever allocator is current when
+// the matrix is destroyed. The default allocator uses the aligned operator new.
+// The threads of the thread pool use the default allocator.
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+//! Alignment of the element arrays of matrices, a cache line and enough for
+//! aligned AVX-512 loads.
+static const size_t gcMatrixAlignment = 64;
+
+//! Interface of the allocators. Allocate() must return blocks aligned to
+//! gcMatrixAlignment bytes and Deallocate() receives the size which was
+//! allocated. Deallocate() can be called from any thread.
+class SMATHLIB_DLL_API MatrixAllocator
+{
+public:
+
+	virtual ~MatrixAllocator();
+	
+	virtual void* Allocate(size_t bytes) = 0;
+	virtual void  Deallocate(void* block, size_t bytes) = 0;
+};
+
+//! The default allocator, which uses the aligned operator new and delete.
+SMATHLIB_DLL_API MatrixAllocator* glDefaultMatrixAllocator();
+
+//! Thread-local pool of size classes. The sizes are rounded up to powers of
+//! two, up to 64 MB, and freed arrays are cached by the thread which frees
+//! them, up to 256 MB per thread, so that arrays of the same size are
+//! recycled without calling the system allocator. Larger arrays bypass the
+//! pool. The cache of a thread is released when the thread exits.
+SMATHLIB_DLL_API MatrixAllocator* glPoolMatrixAllocator();
+
+//! Set the current allocator of the calling thread, nullptr selects the
+//! default allocator. Returns the previous allocator.
+SMATHLIB_DLL_API MatrixAllocator* glSetMatrixAllocator(MatrixAllocator* allocator);
+
+//! Get the current allocator of the calling thread.
+SMATHLIB_DLL_API MatrixAllocator* glGetMatrixAllocator();
+
+//! Make an allocator current on the calling thread for the lifetime of the
+//! object and restore the previous one afterwards.
+class SMATHLIB_DLL_API ScopedMatrixAllocator
+{
+public:
+
+	explicit ScopedMatrixAllocator(MatrixAllocator* allocator);
+	~ScopedMatrixAllocator();
+	
+	ScopedMatrixAllocator(const ScopedMatrixAllocator&) = delete;
+	ScopedMatrixAllocator& operator=(const ScopedMatrixAllocator&) = delete;
+
+private:
+
+	MatrixAllocator* mPrevious;
+};
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+//! Arena for the temporaries of a computation. Allocate() takes the next
+//! aligned block from a large chunk and Deallocate() does nothing; all the
+//! memory is reclaimed by Reset(), which merges the chunks into one so that
+//! the next iteration of a loop allocates nothing from the system. All the
+//! matrices allocated in the arena must be destroyed before it is reset or
+//! destroyed. Allocate() must only be called from one thread at a time.
+class SMATHLIB_DLL_API MatrixArena : public MatrixAllocator
+{
+public:
+
+	//! chunkBytes is the size of the first chunk; larger blocks get a chunk
+	//! of their own.
+	explicit MatrixArena(size_t chunkBytes = size_t(1) << 20);
+	~MatrixArena();
+	
+	MatrixArena(const MatrixArena&) = delete;
+	MatrixArena& operator=(const MatrixArena&) = delete;
+	
+	void* Allocate(size_t bytes) override;
+	void  Deallocate(void* block, size_t bytes) override;
+	
+	//! Reclaim all the memory. Throws SUtils::Exceptions::InvalidOperationException
+	//! if blocks of the arena are still in use.
+	void Reset();
+	
+	//! Bytes handed out since the last reset and bytes held in chunks.
+	size_t BytesUsed() const;
+	size_t BytesReserved() const;
+	
+	//! Number of blocks which have not been deallocated.
+	size_t LiveBlocks() const;
+
+private:
+
+	struct Chunk
+	{
+		char*  data;
+		size_t size;
+		size_t used;
+	};
+	
+	size_t              mChunkBytes;
+	std::vector<Chunk>  mChunks;
+	size_t              mBytesUsed;
+	std::atomic<size_t> mLiveBlocks;
+};
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+//! Statistics of the element arrays of all the matrices, whichever their
+//! allocator. Sizes include a header of gcMatrixAlignment bytes per array.
+struct SMATHLIB_DLL_API MatrixAllocationStats
+{
+	MatrixAllocationStats();
+	
+	size_t allocations;      ///< Number of arrays allocated.
+	size_t deallocations;    ///< Number of arrays freed.
+	size_t bytesAllocated;   ///< Total bytes allocated.
+	size_t bytesInUse;       ///< Bytes of the arrays which are not freed.
+	size_t peakBytesInUse;   ///< Largest value of bytesInUse.
+	size_t poolHits;         ///< Allocations of the pool served from its cache.
+	size_t poolMisses;       ///< Allocations of the pool passed to the system allocator.
+};
+
+//! Get the statistics since the start or the last reset.
+SMATHLIB_DLL_API MatrixAllocationStats glGetMatrixAllocationStats();
+
+//! Reset the counters, bytesInUse is kept and becomes the peak.
+SMATHLIB_DLL_API void glResetMatrixAllocationStats();
+
+//! Allocate and free element arrays of bytes bytes with the current
+//! allocator, used by the matrices. The arrays are aligned to gcMatrixAlignment.
+SMATHLIB_DLL_API void* glAllocateMatrixElements(size_t bytes);
+SMATHLIB_DLL_API void  glFreeMatrixElements(void* elements);
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+
+};	// End namespace SMathLib.
+
+#endif // _SMATHLIB_MATRIXALLOCATOR_H_
@@ -0,0 +1,254 @@
+// 
+// This file is part of SLogLib; you can redistribute it and/or 
+// modify it under the terms of the MIT License.
+// Author: Saurabh Garg (saurabhgarg@mysoc.net)
+// 
+
+#ifndef _SMATHLIB_MATRIXEXPR_H_
+#define _SMATHLIB_MATRIXEXPR_H_
+
+#include "SMathLib/Matrix.h"
+#include "SMathLib/MatrixView.h"
+#include "SMathLib/Gemm.h"
+#include "SMathLib/Parallel.h"
+#include <cassert>
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
+
+namespace SMathLib {
+;
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+// Lazy matrix expressions.
+//
+// The operators of Matrix evaluate immediately and each of them makes a pass
+// over memory and creates a temporary. The classes in this file build a tree
+// describing the expression instead, which is evaluated in one pass when it is
+// assigned to a Matrix:
+//
+//     D = glLazy(A)*s + B - C;        // One pass, no temporaries.
+//     D = alpha*A*B + beta*C;         // One glGemm call with beta.
+//     D = alpha*A*B + beta*D;         // glGemm accumulates directly into D.
+//
+// An expression is started with glLazy(A), by multiplying a scalar with a
+// matrix or by using a MatrixView; after that Matrix operands can be mixed
+// freely. Views are evaluated in place without copying their elements, and
+// expressions can also be assigned to views:
+//
+//     A.Block(0, 0, 3, 3) = B.Row(1).Transpose() * C.Row(2) + A.Block(0, 0, 3, 3);
+//
+// Expressions keep references to their operands, so they must be assigned
+// before the operands are destroyed, and should not be stored with auto. An
+// operand may refer to exactly the same elements as the destination, e.g.
+// D = glLazy(D)*2, which is evaluated in place. If an operand overlaps the
+// destination otherwise, or a Matrix destination is resized while an operand
+// refers to its elements, the expression is evaluated into a temporary.
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+//! Kinds of lazy matrix expressions.
+enum MatrixExprKind
+{
+	eMatrixExpr_None        = 0,    ///< Not a matrix expression.
+	eMatrixExpr_Elementwise = 1,    ///< Each element depends on the same element of the operands.
+	eMatrixExpr_Product     = 2,    ///< Product alpha*A*B.
+	eMatrixExpr_Gemm        = 3,    ///< Product plus an element-wise expression, alpha*A*B + E.
+};
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+//! Base class of all the lazy matrix expressions.
+//! \param Derived The class of the expression.
+template<typename Derived>
+class MatrixExpr
+{
+public:
+
+	//! Get the expression as its derived class.
+	inline const Derived& Self() const {return static_cast<const Derived&>(*this);}
+};
+
+//! A matrix or a view used as an operand of an expression.
+class MatrixRefExpr : public MatrixExpr<MatrixRefExpr>
+{
+public:
+
+	enum {Kind = eMatrixExpr_Elementwise};
+	
+	explicit MatrixRefExpr(const ConstMatrixView& A) : mView(A) {}
+	
+	inline size_t                 Rows()                    const {return mView.Rows();}
+	inline size_t                 Cols()                    const {return mView.Cols();}
+	inline double                 Coeff(size_t r, size_t c) const {return mView(r, c);}
+	inline const ConstMatrixView& Get()                     const {return mView;}
+
+private:
+
+	ConstMatrixView mView;
+};
+
+//! Element-wise sum of two expressions, L + R.
+template<typename L, typename R>
+class MatrixSumExpr : public MatrixExpr<MatrixSumExpr<L, R> >
+{
+public:
+
+	enum {Kind = eMatrixExpr_Elementwise};
+	
+	MatrixSumExpr(const L& l, const R& r) : mL(l), mR(r)
+	{
+		assert(l.Rows() == r.Rows() && l.Cols() == r.Cols());
+	}
+	
+	inline size_t   Rows()                    const {return mL.Rows();}
+	inline size_t   Cols()                    const {return mL.Cols();}
+	inline double   Coeff(size_t r, size_t c) const {return mL.Coeff(r, c) + mR.Coeff(r, c);}
+	inline const L& Left()                    const {return mL;}
+	inline const R& Right()                   const {return mR;}
+
+private:
+
+	L mL;
+	R mR;
+};
+
+//! Element-wise difference of two expressions, L - R.
+template<typename L, typename R>
+class MatrixDifferenceExpr : public MatrixExpr<MatrixDifferenceExpr<L, R> >
+{
+public:
+
+	enum {Kind = eMatrixExpr_Elementwise};
+	
+	MatrixDifferenceExpr(const L& l, const R& r) : mL(l), mR(r)
+	{
+		assert(l.Rows() == r.Rows() && l.Cols() == r.Cols());
+	}
+	
+	inline size_t   Rows()                    const {return mL.Rows();}
+	inline size_t   Cols()                    const {return mL.Cols();}
+	inline double   Coeff(size_t r, size_t c) const {return mL.Coeff(r, c) - mR.Coeff(r, c);}
+	inline const L& Left()                    const {return mL;}
+	inline const R& Right()                   const {return mR;}
+
+private:
+
+	L mL;
+	R mR;
+};
+
+//! Expression multiplied with a scalar, s * E.
+template<typename E>
+class MatrixScaleExpr : public MatrixExpr<MatrixScaleExpr<E> >
+{
+public:
+
+	enum {Kind = eMatrixExpr_Elementwise};
+	
+	MatrixScaleExpr(double s, const E& e) : mScale(s), mE(e) {}
+	
+	inline size_t   Rows()                    const {return mE.Rows();}
+	inline size_t   Cols()                    const {return mE.Cols();}
+	inline double   Coeff(size_t r, size_t c) const {return mScale * mE.Coeff(r, c);}
+	inline double   Scale()                   const {return mScale;}
+	inline const E& Expr()                    const {return mE;}
+
+private:
+
+	double mScale;
+	E      mE;
+};
+
+//! Expression divided by a scalar, E / s.
+template<typename E>
+class MatrixDivideExpr : public MatrixExpr<MatrixDivideExpr<E> >
+{
+public:
+
+	enum {Kind = eMatrixExpr_Elementwise};
+	
+	MatrixDivideExpr(const E& e, double s) : mScale(s), mE(e) {}
+	
+	inline size_t   Rows()                    const {return mE.Rows();}
+	inline size_t   Cols()                    const {return mE.Cols();}
+	inline double   Coeff(size_t r, size_t c) const {return mE.Coeff(r, c) / mScale;}
+	inline const E& Expr()                    const {return mE;}
+
+private:
+
+	double mScale;
+	E      mE;
+};
+
+//! Scaled product of two matrices, alpha * A * B.
+class MatrixProductExpr : public MatrixExpr<MatrixProductExpr>
+{
+public:
+
+	enum {Kind = eMatrixExpr_Product};
+	
+	MatrixProductExpr(double alpha, const ConstMatrixView& A, const ConstMatrixView& B) : mAlpha(alpha), mA(A), mB(B)
+	{
+		assert(A.Cols() == B.Rows());
+	}
+	
+	inline size_t                 Rows()  const {return mA.Rows();}
+	inline size_t                 Cols()  const {return mB.Cols();}
+	inline double                 Alpha() const {return mAlpha;}
+	inline const ConstMatrixView& A()     const {return mA;}
+	inline const ConstMatrixView& B()     const {return mB;}
+
+private:
+
+	double          mAlpha;
+	ConstMatrixView mA;
+	ConstMatrixView mB;
+};
+
+//! Scaled product plus an expression, alpha * A * B + E.
+template<typename E>
+class MatrixGemmExpr : public MatrixExpr<MatrixGemmExpr<E> >
+{
+public:
+
+	enum {Kind = eMatrixExpr_Gemm};
+	
+	MatrixGemmExpr(const MatrixProductExpr& product, const E& addend) : mProduct(product), mAddend(addend)
+	{
+		assert(product.Rows() == addend.Rows() && product.Cols() == addend.Cols());
+	}
+	
+	inline size_t                   Rows()    const {return mProduct.Rows();}
+	inline size_t                   Cols()    const {return mProduct.Cols();}
+	inline const MatrixProductExpr& Product() const {return mProduct;}
+	inline const E&                 Addend()  const {return mAddend;}
+
+private:
+
+	MatrixProductExpr mProduct;
+	E                 mAddend;
+};
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+//! Start a lazy expression with a matrix or a view.
+inline MatrixRefExpr glLazy(const ConstMatrixView& A)
+{
+	return MatrixRefExpr(A);
+}
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+// Operators which build the expressions, see Impl/MatrixExpr.hpp.
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+
+#include "SMathLib/Impl/MatrixExpr.hpp"
+
+};	// End namespace SMathLib.
+
+#endif // _SMATHLIB_MATRIXEXPR_H_
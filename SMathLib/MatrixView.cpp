@@ -0,0 +1,362 @@
+// 
+// This file is part of SLogLib; you can redistribute it and/or 
+// modify it under the terms of the MIT License.
+// Author: Saurabh Garg (saurabhgarg@mysoc.net)
+// 
+
+#include "MatrixView.h"
+#include "EigenInterop.h"
+#include "Matrix.h"
+#include "Parallel.h"
+#include "Transpose.h"
+#include "SUtils/Exceptions/InvalidArgumentException.h"
+#include <Eigen/Dense>
+#include <Eigen/SVD>
+#include <Eigen/LU>
+#include <ostream>
+
+namespace SMathLib {
+;
+
+// minimum number of elements processed by a thread in element-wise operations.
+static const size_t gcParallelGrain = 32768;
+
+// number of rows which have at least gcParallelGrain elements.
+static size_t RowGrain(size_t cols)
+{
+	return cols == 0 ? 1 : (gcParallelGrain + cols - 1) / cols;
+}
+
+// apply func(dst, src) to the corresponding elements of two views of the same size.
+template<typename T, typename Func>
+static void ForEachElement(const MatrixViewT<T>& A, const ConstMatrixViewT<T>& B, Func func)
+{
+	assert(A.Rows() == B.Rows() && A.Cols() == B.Cols());
+	
+	T*       _a = A.Data();
+	const T* _b = B.Data();
+	glParallelFor(0, A.Rows(), RowGrain(A.Cols()), [&](size_t r1, size_t r2)
+	{
+		for(size_t i=r1 ; i<r2 ; i++)
+		{
+			T*       _ai = _a + i*A.RowStride();
+			const T* _bi = _b + i*B.RowStride();
+			if(A.ColStride() == 1 && B.ColStride() == 1)
+			{
+				for(size_t j=0 ; j<A.Cols() ; j++)
+				{
+					func(_ai[j], _bi[j]);
+				}
+			}
+			else
+			{
+				for(size_t j=0 ; j<A.Cols() ; j++)
+				{
+					func(_ai[j*A.ColStride()], _bi[j*B.ColStride()]);
+				}
+			}
+		}
+	});
+}
+
+// apply func(dst) to all the elements of a view.
+template<typename T, typename Func>
+static void ForEachElement(const MatrixViewT<T>& A, Func func)
+{
+	T* _a = A.Data();
+	glParallelFor(0, A.Rows(), RowGrain(A.Cols()), [&](size_t r1, size_t r2)
+	{
+		for(size_t i=r1 ; i<r2 ; i++)
+		{
+			T* _ai = _a + i*A.RowStride();
+			for(size_t j=0 ; j<A.Cols() ; j++)
+			{
+				func(_ai[j*A.ColStride()]);
+			}
+		}
+	});
+}
+
+// column-major Eigen matrices used by the decompositions.
+template<typename T> using ColMajorX = Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic>;
+
+
+// constructors.
+// ------------------------------------------------------------------------- //
+template<typename T>
+ConstMatrixViewT<T>::ConstMatrixViewT()
+	: mData(nullptr), mRows(0), mCols(0), mRowStride(0), mColStride(1)
+{}
+
+template<typename T>
+ConstMatrixViewT<T>::ConstMatrixViewT(const T* data, size_t rows, size_t cols, size_t rowStride, size_t colStride)
+	: mData(data), mRows(rows), mCols(cols), mRowStride(rowStride), mColStride(colStride)
+{}
+
+template<typename T>
+ConstMatrixViewT<T>::ConstMatrixViewT(const MatrixT<T>& A)
+	: mData(A.matrix), mRows(A.rows), mCols(A.cols), mRowStride(A.cols), mColStride(1)
+{}
+
+template<typename T>
+MatrixViewT<T>::MatrixViewT()
+	: ConstMatrixViewT<T>()
+{}
+
+template<typename T>
+MatrixViewT<T>::MatrixViewT(T* data, size_t rows, size_t cols, size_t rowStride, size_t colStride)
+	: ConstMatrixViewT<T>(data, rows, cols, rowStride, colStride)
+{}
+
+template<typename T>
+MatrixViewT<T>::MatrixViewT(MatrixT<T>& A)
+	: ConstMatrixViewT<T>(A)
+{}
+// ------------------------------------------------------------------------- //
+
+
+// sub-views.
+// ------------------------------------------------------------------------- //
+template<typename T>
+ConstMatrixViewT<T> ConstMatrixViewT<T>::Row(size_t r) const
+{
+	assert(r < mRows);
+	return ConstMatrixViewT(mData + r*mRowStride, 1, mCols, mRowStride, mColStride);
+}
+
+template<typename T>
+ConstMatrixViewT<T> ConstMatrixViewT<T>::Col(size_t c) const
+{
+	assert(c < mCols);
+	return ConstMatrixViewT(mData + c*mColStride, mRows, 1, mRowStride, mColStride);
+}
+
+template<typename T>
+ConstMatrixViewT<T> ConstMatrixViewT<T>::Block(size_t r1, size_t c1, size_t r2, size_t c2) const
+{
+	assert(r1 <= r2 && r2 < mRows && c1 <= c2 && c2 < mCols);
+	return ConstMatrixViewT(mData + r1*mRowStride + c1*mColStride, r2-r1+1, c2-c1+1, mRowStride, mColStride);
+}
+
+template<typename T>
+ConstMatrixViewT<T> ConstMatrixViewT<T>::Transpose() const
+{
+	return ConstMatrixViewT(mData, mCols, mRows, mColStride, mRowStride);
+}
+
+template<typename T>
+MatrixViewT<T> MatrixViewT<T>::Row(size_t r) const
+{
+	const ConstMatrixViewT<T> _view = ConstMatrixViewT<T>::Row(r);
+	return MatrixViewT(const_cast<T*>(_view.Data()), _view.Rows(), _view.Cols(), _view.RowStride(), _view.ColStride());
+}
+
+template<typename T>
+MatrixViewT<T> MatrixViewT<T>::Col(size_t c) const
+{
+	const ConstMatrixViewT<T> _view = ConstMatrixViewT<T>::Col(c);
+	return MatrixViewT(const_cast<T*>(_view.Data()), _view.Rows(), _view.Cols(), _view.RowStride(), _view.ColStride());
+}
+
+template<typename T>
+MatrixViewT<T> MatrixViewT<T>::Block(size_t r1, size_t c1, size_t r2, size_t c2) const
+{
+	const ConstMatrixViewT<T> _view = ConstMatrixViewT<T>::Block(r1, c1, r2, c2);
+	return MatrixViewT(const_cast<T*>(_view.Data()), _view.Rows(), _view.Cols(), _view.RowStride(), _view.ColStride());
+}
+
+template<typename T>
+MatrixViewT<T> MatrixViewT<T>::Transpose() const
+{
+	return MatrixViewT(Data(), mCols, mRows, mColStride, mRowStride);
+}
+// ------------------------------------------------------------------------- //
+
+
+// assignment and arithmetic operators.
+// ------------------------------------------------------------------------- //
+template<typename T>
+MatrixViewT<T>& MatrixViewT<T>::operator =(const MatrixViewT& B)
+{
+	return *this = static_cast<const ConstMatrixViewT<T>&>(B);
+}
+
+template<typename T>
+MatrixViewT<T>& MatrixViewT<T>::operator =(const ConstMatrixViewT<T>& B)
+{
+	// B is the transpose of a row-major matrix, e.g. A.Transpose(), copying it
+	// element by element would read one element per cache line.
+	if(B.RowStride() == 1 && B.Rows() > 1 && B.Cols() > 1 && this->ColStride() == 1)
+	{
+		assert(this->Rows() == B.Rows() && this->Cols() == B.Cols());
+		glTranspose(B.Cols(), B.Rows(), B.Data(), B.ColStride(), Data(), this->RowStride());
+		return *this;
+	}
+	
+	ForEachElement(*this, B, [](T& a, T b) { a = b; });
+	return *this;
+}
+
+template<typename T>
+MatrixViewT<T>& MatrixViewT<T>::operator =(const MatrixT<T>& B)
+{
+	return *this = ConstMatrixViewT<T>(B);
+}
+
+template<typename T>
+MatrixViewT<T>& MatrixViewT<T>::operator +=(const ConstMatrixViewT<T>& B)
+{
+	ForEachElement(*this, B, [](T& a, T b) { a += b; });
+	return *this;
+}
+
+template<typename T>
+MatrixViewT<T>& MatrixViewT<T>::operator -=(const ConstMatrixViewT<T>& B)
+{
+	ForEachElement(*this, B, [](T& a, T b) { a -= b; });
+	return *this;
+}
+
+template<typename T>
+MatrixViewT<T>& MatrixViewT<T>::operator *=(T s)
+{
+	ForEachElement(*this, [s](T& a) { a *= s; });
+	return *this;
+}
+
+template<typename T>
+MatrixViewT<T>& MatrixViewT<T>::operator /=(T s)
+{
+	ForEachElement(*this, [s](T& a) { a /= s; });
+	return *this;
+}
+
+template<typename T>
+void MatrixViewT<T>::Fill(T s)
+{
+	ForEachElement(*this, [s](T& a) { a = s; });
+}
+// ------------------------------------------------------------------------- //
+
+
+// functions.
+// ------------------------------------------------------------------------- //
+template<typename T>
+T ConstMatrixViewT<T>::Determinant() const
+{
+	return AsEigen().determinant();
+}
+
+template<typename T>
+MatrixT<T> ConstMatrixViewT<T>::Inverse() const
+{
+	assert(mRows>0 && mCols>0 && mRows==mCols);
+	
+	// evaluate the inverse directly into the result.
+	return MatrixT<T>(AsEigen().inverse());
+}
+
+template<typename T>
+MatrixT<T> ConstMatrixViewT<T>::Svd(MatrixT<T>* S, MatrixT<T>* V, SvdMode mode) const
+{
+	unsigned int _options = 0;
+	if(mode == SvdMode::Full)
+	{
+		_options = Eigen::ComputeFullU | Eigen::ComputeFullV;
+	}
+	else if(mode == SvdMode::Thin)
+	{
+		_options = Eigen::ComputeThinU | Eigen::ComputeThinV;
+	}
+	
+	// thin U and V need a column-major matrix, BDCSVD only takes its own type.
+	const ColMajorX<T>                _A = AsEigen();
+	const Eigen::BDCSVD<ColMajorX<T>> _results(_A, _options);
+	
+	// U and V are column-major, assigning them to row-major maps reorders the
+	// elements. The outputs are written in place.
+	MatrixT<T> U;
+	if(mode != SvdMode::ValuesOnly)
+	{
+		U = MatrixT<T>(_results.matrixU());
+		if(V != nullptr)
+		{
+			glEigenOutput(*V, size_t(_results.matrixV().rows()), size_t(_results.matrixV().cols())) = _results.matrixV();
+		}
+	}
+	if(S != nullptr)
+	{
+		glEigenOutput(*S, size_t(_results.singularValues().size()), 1) = _results.singularValues();
+	}
+	return U;
+}
+
+template<typename T>
+MatrixT<T> ConstMatrixViewT<T>::EigenSymmetric(MatrixT<T>* values, bool computeVectors) const
+{
+	assert(mRows == mCols);
+	
+	// the solver copies the elements straight from the strided map.
+	const Eigen::SelfAdjointEigenSolver<ColMajorX<T>> _results(AsEigen(), computeVectors ? Eigen::ComputeEigenvectors
+	                                                                                     : Eigen::EigenvaluesOnly);
+	if(_results.info() != Eigen::Success)
+	{
+		char _msg[] = "Eigen decomposition did not converge in ConstMatrixView::EigenSymmetric";
+		throw SUtils::Exceptions::InvalidArgumentException(_msg);
+	}
+	
+	MatrixT<T> Q;
+	if(computeVectors)
+	{
+		Q = MatrixT<T>(_results.eigenvectors());
+	}
+	if(values != nullptr)
+	{
+		glEigenOutput(*values, mRows, 1) = _results.eigenvalues();
+	}
+	return Q;
+}
+
+template<typename T>
+void ConstMatrixViewT<T>::Write(std::ostream& out) const
+{
+	if ((mRows == 0 && mCols == 0) || mData == nullptr)
+	{
+		out << "Null Matrix";
+	}
+	
+	out << mRows << " " << mCols;
+	for(size_t i=0 ; i<mRows ; i++)
+	{
+		out << std::endl;
+		
+		for (size_t j = 0; j < mCols; j++)
+		{
+			out << (*this)(i, j) << " ";
+		}
+	}
+}
+
+std::ostream& operator <<(std::ostream& out, const ConstMatrixView& B)
+{
+	B.Write(out);
+	return out;
+}
+
+std::ostream& operator <<(std::ostream& out, const ConstMatrixViewF& B)
+{
+	B.Write(out);
+	return out;
+}
+// ------------------------------------------------------------------------- //
+
+
+// instantiations.
+// ------------------------------------------------------------------------- //
+template class SMATHLIB_DLL_API ConstMatrixViewT<double>;
+template class SMATHLIB_DLL_API ConstMatrixViewT<float>;
+template class SMATHLIB_DLL_API MatrixViewT<double>;
+template class SMATHLIB_DLL_API MatrixViewT<float>;
+// ------------------------------------------------------------------------- //
+
+};	// End namespace SMathLib.
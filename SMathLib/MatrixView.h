@@ -0,0 +1,206 @@
+// 
+// This file is part of SLogLib; you can redistribute it and/or 
+// modify it under the terms of the MIT License.
+// Author: Saurabh Garg (saurabhgarg@mysoc.net)
+// 
+
+#ifndef _SMATHLIB_MATRIXVIEW_H_
+#define _SMATHLIB_MATRIXVIEW_H_
+
+#include "SMathLib/Config.h"
+#include <cassert>
+#include <cstddef>
+#include <iosfwd>
+
+namespace Eigen {
+template<typename Derived> class MatrixBase;
+}
+
+namespace SMathLib {
+;
+
+template<typename T> class MatrixT;
+template<typename T> struct EigenTypes;
+template<typename Derived> class MatrixExpr;
+
+typedef MatrixT<double> Matrix;
+typedef MatrixT<float>  MatrixF;
+
+//! Parts of the singular value decomposition A = U*S*V^T computed by Svd(),
+//! where A is m x n and k = min(m, n).
+enum class SvdMode
+{
+	Full,         ///< U is m x m and V is n x n.
+	Thin,         ///< U is m x k and V is n x k, enough to reconstruct A.
+	ValuesOnly    ///< Only the k singular values, U and V are not computed.
+};
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+//! A read-only view of a rectangular part of a matrix.
+//! The element (r, c) of the view is stored at Data()[r*RowStride() + c*ColStride()],
+//! so rows, columns, blocks and transposes of a matrix are all views of its
+//! storage and are created without copying any element. A view does not own
+//! its elements and must not be used after the viewed matrix is destroyed or
+//! resized. T is the type of the elements, float or double.
+template<typename T>
+class ConstMatrixViewT
+{
+public:  // Constructors.
+
+	ConstMatrixViewT();
+	ConstMatrixViewT(const T* data, size_t rows, size_t cols, size_t rowStride, size_t colStride);
+	ConstMatrixViewT(const MatrixT<T>& A);
+
+public:  // Size and storage.
+
+	inline size_t        Rows()      const {return mRows;}
+	inline size_t        Cols()      const {return mCols;}
+	inline size_t        RowStride() const {return mRowStride;}
+	inline size_t        ColStride() const {return mColStride;}
+	inline const T*      Data()      const {return mData;}
+	
+	//! Check if the elements are stored row by row without gaps, like a Matrix.
+	inline bool IsContiguous() const {return mColStride == 1 && (mRowStride == mCols || mRows <= 1);}
+	
+	//! Strided Eigen map of the viewed elements, see EigenInterop.h.
+	template<typename U = T> typename EigenTypes<U>::ConstStridedMap AsEigen() const;
+
+public:  // Indexing operator.
+
+	inline const T& operator()(size_t r, size_t c) const
+	{
+		assert(r < mRows && c < mCols);
+		return mData[r*mRowStride + c*mColStride];
+	}
+
+public:  // Sub-views.
+
+	//! View of the row r.
+	ConstMatrixViewT Row(size_t r) const;
+	
+	//! View of the column c.
+	ConstMatrixViewT Col(size_t c) const;
+	
+	//! View of the block from (r1, c1) to (r2, c2), both inclusive.
+	ConstMatrixViewT Block(size_t r1, size_t c1, size_t r2, size_t c2) const;
+	
+	//! View of the transpose.
+	ConstMatrixViewT Transpose() const;
+
+public:  // Functions, these work directly on the viewed elements.
+
+	T          Determinant() const;
+	MatrixT<T> Inverse() const;
+	void       Write(std::ostream& out) const;
+	
+	//! Singular value decomposition, returns U and stores the singular values
+	//! in decreasing order as a k x 1 matrix in sigma and V in v. sigma and v
+	//! can be nullptr if they are not needed, v is not set for ValuesOnly.
+	MatrixT<T> Svd(MatrixT<T>* sigma, MatrixT<T>* v, SvdMode mode = SvdMode::Full) const;
+	
+	//! Eigen decomposition A = Q*D*Q^T of a symmetric matrix by reduction to
+	//! tridiagonal form and implicit symmetric QR iterations. Only the lower
+	//! triangle is read. Returns the orthonormal eigenvectors as the columns of
+	//! Q and stores the eigenvalues in increasing order as a n x 1 matrix in
+	//! values. Returns an empty matrix if computeVectors is false. For a few
+	//! eigenpairs of a large matrix see glLanczosEigen() in Lanczos.h.
+	MatrixT<T> EigenSymmetric(MatrixT<T>* values, bool computeVectors = true) const;
+
+protected:
+
+	const T* mData;
+	size_t   mRows;
+	size_t   mCols;
+	size_t   mRowStride;
+	size_t   mColStride;
+};
+
+typedef ConstMatrixViewT<double> ConstMatrixView;
+typedef ConstMatrixViewT<float>  ConstMatrixViewF;
+
+//! Write the elements of a view in the same format as a Matrix.
+SMATHLIB_DLL_API std::ostream& operator <<(std::ostream& out, const ConstMatrixView&  B);
+SMATHLIB_DLL_API std::ostream& operator <<(std::ostream& out, const ConstMatrixViewF& B);
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+//! A view of a rectangular part of a matrix through which its elements can be
+//! modified. Copying a view copies the reference to the storage, while
+//! assigning to a view copies the elements into the viewed matrix:
+//!
+//!     A.Block(0, 0, 2, 2) = B.Transpose();    // Writes into A.
+//!     A.Row(3)           *= 2.0;
+template<typename T>
+class MatrixViewT : public ConstMatrixViewT<T>
+{
+public:  // Constructors.
+
+	MatrixViewT();
+	MatrixViewT(T* data, size_t rows, size_t cols, size_t rowStride, size_t colStride);
+	MatrixViewT(MatrixT<T>& A);
+	MatrixViewT(const MatrixViewT& B) = default;
+
+public:  // Storage and indexing operator.
+
+	inline T* Data() const {return const_cast<T*>(mData);}
+	
+	//! Strided Eigen map through which the viewed elements can be modified.
+	template<typename U = T> typename EigenTypes<U>::StridedMap AsEigen() const;
+	
+	inline T& operator()(size_t r, size_t c) const
+	{
+		assert(r < mRows && c < mCols);
+		return Data()[r*mRowStride + c*mColStride];
+	}
+
+public:  // Sub-views.
+
+	MatrixViewT Row(size_t r) const;
+	MatrixViewT Col(size_t c) const;
+	MatrixViewT Block(size_t r1, size_t c1, size_t r2, size_t c2) const;
+	MatrixViewT Transpose() const;
+
+public:  // Assignment and arithmetic operators, these modify the viewed elements.
+
+	//! Copy the elements of B, which must have the same size, into the view.
+	//! B may overlap the view only if both refer to exactly the same elements.
+	MatrixViewT& operator =(const MatrixViewT& B);
+	MatrixViewT& operator =(const ConstMatrixViewT<T>& B);
+	MatrixViewT& operator =(const MatrixT<T>& B);
+	MatrixViewT& operator +=(const ConstMatrixViewT<T>& B);
+	MatrixViewT& operator -=(const ConstMatrixViewT<T>& B);
+	MatrixViewT& operator *=(T s);
+	MatrixViewT& operator /=(T s);
+	
+	//! Evaluate a lazy expression into the view, see MatrixExpr.h. The
+	//! expressions are only available for double views.
+	template<typename E> MatrixViewT& operator =(const MatrixExpr<E>& expr);
+	template<typename E> MatrixViewT& operator +=(const MatrixExpr<E>& expr);
+	template<typename E> MatrixViewT& operator -=(const MatrixExpr<E>& expr);
+	
+	//! Set all the elements to s.
+	void Fill(T s);
+
+protected:
+
+	using ConstMatrixViewT<T>::mData;
+	using ConstMatrixViewT<T>::mRows;
+	using ConstMatrixViewT<T>::mCols;
+	using ConstMatrixViewT<T>::mRowStride;
+	using ConstMatrixViewT<T>::mColStride;
+};
+
+typedef MatrixViewT<double> MatrixView;
+typedef MatrixViewT<float>  MatrixViewF;
+
+// the views are instantiated for float and double in the library.
+extern template class SMATHLIB_DLL_API ConstMatrixViewT<double>;
+extern template class SMATHLIB_DLL_API ConstMatrixViewT<float>;
+extern template class SMATHLIB_DLL_API MatrixViewT<double>;
+extern template class SMATHLIB_DLL_API MatrixViewT<float>;
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+
+};	// End namespace SMathLib.
+
+#endif // _SMATHLIB_MATRIXVIEW_H_
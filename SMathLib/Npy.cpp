@@ -0,0 +1,513 @@
+// 
+// This file is part of SLogLib; you can redistribute it and/or 
+// modify it under the terms of the MIT License.
+// Author: Saurabh Garg (saurabhgarg@mysoc.net)
+// 
+
+#include "Npy.h"
+#include "MappedFile.h"
+#include "SUtils/Exceptions/InvalidArgumentException.h"
+#include "SUtils/Exceptions/InvalidOperationException.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <istream>
+#include <limits>
+#include <ostream>
+#include <sstream>
+#include <utility>
+#include <vector>
+
+namespace SMathLib {
+;
+
+// the magic string which starts every .npy file.
+static const char   gcNpyMagic[]     = "\x93NUMPY";
+static const size_t gcNpyMagicLength = 6;
+
+// the header (including the magic string) is padded to a multiple of this so
+// that the elements are aligned for mapping.
+static const size_t gcNpyAlignment = 64;
+
+// largest header length which fits in a version 1.0 file.
+static const size_t gcNpyMaxHeaderV1 = 65535;
+
+
+// header.
+// ------------------------------------------------------------------------- //
+static bool IsLittleEndian()
+{
+	const uint16_t _one = 1;
+	return *reinterpret_cast<const uint8_t*>(&_one) == 1;
+}
+
+// the fields of a .npy header which are used here.
+struct NpyHeader
+{
+	char   byteOrder;       // '<', '>' or '|'.
+	char   kind;            // 'f' or 'i'.
+	size_t itemSize;
+	bool   fortranOrder;
+	size_t rows;
+	size_t cols;
+	size_t dataOffset;      // number of bytes before the elements.
+	
+	inline size_t NumElements() const {return rows*cols;}
+	inline bool IsNative() const
+	{
+		return itemSize == 1 || byteOrder == '|' || (byteOrder == '<') == IsLittleEndian();
+	}
+};
+
+static void ThrowInvalidNpy(const char* what)
+{
+	std::string _msg = std::string("Invalid .npy file (") + what + ") in glLoadNpy";
+	throw SUtils::Exceptions::InvalidArgumentException(_msg.c_str());
+}
+
+// find the value of a key in the header dictionary, the value starts after
+// the colon following the key.
+static size_t FindNpyValue(const std::string& dict, const char* key)
+{
+	const std::string _key1 = std::string("'") + key + "'";
+	const std::string _key2 = std::string("\"") + key + "\"";
+	size_t _pos = dict.find(_key1);
+	if(_pos == std::string::npos)
+	{
+		_pos = dict.find(_key2);
+	}
+	if(_pos == std::string::npos)
+	{
+		ThrowInvalidNpy(key);
+	}
+	_pos = dict.find(':', _pos + _key1.size());
+	if(_pos == std::string::npos)
+	{
+		ThrowInvalidNpy(key);
+	}
+	_pos = dict.find_first_not_of(" \t", _pos+1);
+	if(_pos == std::string::npos)
+	{
+		ThrowInvalidNpy(key);
+	}
+	return _pos;
+}
+
+// parse the dictionary of a .npy header.
+static void ParseNpyDict(const std::string& dict, NpyHeader& header)
+{
+	// element type, e.g. '<f8'.
+	size_t _pos = FindNpyValue(dict, "descr");
+	const char _quote = dict[_pos];
+	const size_t _end = dict.find(_quote, _pos+1);
+	if((_quote != '\'' && _quote != '"') || _end == std::string::npos || _end - _pos < 4)
+	{
+		ThrowInvalidNpy("descr");
+	}
+	const std::string _descr = dict.substr(_pos+1, _end-_pos-1);
+	header.byteOrder = _descr[0];
+	header.kind      = _descr[1];
+	header.itemSize  = size_t(std::atoi(_descr.c_str()+2));
+	if((header.byteOrder != '<' && header.byteOrder != '>' && header.byteOrder != '|') ||
+	   !((header.kind == 'f' && (header.itemSize == 4 || header.itemSize == 8)) ||
+	     (header.kind == 'i' && (header.itemSize == 4 || header.itemSize == 8))))
+	{
+		ThrowInvalidNpy("unsupported descr");
+	}
+	
+	// memory order.
+	_pos = FindNpyValue(dict, "fortran_order");
+	if(dict.compare(_pos, 4, "True") == 0)
+	{
+		header.fortranOrder = true;
+	}
+	else if(dict.compare(_pos, 5, "False") == 0)
+	{
+		header.fortranOrder = false;
+	}
+	else
+	{
+		ThrowInvalidNpy("fortran_order");
+	}
+	
+	// shape, a tuple of up to two dimensions.
+	_pos = FindNpyValue(dict, "shape");
+	const size_t _close = dict.find(')', _pos);
+	if(dict[_pos] != '(' || _close == std::string::npos)
+	{
+		ThrowInvalidNpy("shape");
+	}
+	std::vector<size_t> _shape;
+	std::istringstream  _tuple(dict.substr(_pos+1, _close-_pos-1));
+	std::string         _dim;
+	while(std::getline(_tuple, _dim, ','))
+	{
+		const size_t _first = _dim.find_first_not_of(" \t");
+		if(_first == std::string::npos)
+		{
+			continue;
+		}
+		char* _last = nullptr;
+		const unsigned long long _n = std::strtoull(_dim.c_str()+_first, &_last, 10);
+		if(_last == _dim.c_str()+_first || _dim.find_first_not_of(" \tL", size_t(_last-_dim.c_str())) != std::string::npos)
+		{
+			ThrowInvalidNpy("shape");
+		}
+		_shape.push_back(size_t(_n));
+	}
+	if(_shape.size() > 2)
+	{
+		ThrowInvalidNpy("more than 2 dimensions");
+	}
+	header.rows = _shape.size() > 0 ? _shape[0] : 1;
+	header.cols = _shape.size() > 1 ? _shape[1] : 1;
+	if(header.cols != 0 && header.rows > std::numeric_limits<size_t>::max() / header.cols / header.itemSize)
+	{
+		ThrowInvalidNpy("shape too large");
+	}
+}
+
+// read and parse the header, read(buffer, count) reads the next count bytes
+// of the file and returns false if there are not enough.
+template<typename ReadFunc>
+static NpyHeader ReadNpyHeader(const ReadFunc& read)
+{
+	unsigned char _preamble[12];
+	if(!read(reinterpret_cast<char*>(_preamble), 8) || std::memcmp(_preamble, gcNpyMagic, gcNpyMagicLength) != 0)
+	{
+		ThrowInvalidNpy("bad magic string");
+	}
+	
+	// version 1.0 stores the header length in 2 bytes, 2.0 and 3.0 in 4 bytes.
+	const unsigned char _major = _preamble[6];
+	size_t _headerLength = 0;
+	size_t _preambleLength = 0;
+	if(_major == 1)
+	{
+		if(!read(reinterpret_cast<char*>(_preamble+8), 2))
+		{
+			ThrowInvalidNpy("truncated header");
+		}
+		_headerLength   = size_t(_preamble[8]) | (size_t(_preamble[9]) << 8);
+		_preambleLength = 10;
+	}
+	else if(_major == 2 || _major == 3)
+	{
+		if(!read(reinterpret_cast<char*>(_preamble+8), 4))
+		{
+			ThrowInvalidNpy("truncated header");
+		}
+		_headerLength = size_t(_preamble[8]) | (size_t(_preamble[9]) << 8) |
+		                (size_t(_preamble[10]) << 16) | (size_t(_preamble[11]) << 24);
+		_preambleLength = 12;
+	}
+	else
+	{
+		ThrowInvalidNpy("unsupported version");
+	}
+	
+	std::string _dict(_headerLength, '\0');
+	if(_headerLength > 0 && !read(&_dict[0], _headerLength))
+	{
+		ThrowInvalidNpy("truncated header");
+	}
+	
+	NpyHeader _header;
+	ParseNpyDict(_dict, _header);
+	_header.dataOffset = _preambleLength + _headerLength;
+	return _header;
+}
+
+static std::string MakeNpyHeader(size_t rows, size_t cols)
+{
+	std::ostringstream _dict;
+	_dict << "{'descr': '" << (IsLittleEndian() ? '<' : '>') << "f8', 'fortran_order': False, 'shape': ("
+	      << rows << ", " << cols << "), }";
+	std::string _header = _dict.str();
+	
+	// pad with spaces and terminate with a newline so that the elements start
+	// at a multiple of gcNpyAlignment.
+	const bool   _v1       = _header.size() + gcNpyAlignment <= gcNpyMaxHeaderV1;
+	const size_t _preamble = gcNpyMagicLength + (_v1 ? 4 : 6);
+	const size_t _pad      = (gcNpyAlignment - (_preamble + _header.size() + 1) % gcNpyAlignment) % gcNpyAlignment;
+	_header.append(_pad, ' ');
+	_header.push_back('\n');
+	
+	std::string _out(gcNpyMagic, gcNpyMagicLength);
+	_out.push_back(_v1 ? char(1) : char(2));
+	_out.push_back(char(0));
+	const size_t _length = _header.size();
+	_out.push_back(char(_length & 0xff));
+	_out.push_back(char((_length >> 8) & 0xff));
+	if(!_v1)
+	{
+		_out.push_back(char((_length >> 16) & 0xff));
+		_out.push_back(char((_length >> 24) & 0xff));
+	}
+	return _out + _header;
+}
+// ------------------------------------------------------------------------- //
+
+
+// element conversion.
+// ------------------------------------------------------------------------- //
+template<typename T>
+static void ConvertNpyElements(const char* raw, size_t count, bool swap, double* out)
+{
+	for(size_t i=0 ; i<count ; ++i)
+	{
+		char _bytes[sizeof(T)];
+		std::memcpy(_bytes, raw + i*sizeof(T), sizeof(T));
+		if(swap)
+		{
+			std::reverse(_bytes, _bytes + sizeof(T));
+		}
+		T _value;
+		std::memcpy(&_value, _bytes, sizeof(T));
+		out[i] = double(_value);
+	}
+}
+
+static void ConvertNpyElements(const NpyHeader& header, const char* raw, size_t count, double* out)
+{
+	const bool _swap = !header.IsNative();
+	if(header.kind == 'f' && header.itemSize == 8)
+	{
+		ConvertNpyElements<double>(raw, count, _swap, out);
+	}
+	else if(header.kind == 'f')
+	{
+		ConvertNpyElements<float>(raw, count, _swap, out);
+	}
+	else if(header.itemSize == 8)
+	{
+		ConvertNpyElements<int64_t>(raw, count, _swap, out);
+	}
+	else
+	{
+		ConvertNpyElements<int32_t>(raw, count, _swap, out);
+	}
+}
+// ------------------------------------------------------------------------- //
+
+
+// save and load.
+// ------------------------------------------------------------------------- //
+void glSaveNpy(std::ostream& out, const ConstMatrixView& A)
+{
+	const std::string _header = MakeNpyHeader(A.Rows(), A.Cols());
+	out.write(_header.data(), std::streamsize(_header.size()));
+	
+	if(A.IsContiguous())
+	{
+		out.write(reinterpret_cast<const char*>(A.Data()), std::streamsize(A.Rows()*A.Cols()*sizeof(double)));
+	}
+	else
+	{
+		std::vector<double> _row(A.Cols());
+		for(size_t i=0 ; i<A.Rows() ; ++i)
+		{
+			for(size_t j=0 ; j<A.Cols() ; ++j)
+			{
+				_row[j] = A(i, j);
+			}
+			out.write(reinterpret_cast<const char*>(_row.data()), std::streamsize(_row.size()*sizeof(double)));
+		}
+	}
+	
+	if(!out)
+	{
+		char _msg[] = "Failed to write the matrix in glSaveNpy";
+		throw SUtils::Exceptions::InvalidOperationException(_msg);
+	}
+}
+
+void glSaveNpy(const std::string& fileName, const ConstMatrixView& A)
+{
+	std::ofstream _out(fileName.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+	if(!_out)
+	{
+		std::string _msg = "Unable to open " + fileName + " in glSaveNpy";
+		throw SUtils::Exceptions::InvalidOperationException(_msg.c_str());
+	}
+	glSaveNpy(_out, A);
+}
+
+Matrix glLoadNpy(std::istream& in)
+{
+	const NpyHeader _header = ReadNpyHeader([&in](char* buffer, size_t count) -> bool
+	{
+		return bool(in.read(buffer, std::streamsize(count)));
+	});
+	
+	const size_t _count = _header.NumElements();
+	Matrix _A(_header.rows, _header.cols, MatrixType::Null);
+	
+	// native float64 in C order is read straight into the matrix, everything
+	// else is converted through a buffer.
+	bool _ok = true;
+	if(_header.kind == 'f' && _header.itemSize == 8 && _header.IsNative() && !_header.fortranOrder)
+	{
+		_ok = _count == 0 || bool(in.read(reinterpret_cast<char*>(_A.matrix), std::streamsize(_count*sizeof(double))));
+	}
+	else
+	{
+		std::vector<char> _raw(_count*_header.itemSize);
+		_ok = _count == 0 || bool(in.read(_raw.data(), std::streamsize(_raw.size())));
+		if(_ok && !_header.fortranOrder)
+		{
+			ConvertNpyElements(_header, _raw.data(), _count, _A.matrix);
+		}
+		else if(_ok)
+		{
+			std::vector<double> _colMajor(_count);
+			ConvertNpyElements(_header, _raw.data(), _count, _colMajor.data());
+			for(size_t j=0 ; j<_header.cols ; ++j)
+			{
+				for(size_t i=0 ; i<_header.rows ; ++i)
+				{
+					_A.matrix[i*_header.cols+j] = _colMajor[j*_header.rows+i];
+				}
+			}
+		}
+	}
+	if(!_ok)
+	{
+		ThrowInvalidNpy("truncated data");
+	}
+	return _A;
+}
+
+Matrix glLoadNpy(const std::string& fileName)
+{
+	std::ifstream _in(fileName.c_str(), std::ios::in | std::ios::binary);
+	if(!_in)
+	{
+		std::string _msg = "Unable to open " + fileName + " in glLoadNpy";
+		throw SUtils::Exceptions::InvalidOperationException(_msg.c_str());
+	}
+	return glLoadNpy(_in);
+}
+// ------------------------------------------------------------------------- //
+
+
+// mapped matrix.
+// ------------------------------------------------------------------------- //
+struct MappedMatrixPriv
+{
+	MappedMatrixPriv() : data(nullptr), rows(0), cols(0), fortranOrder(false)
+	{}
+	
+	MappedFile    file;
+	const double* data;
+	size_t        rows;
+	size_t        cols;
+	bool          fortranOrder;
+};
+
+MappedMatrix::MappedMatrix()
+	: mPriv(new MappedMatrixPriv())
+{}
+
+MappedMatrix::MappedMatrix(const std::string& fileName)
+	: mPriv(new MappedMatrixPriv())
+{
+	Open(fileName);
+}
+
+MappedMatrix::MappedMatrix(MappedMatrix&& B)
+	: mPriv(B.mPriv)
+{
+	B.mPriv = new MappedMatrixPriv();
+}
+
+MappedMatrix& MappedMatrix::operator=(MappedMatrix&& B)
+{
+	std::swap(mPriv, B.mPriv);
+	return *this;
+}
+
+MappedMatrix::~MappedMatrix()
+{
+	delete mPriv;
+}
+
+void MappedMatrix::Open(const std::string& fileName)
+{
+	Close();
+	
+	// parse the header from the mapping.
+	MappedFile  _file;
+	_file.Open(fileName);
+	size_t _offset = 0;
+	const NpyHeader _header = ReadNpyHeader([&_file, &_offset](char* buffer, size_t count) -> bool
+	{
+		if(_offset + count > _file.Size())
+		{
+			return false;
+		}
+		std::memcpy(buffer, _file.Data() + _offset, count);
+		_offset += count;
+		return true;
+	});
+	
+	if(_header.kind != 'f' || _header.itemSize != sizeof(double) || !_header.IsNative())
+	{
+		char _msg[] = "Only native float64 .npy files can be mapped in MappedMatrix::Open";
+		throw SUtils::Exceptions::InvalidArgumentException(_msg);
+	}
+	if(_header.dataOffset % sizeof(double) != 0)
+	{
+		char _msg[] = "Misaligned .npy data in MappedMatrix::Open";
+		throw SUtils::Exceptions::InvalidArgumentException(_msg);
+	}
+	if(_header.NumElements()*sizeof(double) > _file.Size() - _header.dataOffset)
+	{
+		ThrowInvalidNpy("truncated data");
+	}
+	
+	mPriv->data         = reinterpret_cast<const double*>(_file.Data() + _header.dataOffset);
+	mPriv->rows         = _header.rows;
+	mPriv->cols         = _header.cols;
+	mPriv->fortranOrder = _header.fortranOrder;
+	mPriv->file         = std::move(_file);
+}
+
+void MappedMatrix::Close()
+{
+	*mPriv = MappedMatrixPriv();
+}
+
+bool MappedMatrix::IsOpen() const
+{
+	return mPriv->file.IsOpen();
+}
+
+size_t MappedMatrix::Rows() const
+{
+	return mPriv->rows;
+}
+
+size_t MappedMatrix::Cols() const
+{
+	return mPriv->cols;
+}
+
+ConstMatrixView MappedMatrix::View() const
+{
+	if(mPriv->fortranOrder)
+	{
+		return ConstMatrixView(mPriv->data, mPriv->rows, mPriv->cols, 1, mPriv->rows);
+	}
+	return ConstMatrixView(mPriv->data, mPriv->rows, mPriv->cols, mPriv->cols, 1);
+}
+
+Matrix MappedMatrix::ToMatrix() const
+{
+	return Matrix(View());
+}
+// ------------------------------------------------------------------------- //
+
+};	// End namespace SMathLib.
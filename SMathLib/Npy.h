@@ -0,0 +1,96 @@
+// 
+// This file is part of SLogLib; you can redistribute it and/or 
+// modify it under the terms of the MIT License.
+// Author: Saurabh Garg (saurabhgarg@mysoc.net)
+// 
+
+#ifndef _SMATHLIB_NPY_H_
+#define _SMATHLIB_NPY_H_
+
+#include "SMathLib/Config.h"
+#include "SMathLib/Matrix.h"
+#include "SMathLib/MatrixView.h"
+#include <iosfwd>
+#include <string>
+
+namespace SMathLib {
+;
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+// Binary matrix files in the NumPy .npy format: a short text header with the
+// element type, the memory order and the shape, followed by the raw elements.
+// The files can be exchanged with numpy.save() and numpy.load(). Matrices are
+// saved as row-major float64 arrays of shape (rows, cols).
+//
+// Files which can't be opened throw SUtils::Exceptions::InvalidOperationException,
+// malformed or unsupported files throw SUtils::Exceptions::InvalidArgumentException.
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+//! Save a matrix or a view as a float64 .npy file. Version 1.0 of the format
+//! is written, or version 2.0 if the header does not fit in 1.0.
+SMATHLIB_DLL_API void glSaveNpy(const std::string& fileName, const ConstMatrixView& A);
+SMATHLIB_DLL_API void glSaveNpy(std::ostream& out, const ConstMatrixView& A);
+
+//! Load a .npy file of version 1.0, 2.0 or 3.0 into a matrix. float64,
+//! float32, int32 and int64 elements of either byte order and both C and
+//! Fortran order are accepted. A 1D array of size n is loaded as a n x 1
+//! column vector and a 0D array as a 1 x 1 matrix.
+SMATHLIB_DLL_API Matrix glLoadNpy(const std::string& fileName);
+SMATHLIB_DLL_API Matrix glLoadNpy(std::istream& in);
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+struct MappedMatrixPriv;
+
+//! A read-only matrix backed by a memory-mapped .npy file. Opening the file
+//! only reads the header, the elements are paged in by the operating system
+//! when they are accessed, so very large files open instantly. The elements
+//! must be float64 in the native byte order; Fortran order files are exposed
+//! through a view with swapped strides. The mapping is released when the
+//! MappedMatrix is destroyed, views obtained from it must not outlive it.
+//!
+//!     MappedMatrix    _file("A.npy");
+//!     ConstMatrixView _A = _file.View();
+//!     double          _det = _A.Determinant();
+class SMATHLIB_DLL_API MappedMatrix
+{
+public:  // Constructors.
+
+	MappedMatrix();
+	explicit MappedMatrix(const std::string& fileName);
+	MappedMatrix(MappedMatrix&& B);
+	MappedMatrix& operator=(MappedMatrix&& B);
+	~MappedMatrix();
+	
+	MappedMatrix(const MappedMatrix&) = delete;
+	MappedMatrix& operator=(const MappedMatrix&) = delete;
+
+public:  // Mapping.
+
+	//! Map a file, unmapping the previous one.
+	void Open(const std::string& fileName);
+	void Close();
+	bool IsOpen() const;
+
+public:  // Elements.
+
+	size_t          Rows() const;
+	size_t          Cols() const;
+	ConstMatrixView View() const;
+	inline operator ConstMatrixView() const {return View();}
+	
+	//! Copy the elements into a Matrix.
+	Matrix ToMatrix() const;
+
+private:
+
+	MappedMatrixPriv* mPriv;
+};
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+
+};	// End namespace SMathLib.
+
+#endif // _SMATHLIB_NPY_H_
@@ -0,0 +1,259 @@
+// 
+// This file is part of SLogLib; you can redistribute it and/or 
+// modify it under the terms of the MIT License.
+// Author: Saurabh Garg (saurabhgarg@mysoc.net)
+// 
+
+#include "Parallel.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace SMathLib {
+;
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+// A pool of worker threads which execute the tasks of one parallel loop at a
+// time. The calling thread also executes tasks, so a loop with N threads only
+// needs N-1 workers. The workers are created when first needed. An exception
+// thrown by a task is caught on the thread which executed it, the remaining
+// tasks are skipped and the first exception is rethrown by Run().
+class ThreadPool
+{
+public:
+
+	ThreadPool()
+		: mTask(nullptr), mNumTasks(0), mNextTask(0), mPending(0), mActive(0), mGeneration(0), mStop(false),
+		  mFailed(false)
+	{}
+	
+	~ThreadPool()
+	{
+		{
+			std::lock_guard<std::mutex> _lock(mMutex);
+			mStop = true;
+		}
+		mWakeUp.notify_all();
+		for(size_t i=0 ; i<mWorkers.size() ; ++i)
+		{
+			mWorkers[i].join();
+		}
+	}
+	
+	// Execute task(i) for i in [0, numTasks) using at most numThreads threads.
+	void Run(size_t numTasks, unsigned int numThreads, const std::function<void(size_t)>& task)
+	{
+		// Only one loop can use the pool at a time; nested loops and loops
+		// started while the pool is busy are executed serially.
+		std::unique_lock<std::mutex> _runLock(mRunMutex, std::try_to_lock);
+		if(!_runLock.owns_lock() || smInsideTask)
+		{
+			for(size_t i=0 ; i<numTasks ; ++i)
+			{
+				task(i);
+			}
+			return;
+		}
+		
+		{
+			// A worker which woke up late for the previous loop may still be
+			// looking at its tasks.
+			std::unique_lock<std::mutex> _lock(mMutex);
+			mDone.wait(_lock, [this]() { return mActive == 0; });
+
+			while(mWorkers.size()+1 < numThreads)
+			{
+				mWorkers.push_back(std::thread(&ThreadPool::WorkerLoop, this));
+			}
+			
+			mTask      = &task;
+			mNumTasks  = numTasks;
+			mNextTask  = 0;
+			mPending   = numTasks;
+			mFailed    = false;
+			mException = nullptr;
+			++mGeneration;
+		}
+		mWakeUp.notify_all();
+		
+		const size_t _done = ExecuteTasks();
+		
+		// Wait for the tasks executed by the workers, and for all the workers
+		// which woke up for this loop to leave it; task is then no longer used
+		// and the exception of a task can be rethrown.
+		std::unique_lock<std::mutex> _lock(mMutex);
+		mPending -= _done;
+		mDone.wait(_lock, [this]() { return mPending == 0 && mActive == 0; });
+		mTask = nullptr;
+		
+		std::exception_ptr _exception = mException;
+		mException = nullptr;
+		_lock.unlock();
+		if(_exception)
+		{
+			std::rethrow_exception(_exception);
+		}
+	}
+
+private:
+
+	void WorkerLoop()
+	{
+		size_t _generation = 0;
+		for(;;)
+		{
+			{
+				std::unique_lock<std::mutex> _lock(mMutex);
+				mWakeUp.wait(_lock, [&]() { return mStop || mGeneration != _generation; });
+				if(mStop)
+				{
+					return;
+				}
+				_generation = mGeneration;
+				++mActive;
+			}
+			
+			const size_t _done = ExecuteTasks();
+			
+			std::lock_guard<std::mutex> _lock(mMutex);
+			mPending -= _done;
+			--mActive;
+			if(mPending == 0 && mActive == 0)
+			{
+				mDone.notify_all();
+			}
+		}
+	}
+	
+	// Execute tasks until there are none left and return the number claimed.
+	// Never throws: the first exception of a task is stored and the tasks
+	// claimed after it are skipped.
+	size_t ExecuteTasks()
+	{
+		struct InsideTask
+		{
+			bool mPrevious;
+			InsideTask()  : mPrevious(smInsideTask) {smInsideTask = true;}
+			~InsideTask() {smInsideTask = mPrevious;}
+		} _inside;
+		
+		size_t _done = 0;
+		for(;;)
+		{
+			const size_t i = mNextTask.fetch_add(1);
+			if(i >= mNumTasks)
+			{
+				break;
+			}
+			++_done;
+			if(mFailed)
+			{
+				continue;
+			}
+			try
+			{
+				(*mTask)(i);
+			}
+			catch(...)
+			{
+				std::lock_guard<std::mutex> _lock(mMutex);
+				if(!mException)
+				{
+					mException = std::current_exception();
+				}
+				mFailed = true;
+			}
+		}
+		return _done;
+	}
+
+private:
+
+	std::vector<std::thread>             mWorkers;
+	std::mutex                           mRunMutex;
+	std::mutex                           mMutex;
+	std::condition_variable              mWakeUp;
+	std::condition_variable              mDone;
+	const std::function<void(size_t)>*   mTask;
+	size_t                               mNumTasks;
+	std::atomic<size_t>                  mNextTask;
+	size_t                               mPending;
+	size_t                               mActive;
+	size_t                               mGeneration;
+	bool                                 mStop;
+	std::atomic<bool>                    mFailed;
+	std::exception_ptr                   mException;
+	
+	static thread_local bool             smInsideTask;
+};
+
+thread_local bool ThreadPool::smInsideTask = false;
+
+static ThreadPool& GetThreadPool()
+{
+	static ThreadPool _pool;
+	return _pool;
+}
+
+static std::atomic<unsigned int> gNumThreads(1);
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+void glSetNumThreads(unsigned int numThreads)
+{
+	if(numThreads == 0)
+	{
+		numThreads = std::max(1u, std::thread::hardware_concurrency());
+	}
+	gNumThreads = numThreads;
+}
+
+unsigned int glGetNumThreads()
+{
+	return gNumThreads;
+}
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+void glParallelFor(size_t begin, size_t end, size_t grain,
+                   const std::function<void(size_t, size_t)>& func,
+                   unsigned int numThreads)
+{
+	if(end <= begin)
+	{
+		return;
+	}
+	
+	if(numThreads == 0)
+	{
+		numThreads = glGetNumThreads();
+	}
+	
+	// Split the range into equal contiguous chunks, one per thread.
+	const size_t _count     = end - begin;
+	const size_t _maxChunks = (_count + std::max<size_t>(grain, 1) - 1) / std::max<size_t>(grain, 1);
+	const size_t _numChunks = std::min<size_t>(numThreads, _maxChunks);
+	if(_numChunks <= 1)
+	{
+		func(begin, end);
+		return;
+	}
+	
+	const size_t _chunk = _count / _numChunks;
+	const size_t _extra = _count % _numChunks;
+	GetThreadPool().Run(_numChunks, (unsigned int)_numChunks, [&](size_t i)
+	{
+		const size_t _b = begin + i*_chunk + std::min(i, _extra);
+		const size_t _e = _b + _chunk + (i < _extra ? 1 : 0);
+		func(_b, _e);
+	});
+}
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+
+};	// End namespace SMathLib.
@@ -0,0 +1,43 @@
+// 
+// This file is part of SLogLib; you can redistribute it and/or 
+// modify it under the terms of the MIT License.
+// Author: Saurabh Garg (saurabhgarg@mysoc.net)
+// 
+
+#ifndef _SMATHLIB_PARALLEL_H_
+#define _SMATHLIB_PARALLEL_H_
+
+#include "SMathLib/Config.h"
+#include <cstddef>
+#include <functional>
+
+namespace SMathLib {
+;
+
+//! Set the number of threads used by the parallel operations of the library.
+//! \param numThreads The number of threads, 0 means one thread per core.
+//! The default is 1, i.e. all the operations run on the calling thread.
+SMATHLIB_DLL_API void glSetNumThreads(unsigned int numThreads);
+
+//! Get the number of threads used by the parallel operations of the library.
+SMATHLIB_DLL_API unsigned int glGetNumThreads();
+
+//! Execute func over the range [begin, end) using several threads.
+//! \param begin First index of the range.
+//! \param end One past the last index of the range.
+//! \param grain Minimum number of indices processed by one thread.
+//! \param func Function called as func(b, e) for each sub-range [b, e).
+//! \param numThreads Number of threads to use, 0 means use glGetNumThreads().
+//! The range is split into contiguous sub-ranges which only depend on the size
+//! of the range, the grain and the number of threads, so an operation which
+//! writes disjoint outputs per sub-range gives the same result on every run.
+//! Calls from inside func run serially on the calling thread. If func throws,
+//! the sub-ranges which have not started are skipped and the first exception
+//! is rethrown on the calling thread once all the threads have finished.
+SMATHLIB_DLL_API void glParallelFor(size_t begin, size_t end, size_t grain,
+                                    const std::function<void(size_t, size_t)>& func,
+                                    unsigned int numThreads = 0);
+
+};	// End namespace SMathLib.
+
+#endif // _SMATHLIB_PARALLEL_H_
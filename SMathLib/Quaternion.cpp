@@ -284,43 +284,51 @@ void Quaternion::SetAxisAngle(const Vector3& axis, double angle)
 //! images by the rotation of the three vectors of an orthogonal basis. 
 //! Note that OpenGL uses a symmetric representation for its matrices.
 void Quaternion::SetRotationMatrix(const double rotMat[3][3])
+{
+	SetRotationMatrix(Matrix3(&rotMat[0][0]));
+}
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+void Quaternion::SetRotationMatrix(const Matrix3& rotMat)
 {
 	// Compute one plus the trace of the matrix
-	double _onePlusTrace = 1.0 + rotMat[0][0] + rotMat[1][1] + rotMat[2][2];
+	double _onePlusTrace = 1.0 + rotMat(0, 0) + rotMat(1, 1) + rotMat(2, 2);
 	
 	if(_onePlusTrace > 1E-5)
 	{
 		double s = sqrt(_onePlusTrace) * 2.0;
-		mQuaternion[0] = (rotMat[2][1] - rotMat[1][2]) / s;
-		mQuaternion[1] = (rotMat[0][2] - rotMat[2][0]) / s;
-		mQuaternion[2] = (rotMat[1][0] - rotMat[0][1]) / s;
+		mQuaternion[0] = (rotMat(2, 1) - rotMat(1, 2)) / s;
+		mQuaternion[1] = (rotMat(0, 2) - rotMat(2, 0)) / s;
+		mQuaternion[2] = (rotMat(1, 0) - rotMat(0, 1)) / s;
 		mQuaternion[3] = 0.25 * s;
 	}
 	else
 	{
-		if((rotMat[0][0] > rotMat[1][1])&(rotMat[0][0] > rotMat[2][2]))
+		if((rotMat(0, 0) > rotMat(1, 1))&(rotMat(0, 0) > rotMat(2, 2)))
 		{ 
-			double s = sqrt(1.0 + rotMat[0][0] - rotMat[1][1] - rotMat[2][2]) * 2.0; 
+			double s = sqrt(1.0 + rotMat(0, 0) - rotMat(1, 1) - rotMat(2, 2)) * 2.0; 
 			mQuaternion[0] = 0.25 * s;
-			mQuaternion[1] = (rotMat[0][1] + rotMat[1][0]) / s; 
-			mQuaternion[2] = (rotMat[0][2] + rotMat[2][0]) / s; 
-			mQuaternion[3] = (rotMat[1][2] - rotMat[2][1]) / s;
+			mQuaternion[1] = (rotMat(0, 1) + rotMat(1, 0)) / s; 
+			mQuaternion[2] = (rotMat(0, 2) + rotMat(2, 0)) / s; 
+			mQuaternion[3] = (rotMat(1, 2) - rotMat(2, 1)) / s;
 		}
-		else if(rotMat[1][1] > rotMat[2][2])
+		else if(rotMat(1, 1) > rotMat(2, 2))
 		{ 
-			double s = sqrt(1.0 + rotMat[1][1] - rotMat[0][0] - rotMat[2][2]) * 2.0; 
-			mQuaternion[0] = (rotMat[0][1] + rotMat[1][0]) / s; 
+			double s = sqrt(1.0 + rotMat(1, 1) - rotMat(0, 0) - rotMat(2, 2)) * 2.0; 
+			mQuaternion[0] = (rotMat(0, 1) + rotMat(1, 0)) / s; 
 			mQuaternion[1] = 0.25 * s;
-			mQuaternion[2] = (rotMat[1][2] + rotMat[2][1]) / s; 
-			mQuaternion[3] = (rotMat[0][2] - rotMat[2][0]) / s;
+			mQuaternion[2] = (rotMat(1, 2) + rotMat(2, 1)) / s; 
+			mQuaternion[3] = (rotMat(0, 2) - rotMat(2, 0)) / s;
 		}
 		else
 		{ 
-			double s = sqrt(1.0 + rotMat[2][2] - rotMat[0][0] - rotMat[1][1]) * 2.0; 
-			mQuaternion[0] = (rotMat[0][2] + rotMat[2][0]) / s; 
-			mQuaternion[1] = (rotMat[1][2] + rotMat[2][1]) / s; 
+			double s = sqrt(1.0 + rotMat(2, 2) - rotMat(0, 0) - rotMat(1, 1)) * 2.0; 
+			mQuaternion[0] = (rotMat(0, 2) + rotMat(2, 0)) / s; 
+			mQuaternion[1] = (rotMat(1, 2) + rotMat(2, 1)) / s; 
 			mQuaternion[2] = 0.25 * s;
-			mQuaternion[3] = (rotMat[0][1] - rotMat[1][0]) / s;
+			mQuaternion[3] = (rotMat(0, 1) - rotMat(1, 0)) / s;
 		}
 	}
 	
@@ -332,16 +340,16 @@ void Quaternion::SetRotationMatrix(const double rotMat[3][3])
 // ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
 void Quaternion::SetRotatedBasis(const Vector3& X, const Vector3& Y, const Vector3& Z)
 {
-	double _rotMat[3][3];
-	double _normX = glVectorMagnitude(X, 3);
+	Matrix3 _rotMat;
+	double  _normX = glVectorMagnitude(X, 3);
 	double _normY = glVectorMagnitude(Y, 3);
 	double _normZ = glVectorMagnitude(Z, 3);
 	
 	for(int i=0; i<3; ++i)
 	{
-		_rotMat[i][0] = X[i]/_normX;
-		_rotMat[i][1] = Y[i]/_normY;
-		_rotMat[i][2] = Z[i]/_normZ;
+		_rotMat(i, 0) = X[i]/_normX;
+		_rotMat(i, 1) = Y[i]/_normY;
+		_rotMat(i, 2) = Z[i]/_normZ;
 	}
 	
 	SetRotationMatrix(_rotMat);
@@ -465,6 +473,42 @@ void Quaternion::GetInverseRotationMatrix(double rotMat[9]) const
 // ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
 
 
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+Quaternion::Matrix4 Quaternion::GetMatrix() const
+{
+	Matrix4 _rotMat;
+	GetMatrix(_rotMat.Data());
+	return _rotMat;
+}
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+Quaternion::Matrix3 Quaternion::GetRotationMatrix() const
+{
+	Matrix3 _rotMat;
+	GetRotationMatrix(_rotMat.Data());
+	return _rotMat;
+}
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+Quaternion::Matrix4 Quaternion::GetInverseMatrix() const
+{
+	return Inverse().GetMatrix();
+}
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+Quaternion::Matrix3 Quaternion::GetInverseRotationMatrix() const
+{
+	return Inverse().GetRotationMatrix();
+}
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+
+
 // ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
 Quaternion Quaternion::Slerp(const Quaternion& q1, const Quaternion& q2, 
 							 double time, bool allowFlip)
@@ -9,6 +9,7 @@
 
 #include "SMathLib/Config.h"
 #include "SMathLib/VectorOnStack.h"
+#include "SMathLib/FixedMatrix.h"
 
 namespace SMathLib {
 ;
@@ -21,6 +22,10 @@ public:
 	//! Define a type for vector.
 	typedef VectorOnStackD3 Vector3;
 	
+	//! Define types for the rotation matrices.
+	typedef FixedMatrixD3 Matrix3;
+	typedef FixedMatrixD4 Matrix4;
+	
 	//! Define type of elements stores.
 	typedef double value_type;
 	
@@ -56,6 +61,7 @@ public:  // Initialize quaternion from other representations.
 	
 	void SetAxisAngle(const Vector3& axis, double angle);
 	void SetRotationMatrix(const double rotationMatrix[3][3]);
+	void SetRotationMatrix(const Matrix3& rotationMatrix);
 	void SetRotatedBasis(const Vector3& X, const Vector3& Y, const Vector3& Z);
 	
 public:  // Convert quaternion to other representations.
@@ -70,6 +76,11 @@ public:  // Convert quaternion to other representations.
 	void GetInverseMatrix(double matrix[16]) const;
 	void GetInverseRotationMatrix(double matrix[9]) const;
 	
+	Matrix4 GetMatrix() const;
+	Matrix3 GetRotationMatrix() const;
+	Matrix4 GetInverseMatrix() const;
+	Matrix3 GetInverseRotationMatrix() const;
+	
 public:  // Spherical linear interpolation between two quaternions.
 	
 	static Quaternion Slerp(const Quaternion& q1, const Quaternion& q2, 
@@ -0,0 +1,607 @@
+// 
+// This file is part of SLogLib; you can redistribute it and/or 
+// modify it under the terms of the MIT License.
+// Author: Saurabh Garg (saurabhgarg@mysoc.net)
+// 
+
+#include "Reduce.h"
+#include "Parallel.h"
+#include "SUtils/Exceptions/InvalidArgumentException.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace SMathLib {
+;
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+// Number of independent accumulators in the inner loops.
+static const size_t gcLanes = 8;
+
+// Number of elements summed directly at the leaves of the pairwise summation.
+static const size_t gcPairwiseBlock = 128;
+
+// Number of interleaved vectors accumulated together, their accumulators stay
+// in L1 cache while streaming over the elements.
+static const size_t gcPanel = 512;
+
+// Length of the pieces a contiguous matrix is split into for ReduceAxis::All.
+static const size_t gcAllBlock = 65536;
+
+// Minimum number of elements reduced by a thread.
+static const size_t gcParallelGrain = 32768;
+
+static const double gcNaN = std::numeric_limits<double>::quiet_NaN();
+
+// transformations applied to the elements before they are accumulated.
+struct Identity
+{
+	double operator ()(double x) const {return x;}
+};
+struct Square
+{
+	double operator ()(double x) const {return x*x;}
+};
+struct Abs
+{
+	double operator ()(double x) const {return std::fabs(x);}
+};
+
+// operations combining the elements of the extremum reductions.
+struct MinOp
+{
+	static double Init() {return std::numeric_limits<double>::infinity();}
+	double operator ()(double a, double b) const {return b < a ? b : a;}
+};
+struct MaxOp
+{
+	static double Init() {return -std::numeric_limits<double>::infinity();}
+	double operator ()(double a, double b) const {return b > a ? b : a;}
+};
+
+// count vectors of n elements, element i of vector j is at
+// data[j*vecStride + i*elemStride]. The last vector has lastN elements. The
+// elements are accumulated in double whatever their type.
+template<typename T>
+struct Layout
+{
+	const T*      data;
+	size_t        count;
+	size_t        n;
+	size_t        lastN;
+	size_t        vecStride;
+	size_t        elemStride;
+};
+
+static inline void KahanAdd(double& s, double& c, double x)
+{
+	const double _y = x - c;
+	const double _t = s + _y;
+	c = (_t - s) - _y;
+	s = _t;
+}
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+// reductions of a single vector x with n elements at the given stride, shift
+// is subtracted from the elements before the transformation g.
+template<typename T, typename G>
+static double SumNaive(const T* x, size_t n, size_t stride, double shift, G g)
+{
+	double       _s[gcLanes] = {};
+	const size_t _n          = n - n%gcLanes;
+	if(stride == 1)
+	{
+		for(size_t i=0 ; i<_n ; i+=gcLanes)
+		{
+			for(size_t l=0 ; l<gcLanes ; ++l)
+			{
+				_s[l] += g(x[i+l] - shift);
+			}
+		}
+	}
+	else
+	{
+		for(size_t i=0 ; i<_n ; i+=gcLanes)
+		{
+			for(size_t l=0 ; l<gcLanes ; ++l)
+			{
+				_s[l] += g(x[(i+l)*stride] - shift);
+			}
+		}
+	}
+	for(size_t i=_n ; i<n ; ++i)
+	{
+		_s[i-_n] += g(x[i*stride] - shift);
+	}
+	return ((_s[0] + _s[1]) + (_s[2] + _s[3])) + ((_s[4] + _s[5]) + (_s[6] + _s[7]));
+}
+
+template<typename T, typename G>
+static double SumPairwise(const T* x, size_t n, size_t stride, double shift, G g)
+{
+	if(n <= gcPairwiseBlock)
+	{
+		return SumNaive(x, n, stride, shift, g);
+	}
+	const size_t _half = (n/2) - (n/2)%gcLanes;
+	return SumPairwise(x, _half, stride, shift, g) + SumPairwise(x + _half*stride, n-_half, stride, shift, g);
+}
+
+template<typename T, typename G>
+static double SumKahan(const T* x, size_t n, size_t stride, double shift, G g)
+{
+	const size_t _lanes = 4;
+	double       _s[_lanes] = {};
+	double       _c[_lanes] = {};
+	const size_t _n = n - n%_lanes;
+	for(size_t i=0 ; i<_n ; i+=_lanes)
+	{
+		for(size_t l=0 ; l<_lanes ; ++l)
+		{
+			KahanAdd(_s[l], _c[l], g(x[(i+l)*stride] - shift));
+		}
+	}
+	for(size_t i=_n ; i<n ; ++i)
+	{
+		KahanAdd(_s[i-_n], _c[i-_n], g(x[i*stride] - shift));
+	}
+	
+	// the compensation c is the error which was added in excess to s.
+	double _sum = 0.0, _comp = 0.0;
+	for(size_t l=0 ; l<_lanes ; ++l)
+	{
+		KahanAdd(_sum, _comp, _s[l]);
+		KahanAdd(_sum, _comp, -_c[l]);
+	}
+	return _sum - _comp;
+}
+
+template<typename T, typename G>
+static double SumVector(const T* x, size_t n, size_t stride, double shift, SumMethod method, G g)
+{
+	switch(method)
+	{
+	case SumMethod::Naive:    return SumNaive(x, n, stride, shift, g);
+	case SumMethod::Kahan:    return SumKahan(x, n, stride, shift, g);
+	case SumMethod::Pairwise:
+	default:                  return SumPairwise(x, n, stride, shift, g);
+	}
+}
+
+template<typename T, typename Op, typename G>
+static double ExtremumVector(const T* x, size_t n, size_t stride, Op op, G g)
+{
+	double _e[gcLanes];
+	std::fill(_e, _e+gcLanes, Op::Init());
+	const size_t _n = n - n%gcLanes;
+	for(size_t i=0 ; i<_n ; i+=gcLanes)
+	{
+		for(size_t l=0 ; l<gcLanes ; ++l)
+		{
+			_e[l] = op(_e[l], g(x[(i+l)*stride]));
+		}
+	}
+	for(size_t i=_n ; i<n ; ++i)
+	{
+		_e[0] = op(_e[0], g(x[i*stride]));
+	}
+	for(size_t l=1 ; l<gcLanes ; ++l)
+	{
+		_e[0] = op(_e[0], _e[l]);
+	}
+	return _e[0];
+}
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+// reductions of w adjacent vectors with n elements, element i of vector j is
+// x[i*stride + j]. The results are written to acc[0..w).
+template<typename T, typename G>
+static void SumAcrossNaive(const T* x, size_t w, size_t n, size_t stride, const double* shift, G g, double* acc)
+{
+	std::fill(acc, acc+w, 0.0);
+	for(size_t i=0 ; i<n ; ++i)
+	{
+		const T*      _x = x + i*stride;
+		for(size_t j=0 ; j<w ; ++j)
+		{
+			acc[j] += g(_x[j] - shift[j]);
+		}
+	}
+}
+
+template<typename T, typename G>
+static void SumAcrossPairwise(const T* x, size_t w, size_t n, size_t stride, const double* shift, G g, double* acc)
+{
+	if(n <= gcPairwiseBlock)
+	{
+		SumAcrossNaive(x, w, n, stride, shift, g, acc);
+		return;
+	}
+	const size_t        _half = n/2;
+	std::vector<double> _rest(w);
+	SumAcrossPairwise(x, w, _half, stride, shift, g, acc);
+	SumAcrossPairwise(x + _half*stride, w, n-_half, stride, shift, g, _rest.data());
+	for(size_t j=0 ; j<w ; ++j)
+	{
+		acc[j] += _rest[j];
+	}
+}
+
+template<typename T, typename G>
+static void SumAcrossKahan(const T* x, size_t w, size_t n, size_t stride, const double* shift, G g, double* acc)
+{
+	std::vector<double> _c(w, 0.0);
+	std::fill(acc, acc+w, 0.0);
+	for(size_t i=0 ; i<n ; ++i)
+	{
+		const T*      _x = x + i*stride;
+		for(size_t j=0 ; j<w ; ++j)
+		{
+			KahanAdd(acc[j], _c[j], g(_x[j] - shift[j]));
+		}
+	}
+	for(size_t j=0 ; j<w ; ++j)
+	{
+		acc[j] -= _c[j];
+	}
+}
+
+template<typename T, typename Op, typename G>
+static void ExtremumAcross(const T* x, size_t w, size_t n, size_t stride, Op op, G g, double* acc)
+{
+	std::fill(acc, acc+w, Op::Init());
+	for(size_t i=0 ; i<n ; ++i)
+	{
+		const T*      _x = x + i*stride;
+		for(size_t j=0 ; j<w ; ++j)
+		{
+			acc[j] = op(acc[j], g(_x[j]));
+		}
+	}
+}
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+// reduce all the vectors of a layout into out[0..count), in parallel over the
+// vectors. Interleaved vectors are accumulated a panel at a time, otherwise
+// each vector is reduced on its own. shift can be nullptr.
+template<typename T>
+static bool IsInterleaved(const Layout<T>& L)
+{
+	return L.vecStride == 1 && L.elemStride != 1 && L.count > 1 && L.lastN == L.n;
+}
+
+template<typename T, typename G>
+static void SumVectors(const Layout<T>& L, const double* shift, SumMethod method, G g, double* out, unsigned int numThreads)
+{
+	if(IsInterleaved(L))
+	{
+		const size_t _grain = std::max(size_t(64), gcParallelGrain / (L.n + 1));
+		glParallelFor(0, L.count, _grain, [&](size_t j1, size_t j2)
+		{
+			const std::vector<double> _zeros(shift == nullptr ? gcPanel : 0, 0.0);
+			for(size_t p=j1 ; p<j2 ; p+=gcPanel)
+			{
+				const size_t  _w     = std::min(gcPanel, j2-p);
+				const T*      _x     = L.data + p;
+				const double* _shift = shift == nullptr ? _zeros.data() : shift + p;
+				switch(method)
+				{
+				case SumMethod::Naive: SumAcrossNaive(_x, _w, L.n, L.elemStride, _shift, g, out + p);    break;
+				case SumMethod::Kahan: SumAcrossKahan(_x, _w, L.n, L.elemStride, _shift, g, out + p);    break;
+				default:               SumAcrossPairwise(_x, _w, L.n, L.elemStride, _shift, g, out + p); break;
+				}
+			}
+		}, numThreads);
+	}
+	else
+	{
+		const size_t _grain = std::max(size_t(1), gcParallelGrain / (L.n + 1));
+		glParallelFor(0, L.count, _grain, [&](size_t j1, size_t j2)
+		{
+			for(size_t j=j1 ; j<j2 ; ++j)
+			{
+				const size_t _n = j+1 == L.count ? L.lastN : L.n;
+				out[j] = SumVector(L.data + j*L.vecStride, _n, L.elemStride, shift == nullptr ? 0.0 : shift[j], method, g);
+			}
+		}, numThreads);
+	}
+}
+
+template<typename T, typename Op, typename G>
+static void ExtremumVectors(const Layout<T>& L, Op op, G g, double* out, unsigned int numThreads)
+{
+	if(IsInterleaved(L))
+	{
+		const size_t _grain = std::max(size_t(64), gcParallelGrain / (L.n + 1));
+		glParallelFor(0, L.count, _grain, [&](size_t j1, size_t j2)
+		{
+			for(size_t p=j1 ; p<j2 ; p+=gcPanel)
+			{
+				ExtremumAcross(L.data + p, std::min(gcPanel, j2-p), L.n, L.elemStride, op, g, out + p);
+			}
+		}, numThreads);
+	}
+	else
+	{
+		const size_t _grain = std::max(size_t(1), gcParallelGrain / (L.n + 1));
+		glParallelFor(0, L.count, _grain, [&](size_t j1, size_t j2)
+		{
+			for(size_t j=j1 ; j<j2 ; ++j)
+			{
+				const size_t _n = j+1 == L.count ? L.lastN : L.n;
+				out[j] = ExtremumVector(L.data + j*L.vecStride, _n, L.elemStride, op, g);
+			}
+		}, numThreads);
+	}
+}
+
+// reduce each vector of a layout to one value.
+template<typename T>
+static void ReduceVectors(const Layout<T>& L, ReduceKind kind, const ReduceOptions& options, double* out)
+{
+	const SumMethod    _method = options.summation;
+	const unsigned int _nt     = options.numThreads;
+	const double       _n      = double(L.n);
+	switch(kind)
+	{
+	case ReduceKind::Sum:
+		SumVectors(L, nullptr, _method, Identity(), out, _nt);
+		break;
+	
+	case ReduceKind::Mean:
+		SumVectors(L, nullptr, _method, Identity(), out, _nt);
+		for(size_t j=0 ; j<L.count ; ++j)
+		{
+			out[j] /= _n;
+		}
+		break;
+	
+	case ReduceKind::Min:
+		ExtremumVectors(L, MinOp(), Identity(), out, _nt);
+		break;
+	
+	case ReduceKind::Max:
+		ExtremumVectors(L, MaxOp(), Identity(), out, _nt);
+		break;
+	
+	case ReduceKind::SumSquares:
+		SumVectors(L, nullptr, _method, Square(), out, _nt);
+		break;
+	
+	case ReduceKind::Norm1:
+		SumVectors(L, nullptr, _method, Abs(), out, _nt);
+		break;
+	
+	case ReduceKind::Norm2:
+		SumVectors(L, nullptr, _method, Square(), out, _nt);
+		for(size_t j=0 ; j<L.count ; ++j)
+		{
+			out[j] = std::sqrt(out[j]);
+		}
+		break;
+	
+	case ReduceKind::NormInf:
+		ExtremumVectors(L, MaxOp(), Abs(), out, _nt);
+		break;
+	
+	case ReduceKind::Variance:
+	case ReduceKind::StdDev:
+		{
+			// the squared deviations from the mean are summed in a second pass,
+			// which does not lose the precision of the sum of squares.
+			std::vector<double> _mean(L.count);
+			SumVectors(L, nullptr, _method, Identity(), _mean.data(), _nt);
+			for(size_t j=0 ; j<L.count ; ++j)
+			{
+				_mean[j] /= _n;
+			}
+			SumVectors(L, _mean.data(), _method, Square(), out, _nt);
+			const double _d = options.bias == eUnBiased ? _n-1.0 : _n;
+			for(size_t j=0 ; j<L.count ; ++j)
+			{
+				out[j] = kind == ReduceKind::Variance ? out[j]/_d : std::sqrt(out[j]/_d);
+			}
+		}
+		break;
+	}
+	
+	// the extremum of an empty set is not defined, its largest absolute value is 0.
+	if(L.n == 0 && (kind == ReduceKind::Min || kind == ReduceKind::Max || kind == ReduceKind::NormInf))
+	{
+		std::fill(out, out+L.count, kind == ReduceKind::NormInf ? 0.0 : gcNaN);
+	}
+}
+
+// reduce all the elements of A. The elements are split into pieces which are
+// reduced in parallel, then the partial results are reduced.
+template<typename T>
+static double ReduceAll(const ConstMatrixViewT<T>& A, ReduceKind kind, const ReduceOptions& options)
+{
+	const size_t _size = A.Rows()*A.Cols();
+	if(_size == 0)
+	{
+		return kind == ReduceKind::Sum || kind == ReduceKind::SumSquares || kind == ReduceKind::Norm1 ||
+		       kind == ReduceKind::Norm2 || kind == ReduceKind::NormInf ? 0.0 : gcNaN;
+	}
+	
+	Layout<T> _parts;
+	if(A.IsContiguous())
+	{
+		const size_t _count = (_size + gcAllBlock - 1) / gcAllBlock;
+		_parts = {A.Data(), _count, gcAllBlock, _size - (_count-1)*gcAllBlock, gcAllBlock, 1};
+	}
+	else
+	{
+		_parts = {A.Data(), A.Rows(), A.Cols(), A.Cols(), A.RowStride(), A.ColStride()};
+	}
+	
+	const SumMethod     _method = options.summation;
+	const unsigned int  _nt     = options.numThreads;
+	const double        _n      = double(_size);
+	std::vector<double> _partial(_parts.count);
+	auto _sum = [&](auto g, const double* shift) -> double
+	{
+		SumVectors(_parts, shift, _method, g, _partial.data(), _nt);
+		return SumVector(_partial.data(), _partial.size(), 1, 0.0, _method, Identity());
+	};
+	auto _extremum = [&](auto op, auto g) -> double
+	{
+		ExtremumVectors(_parts, op, g, _partial.data(), _nt);
+		return ExtremumVector(_partial.data(), _partial.size(), 1, op, Identity());
+	};
+	
+	switch(kind)
+	{
+	case ReduceKind::Sum:        return _sum(Identity(), nullptr);
+	case ReduceKind::Mean:       return _sum(Identity(), nullptr) / _n;
+	case ReduceKind::Min:        return _extremum(MinOp(), Identity());
+	case ReduceKind::Max:        return _extremum(MaxOp(), Identity());
+	case ReduceKind::SumSquares: return _sum(Square(), nullptr);
+	case ReduceKind::Norm1:      return _sum(Abs(), nullptr);
+	case ReduceKind::Norm2:      return std::sqrt(_sum(Square(), nullptr));
+	case ReduceKind::NormInf:    return _extremum(MaxOp(), Abs());
+	case ReduceKind::Variance:
+	case ReduceKind::StdDev:
+	default:
+		{
+			const std::vector<double> _mean(_parts.count, _sum(Identity(), nullptr) / _n);
+			const double              _d   = options.bias == eUnBiased ? _n-1.0 : _n;
+			const double              _var = _sum(Square(), _mean.data()) / _d;
+			return kind == ReduceKind::Variance ? _var : std::sqrt(_var);
+		}
+	}
+}
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+
+
+// options.
+// ------------------------------------------------------------------------- //
+ReduceOptions::ReduceOptions()
+	: summation(SumMethod::Pairwise), bias(eUnBiased), numThreads(0)
+{}
+// ------------------------------------------------------------------------- //
+
+
+// reductions.
+// ------------------------------------------------------------------------- //
+// the results are written directly into a contiguous output of doubles,
+// other outputs go through a buffer.
+static double* DirectOutput(double* out, size_t stride)
+{
+	return stride == 1 ? out : nullptr;
+}
+
+static double* DirectOutput(float*, size_t)
+{
+	return nullptr;
+}
+
+template<typename T>
+static MatrixT<T> Reduce(const ConstMatrixViewT<T>& A, ReduceKind kind, ReduceAxis axis, const ReduceOptions& options)
+{
+	MatrixT<T> _out;
+	switch(axis)
+	{
+	case ReduceAxis::Rows: _out = MatrixT<T>(A.Rows(), 1, MatrixType::Null); break;
+	case ReduceAxis::Cols: _out = MatrixT<T>(1, A.Cols(), MatrixType::Null); break;
+	case ReduceAxis::All:  _out = MatrixT<T>(1, 1, MatrixType::Null);        break;
+	}
+	glReduce(A, kind, axis, _out.View(), options);
+	return _out;
+}
+
+template<typename T>
+static void Reduce(const ConstMatrixViewT<T>& A, ReduceKind kind, ReduceAxis axis, const MatrixViewT<T>& out,
+                   const ReduceOptions& options)
+{
+	if(axis == ReduceAxis::All)
+	{
+		if(out.Rows() != 1 || out.Cols() != 1)
+		{
+			char _msg[] = "Output must be 1 x 1 in glReduce";
+			throw SUtils::Exceptions::InvalidArgumentException(_msg);
+		}
+		out(0, 0) = T(ReduceAll(A, kind, options));
+		return;
+	}
+	
+	// a row is a vector of elements at the column stride, a column is a vector
+	// of elements at the row stride.
+	Layout<T> _layout;
+	if(axis == ReduceAxis::Rows)
+	{
+		if(out.Rows() != A.Rows() || out.Cols() != 1)
+		{
+			char _msg[] = "Output must be rows x 1 in glReduce";
+			throw SUtils::Exceptions::InvalidArgumentException(_msg);
+		}
+		_layout = {A.Data(), A.Rows(), A.Cols(), A.Cols(), A.RowStride(), A.ColStride()};
+	}
+	else
+	{
+		if(out.Rows() != 1 || out.Cols() != A.Cols())
+		{
+			char _msg[] = "Output must be 1 x cols in glReduce";
+			throw SUtils::Exceptions::InvalidArgumentException(_msg);
+		}
+		_layout = {A.Data(), A.Cols(), A.Rows(), A.Rows(), A.ColStride(), A.RowStride()};
+	}
+	
+	const size_t _stride = axis == ReduceAxis::Rows ? out.RowStride() : out.ColStride();
+	double*      _direct = DirectOutput(out.Data(), _stride);
+	if(_direct != nullptr)
+	{
+		ReduceVectors(_layout, kind, options, _direct);
+	}
+	else
+	{
+		std::vector<double> _result(_layout.count);
+		ReduceVectors(_layout, kind, options, _result.data());
+		for(size_t j=0 ; j<_layout.count ; ++j)
+		{
+			out.Data()[j*_stride] = T(_result[j]);
+		}
+	}
+}
+
+Matrix glReduce(const ConstMatrixView& A, ReduceKind kind, ReduceAxis axis, const ReduceOptions& options)
+{
+	return Reduce(A, kind, axis, options);
+}
+
+MatrixF glReduce(const ConstMatrixViewF& A, ReduceKind kind, ReduceAxis axis, const ReduceOptions& options)
+{
+	return Reduce(A, kind, axis, options);
+}
+
+void glReduce(const ConstMatrixView& A, ReduceKind kind, ReduceAxis axis, const MatrixView& out,
+              const ReduceOptions& options)
+{
+	Reduce(A, kind, axis, out, options);
+}
+
+void glReduce(const ConstMatrixViewF& A, ReduceKind kind, ReduceAxis axis, const MatrixViewF& out,
+              const ReduceOptions& options)
+{
+	Reduce(A, kind, axis, out, options);
+}
+
+double glReduceAll(const ConstMatrixView& A, ReduceKind kind, const ReduceOptions& options)
+{
+	return ReduceAll(A, kind, options);
+}
+
+double glReduceAll(const ConstMatrixViewF& A, ReduceKind kind, const ReduceOptions& options)
+{
+	return ReduceAll(A, kind, options);
+}
+// ------------------------------------------------------------------------- //
+
+};	// End namespace SMathLib.
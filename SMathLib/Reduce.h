@@ -0,0 +1,101 @@
+// 
+// This file is part of SLogLib; you can redistribute it and/or 
+// modify it under the terms of the MIT License.
+// Author: Saurabh Garg (saurabhgarg@mysoc.net)
+// 
+
+#ifndef _SMATHLIB_REDUCE_H_
+#define _SMATHLIB_REDUCE_H_
+
+#include "SMathLib/Config.h"
+#include "SMathLib/Matrix.h"
+#include "SMathLib/MatrixView.h"
+#include "SMathLib/Types.h"
+
+namespace SMathLib {
+;
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+// Reductions of the rows, the columns or all the elements of a matrix:
+//
+//     Matrix _means = glReduce(A, ReduceKind::Mean, ReduceAxis::Cols);    // 1 x cols.
+//     Matrix _norms = glReduce(A, ReduceKind::Norm2, ReduceAxis::Rows);   // rows x 1.
+//     double _max   = glReduceAll(A, ReduceKind::NormInf);
+//
+// The inner loops keep several independent accumulators so that the compiler
+// can vectorize them. When the reduced elements are strided, e.g. the columns
+// of a row-major matrix, all the outputs are accumulated together while
+// streaming over the rows. The outputs are distributed over the thread pool
+// and the results don't depend on the number of threads. The elements of a
+// float matrix are accumulated in double and the results rounded to float.
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+//! The reduction computed by glReduce().
+enum class ReduceKind
+{
+	Sum,            ///< Sum of the elements.
+	Mean,           ///< Mean of the elements.
+	Min,            ///< Smallest element.
+	Max,            ///< Largest element.
+	SumSquares,     ///< Sum of the squares of the elements.
+	Norm1,          ///< Sum of the absolute values of the elements.
+	Norm2,          ///< Euclidean norm, the square root of SumSquares.
+	NormInf,        ///< Largest absolute value of the elements.
+	Variance,       ///< Variance, computed in two passes around the mean.
+	StdDev          ///< Standard deviation, the square root of Variance.
+};
+
+//! The elements which are reduced to one value.
+enum class ReduceAxis
+{
+	Rows,     ///< Each row gives one value, the result is rows x 1.
+	Cols,     ///< Each column gives one value, the result is 1 x cols.
+	All       ///< All the elements give one value, the result is 1 x 1.
+};
+
+//! Summation algorithm used by the sums, means, norms and variances.
+enum class SumMethod
+{
+	Naive,        ///< Plain sum, the error grows as O(n*eps).
+	Pairwise,     ///< Blocks of 128 elements summed recursively in pairs, the error grows as O(log(n)*eps).
+	Kahan         ///< Compensated summation, the error is O(eps) independent of n but it is about 4 times slower.
+};
+
+//! Options of glReduce().
+struct SMATHLIB_DLL_API ReduceOptions
+{
+	ReduceOptions();
+	
+	SumMethod    summation;      ///< Default Pairwise.
+	BiasTypes    bias;           ///< Divide the variance by n-1 (eUnBiased, the default) or n (eBiased).
+	unsigned int numThreads;     ///< 0 means use glGetNumThreads(), the default.
+};
+
+//! Reduce the rows, the columns or all the elements of A.
+//! The mean, minimum, maximum, variance and standard deviation of an empty set
+//! are NaN, as is the unbiased variance of a single element.
+SMATHLIB_DLL_API Matrix  glReduce(const ConstMatrixView&  A, ReduceKind kind, ReduceAxis axis,
+                                  const ReduceOptions& options = ReduceOptions());
+SMATHLIB_DLL_API MatrixF glReduce(const ConstMatrixViewF& A, ReduceKind kind, ReduceAxis axis,
+                                  const ReduceOptions& options = ReduceOptions());
+
+//! Reduce A into out, which must be rows x 1, 1 x cols or 1 x 1 depending on
+//! the axis. out can be a view of a row or a column of a larger matrix.
+//! Throws SUtils::Exceptions::InvalidArgumentException if out has the wrong size.
+SMATHLIB_DLL_API void glReduce(const ConstMatrixView& A, ReduceKind kind, ReduceAxis axis, const MatrixView& out,
+                               const ReduceOptions& options = ReduceOptions());
+SMATHLIB_DLL_API void glReduce(const ConstMatrixViewF& A, ReduceKind kind, ReduceAxis axis, const MatrixViewF& out,
+                               const ReduceOptions& options = ReduceOptions());
+
+//! Reduce all the elements of A to a scalar.
+SMATHLIB_DLL_API double glReduceAll(const ConstMatrixView& A, ReduceKind kind,
+                                    const ReduceOptions& options = ReduceOptions());
+SMATHLIB_DLL_API double glReduceAll(const ConstMatrixViewF& A, ReduceKind kind,
+                                    const ReduceOptions& options = ReduceOptions());
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+
+};	// End namespace SMathLib.
+
+#endif // _SMATHLIB_REDUCE_H_
@@ -0,0 +1,344 @@
+// 
+// This file is part of SLogLib; you can redistribute it and/or 
+// modify it under the terms of the MIT License.
+// Author: Saurabh Garg (saurabhgarg@mysoc.net)
+// 
+
+#include "SparseMatrix.h"
+#include "Parallel.h"
+#include "SUtils/Exceptions/InvalidArgumentException.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <ostream>
+#include <utility>
+
+namespace SMathLib {
+;
+
+// minimum number of non-zeros processed by a thread in the products.
+static const size_t gcParallelGrain = 32768;
+
+// number of rows of A which have about gcParallelGrain non-zeros.
+static size_t RowGrain(const SparseMatrix& A)
+{
+	const size_t _perRow = A.Rows() == 0 ? 1 : std::max<size_t>(1, A.NonZeros() / A.Rows());
+	return std::max<size_t>(1, gcParallelGrain / _perRow);
+}
+
+
+// constructors.
+// ------------------------------------------------------------------------- //
+SparseMatrix::SparseMatrix()
+	: mRows(0), mCols(0), mRowPointers(1, 0)
+{}
+
+SparseMatrix::SparseMatrix(size_t rows, size_t cols, std::vector<size_t>&& rowPointers,
+                           std::vector<size_t>&& colIndices, std::vector<double>&& values)
+	: mRows(rows), mCols(cols), mRowPointers(std::move(rowPointers)), mColIndices(std::move(colIndices)),
+	  mValues(std::move(values))
+{
+	if(mRowPointers.size() != rows+1 || mColIndices.size() != mValues.size() || mRowPointers.back() != mValues.size())
+	{
+		char _msg[] = "Inconsistent CSR arrays in SparseMatrix::SparseMatrix";
+		throw SUtils::Exceptions::InvalidArgumentException(_msg);
+	}
+}
+
+SparseMatrix SparseMatrix::Identity(size_t n, double s)
+{
+	std::vector<size_t> _rowPointers(n+1);
+	std::vector<size_t> _colIndices(n);
+	for(size_t i=0 ; i<n ; ++i)
+	{
+		_rowPointers[i] = i;
+		_colIndices[i]  = i;
+	}
+	_rowPointers[n] = n;
+	return SparseMatrix(n, n, std::move(_rowPointers), std::move(_colIndices), std::vector<double>(n, s));
+}
+// ------------------------------------------------------------------------- //
+
+
+// element access.
+// ------------------------------------------------------------------------- //
+double SparseMatrix::operator ()(size_t r, size_t c) const
+{
+	assert(r < mRows && c < mCols);
+	const size_t* _begin = mColIndices.data() + mRowPointers[r];
+	const size_t* _end   = mColIndices.data() + mRowPointers[r+1];
+	const size_t* _it    = std::lower_bound(_begin, _end, c);
+	return (_it != _end && *_it == c) ? mValues[size_t(_it - mColIndices.data())] : 0.0;
+}
+
+Matrix SparseMatrix::Diagonal() const
+{
+	const size_t _n = std::min(mRows, mCols);
+	Matrix _D(_n, 1, MatrixType::Zero);
+	for(size_t i=0 ; i<_n ; ++i)
+	{
+		_D.matrix[i] = (*this)(i, i);
+	}
+	return _D;
+}
+// ------------------------------------------------------------------------- //
+
+
+// products.
+// ------------------------------------------------------------------------- //
+void SparseMatrix::Multiply(const double* x, double* y, unsigned int numThreads) const
+{
+	const size_t* _rowPointers = mRowPointers.data();
+	const size_t* _colIndices  = mColIndices.data();
+	const double* _values      = mValues.data();
+	glParallelFor(0, mRows, RowGrain(*this), [&](size_t r1, size_t r2)
+	{
+		for(size_t i=r1 ; i<r2 ; ++i)
+		{
+			double _s = 0.0;
+			for(size_t k=_rowPointers[i] ; k<_rowPointers[i+1] ; ++k)
+			{
+				_s += _values[k] * x[_colIndices[k]];
+			}
+			y[i] = _s;
+		}
+	}, numThreads);
+}
+
+void SparseMatrix::MultiplyTranspose(const double* x, double* y) const
+{
+	// the rows scatter into y, so this runs on one thread.
+	std::fill(y, y+mCols, 0.0);
+	for(size_t i=0 ; i<mRows ; ++i)
+	{
+		const double _x = x[i];
+		for(size_t k=mRowPointers[i] ; k<mRowPointers[i+1] ; ++k)
+		{
+			y[mColIndices[k]] += mValues[k] * _x;
+		}
+	}
+}
+
+Matrix SparseMatrix::operator *(const ConstMatrixView& B) const
+{
+	assert(B.Rows() == mCols);
+	
+	Matrix              _C(mRows, B.Cols(), MatrixType::Null);
+	std::vector<double> _x(mCols);
+	std::vector<double> _y(mRows);
+	for(size_t j=0 ; j<B.Cols() ; ++j)
+	{
+		for(size_t i=0 ; i<mCols ; ++i)
+		{
+			_x[i] = B(i, j);
+		}
+		Multiply(_x.data(), _y.data());
+		for(size_t i=0 ; i<mRows ; ++i)
+		{
+			_C(i, j) = _y[i];
+		}
+	}
+	return _C;
+}
+
+SparseMatrix SparseMatrix::operator *(double s) const
+{
+	SparseMatrix _B(*this);
+	_B *= s;
+	return _B;
+}
+
+SparseMatrix& SparseMatrix::operator *=(double s)
+{
+	for(size_t k=0 ; k<mValues.size() ; ++k)
+	{
+		mValues[k] *= s;
+	}
+	return *this;
+}
+// ------------------------------------------------------------------------- //
+
+
+// functions.
+// ------------------------------------------------------------------------- //
+SparseMatrix SparseMatrix::Transpose() const
+{
+	// count the non-zeros of each column, then scatter the rows in order so
+	// that the columns of the transpose come out sorted.
+	std::vector<size_t> _rowPointers(mCols+1, 0);
+	for(size_t k=0 ; k<mColIndices.size() ; ++k)
+	{
+		++_rowPointers[mColIndices[k]+1];
+	}
+	for(size_t j=0 ; j<mCols ; ++j)
+	{
+		_rowPointers[j+1] += _rowPointers[j];
+	}
+	
+	std::vector<size_t> _next(_rowPointers.begin(), _rowPointers.end()-1);
+	std::vector<size_t> _colIndices(mValues.size());
+	std::vector<double> _values(mValues.size());
+	for(size_t i=0 ; i<mRows ; ++i)
+	{
+		for(size_t k=mRowPointers[i] ; k<mRowPointers[i+1] ; ++k)
+		{
+			const size_t _pos = _next[mColIndices[k]]++;
+			_colIndices[_pos] = i;
+			_values[_pos]     = mValues[k];
+		}
+	}
+	return SparseMatrix(mCols, mRows, std::move(_rowPointers), std::move(_colIndices), std::move(_values));
+}
+
+Matrix SparseMatrix::ToDense() const
+{
+	Matrix _A(mRows, mCols, MatrixType::Zero);
+	for(size_t i=0 ; i<mRows ; ++i)
+	{
+		for(size_t k=mRowPointers[i] ; k<mRowPointers[i+1] ; ++k)
+		{
+			_A(i, mColIndices[k]) = mValues[k];
+		}
+	}
+	return _A;
+}
+
+bool SparseMatrix::IsSymmetric(double tolerance) const
+{
+	if(mRows != mCols)
+	{
+		return false;
+	}
+	
+	const SparseMatrix _T = Transpose();
+	if(_T.mColIndices != mColIndices)
+	{
+		return false;
+	}
+	for(size_t k=0 ; k<mValues.size() ; ++k)
+	{
+		if(std::fabs(mValues[k] - _T.mValues[k]) > tolerance)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+std::ostream& operator <<(std::ostream& out, const SparseMatrix& B)
+{
+	out << B.mRows << " " << B.mCols << " " << B.NonZeros();
+	for(size_t i=0 ; i<B.mRows ; ++i)
+	{
+		for(size_t k=B.mRowPointers[i] ; k<B.mRowPointers[i+1] ; ++k)
+		{
+			out << std::endl << i << " " << B.mColIndices[k] << " " << B.mValues[k];
+		}
+	}
+	return out;
+}
+// ------------------------------------------------------------------------- //
+
+
+// builder.
+// ------------------------------------------------------------------------- //
+SparseMatrixBuilder::SparseMatrixBuilder(size_t rows, size_t cols)
+	: mRows(rows), mCols(cols)
+{}
+
+void SparseMatrixBuilder::Reserve(size_t numTriplets)
+{
+	mRowIndices.reserve(numTriplets);
+	mColIndices.reserve(numTriplets);
+	mValues.reserve(numTriplets);
+}
+
+void SparseMatrixBuilder::Add(size_t r, size_t c, double value)
+{
+	if(r >= mRows || c >= mCols)
+	{
+		char _msg[] = "Index out of bounds in SparseMatrixBuilder::Add";
+		throw SUtils::Exceptions::InvalidArgumentException(_msg);
+	}
+	mRowIndices.push_back(r);
+	mColIndices.push_back(c);
+	mValues.push_back(value);
+}
+
+void SparseMatrixBuilder::Clear()
+{
+	mRowIndices.clear();
+	mColIndices.clear();
+	mValues.clear();
+}
+
+SparseMatrix SparseMatrixBuilder::Build() const
+{
+	// bucket the triplets by row.
+	std::vector<size_t> _rowPointers(mRows+1, 0);
+	for(size_t t=0 ; t<mRowIndices.size() ; ++t)
+	{
+		++_rowPointers[mRowIndices[t]+1];
+	}
+	for(size_t i=0 ; i<mRows ; ++i)
+	{
+		_rowPointers[i+1] += _rowPointers[i];
+	}
+	
+	std::vector<std::pair<size_t, double> > _entries(mValues.size());
+	std::vector<size_t>                     _next(_rowPointers.begin(), _rowPointers.end()-1);
+	for(size_t t=0 ; t<mRowIndices.size() ; ++t)
+	{
+		_entries[_next[mRowIndices[t]]++] = std::make_pair(mColIndices[t], mValues[t]);
+	}
+	
+	// sort each row by column and sum the duplicates in place; _next holds the
+	// number of unique columns of each row.
+	glParallelFor(0, mRows, 1024, [&](size_t r1, size_t r2)
+	{
+		for(size_t i=r1 ; i<r2 ; ++i)
+		{
+			std::pair<size_t, double>* _begin = _entries.data() + _rowPointers[i];
+			std::pair<size_t, double>* _end   = _entries.data() + _rowPointers[i+1];
+			std::stable_sort(_begin, _end, [](const std::pair<size_t, double>& a, const std::pair<size_t, double>& b)
+			{
+				return a.first < b.first;
+			});
+			
+			size_t _unique = 0;
+			for(std::pair<size_t, double>* _it=_begin ; _it!=_end ; ++_it)
+			{
+				if(_unique > 0 && _begin[_unique-1].first == _it->first)
+				{
+					_begin[_unique-1].second += _it->second;
+				}
+				else
+				{
+					_begin[_unique++] = *_it;
+				}
+			}
+			_next[i] = _unique;
+		}
+	});
+	
+	// compact the rows.
+	std::vector<size_t> _csrRowPointers(mRows+1, 0);
+	for(size_t i=0 ; i<mRows ; ++i)
+	{
+		_csrRowPointers[i+1] = _csrRowPointers[i] + _next[i];
+	}
+	std::vector<size_t> _colIndices(_csrRowPointers[mRows]);
+	std::vector<double> _values(_csrRowPointers[mRows]);
+	for(size_t i=0 ; i<mRows ; ++i)
+	{
+		for(size_t k=0 ; k<_next[i] ; ++k)
+		{
+			_colIndices[_csrRowPointers[i]+k] = _entries[_rowPointers[i]+k].first;
+			_values[_csrRowPointers[i]+k]     = _entries[_rowPointers[i]+k].second;
+		}
+	}
+	return SparseMatrix(mRows, mCols, std::move(_csrRowPointers), std::move(_colIndices), std::move(_values));
+}
+// ------------------------------------------------------------------------- //
+
+};	// End namespace SMathLib.
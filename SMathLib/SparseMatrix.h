@@ -0,0 +1,154 @@
+// 
+// This file is part of SLogLib; you can redistribute it and/or 
+// modify it under the terms of the MIT License.
+// Author: Saurabh Garg (saurabhgarg@mysoc.net)
+// 
+
+#ifndef _SMATHLIB_SPARSEMATRIX_H_
+#define _SMATHLIB_SPARSEMATRIX_H_
+
+#include "SMathLib/Config.h"
+#include "SMathLib/Matrix.h"
+#include "SMathLib/MatrixView.h"
+#include <vector>
+
+namespace SMathLib {
+;
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+// Sparse matrices in compressed sparse row (CSR) format. A SparseMatrix is
+// assembled with a SparseMatrixBuilder, which collects (row, col, value)
+// triplets in any order:
+//
+//     SparseMatrixBuilder _builder(n, n);
+//     for(...)
+//     {
+//         _builder.Add(i, j, a);    // Duplicates are summed.
+//     }
+//     SparseMatrix _A = _builder.Build();
+//
+// The structure of a SparseMatrix is fixed once it is built, the values of
+// the non-zeros can be changed. See SparseSolve.h for the iterative solvers.
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+//! Compressed sparse row matrix. The non-zeros of row i are stored at the
+//! positions [RowPointers()[i], RowPointers()[i+1]) of ColIndices() and
+//! Values(), sorted by column and without duplicates.
+class SMATHLIB_DLL_API SparseMatrix
+{
+	// for standard IO.
+	SMATHLIB_DLL_API friend std::ostream& operator <<(std::ostream& out, const SparseMatrix& B);
+
+public:  // Constructors.
+
+	SparseMatrix();
+	
+	//! Create a matrix from CSR arrays, the arrays are moved into the matrix.
+	//! The columns of each row must be sorted and unique.
+	SparseMatrix(size_t rows, size_t cols, std::vector<size_t>&& rowPointers,
+	             std::vector<size_t>&& colIndices, std::vector<double>&& values);
+	
+	//! Create a n x n diagonal matrix with s on the diagonal.
+	static SparseMatrix Identity(size_t n, double s = 1.0);
+
+public:  // Size and structure.
+
+	inline size_t Rows() const     {return mRows;}
+	inline size_t Cols() const     {return mCols;}
+	inline size_t NonZeros() const {return mValues.size();}
+	
+	inline const size_t* RowPointers() const {return mRowPointers.data();}
+	inline const size_t* ColIndices() const  {return mColIndices.data();}
+	inline const double* Values() const      {return mValues.data();}
+	inline double*       Values()            {return mValues.data();}
+
+public:  // Element access.
+
+	//! Get element (r, c), 0 if it is not stored.
+	double operator ()(size_t r, size_t c) const;
+	
+	//! Get the diagonal of the matrix as a column vector.
+	Matrix Diagonal() const;
+
+public:  // Products.
+
+	//! y = A*x, x has Cols() elements and y has Rows() elements. The rows are
+	//! distributed over the thread pool; numThreads = 0 means use
+	//! glGetNumThreads(). x and y must not overlap.
+	void Multiply(const double* x, double* y, unsigned int numThreads = 0) const;
+	
+	//! y = A^T*x, x has Rows() elements and y has Cols() elements.
+	void MultiplyTranspose(const double* x, double* y) const;
+	
+	//! Product with a dense matrix, each column of B is multiplied separately.
+	Matrix operator *(const ConstMatrixView& B) const;
+	
+	SparseMatrix operator *(double s) const;
+	SparseMatrix& operator *=(double s);
+
+public:  // Functions.
+
+	SparseMatrix Transpose() const;
+	Matrix       ToDense() const;
+	
+	//! Check if the matrix is structurally and numerically symmetric within
+	//! a tolerance.
+	bool IsSymmetric(double tolerance = 0.0) const;
+
+private:
+
+	size_t              mRows;
+	size_t              mCols;
+	std::vector<size_t> mRowPointers;
+	std::vector<size_t> mColIndices;
+	std::vector<double> mValues;
+};
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+//! Collects (row, col, value) triplets and builds a SparseMatrix from them.
+class SMATHLIB_DLL_API SparseMatrixBuilder
+{
+public:  // Constructors.
+
+	SparseMatrixBuilder(size_t rows, size_t cols);
+
+public:  // Triplets.
+
+	//! Reserve storage for a number of triplets.
+	void Reserve(size_t numTriplets);
+	
+	//! Add value to element (r, c). Triplets for the same element are summed
+	//! when the matrix is built.
+	void Add(size_t r, size_t c, double value);
+	
+	//! Remove all the triplets, keeping the size.
+	void Clear();
+	
+	inline size_t Rows() const        {return mRows;}
+	inline size_t Cols() const        {return mCols;}
+	inline size_t NumTriplets() const {return mValues.size();}
+
+public:  // Build.
+
+	//! Build the CSR matrix. The triplets are bucketed by row and each row is
+	//! sorted by column, so this takes O(nnz log(nnz per row)) time. Explicit
+	//! zeros are kept in the structure.
+	SparseMatrix Build() const;
+
+private:
+
+	size_t              mRows;
+	size_t              mCols;
+	std::vector<size_t> mRowIndices;
+	std::vector<size_t> mColIndices;
+	std::vector<double> mValues;
+};
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+
+};	// End namespace SMathLib.
+
+#endif // _SMATHLIB_SPARSEMATRIX_H_
@@ -0,0 +1,380 @@
+// 
+// This file is part of SLogLib; you can redistribute it and/or 
+// modify it under the terms of the MIT License.
+// Author: Saurabh Garg (saurabhgarg@mysoc.net)
+// 
+
+#include "SparseSolve.h"
+#include "Parallel.h"
+#include "SUtils/Exceptions/InvalidArgumentException.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <utility>
+
+namespace SMathLib {
+;
+
+// number of elements summed by one partial sum of a dot product; fixed so that
+// the dot products don't depend on the number of threads.
+static const size_t gcDotBlock = 4096;
+
+// minimum number of elements processed by a thread in the vector operations.
+static const size_t gcParallelGrain = 32768;
+
+// a.b
+static double Dot(size_t n, const double* a, const double* b, unsigned int numThreads)
+{
+	const size_t        _numBlocks = (n + gcDotBlock - 1) / gcDotBlock;
+	std::vector<double> _partial(_numBlocks, 0.0);
+	glParallelFor(0, _numBlocks, gcParallelGrain/gcDotBlock, [&](size_t b1, size_t b2)
+	{
+		for(size_t k=b1 ; k<b2 ; ++k)
+		{
+			const size_t _end = std::min(n, (k+1)*gcDotBlock);
+			double       _s   = 0.0;
+			for(size_t i=k*gcDotBlock ; i<_end ; ++i)
+			{
+				_s += a[i] * b[i];
+			}
+			_partial[k] = _s;
+		}
+	}, numThreads);
+	
+	double _s = 0.0;
+	for(size_t k=0 ; k<_numBlocks ; ++k)
+	{
+		_s += _partial[k];
+	}
+	return _s;
+}
+
+// apply func(i) to all the elements.
+template<typename Func>
+static void ForEach(size_t n, unsigned int numThreads, Func func)
+{
+	glParallelFor(0, n, gcParallelGrain, [&](size_t i1, size_t i2)
+	{
+		for(size_t i=i1 ; i<i2 ; ++i)
+		{
+			func(i);
+		}
+	}, numThreads);
+}
+
+// z = M^-1*r, or z = r without a preconditioner.
+static void Precondition(const SparsePreconditioner* M, size_t n, const double* r, double* z, unsigned int numThreads)
+{
+	if(M)
+	{
+		M->Apply(r, z);
+	}
+	else
+	{
+		ForEach(n, numThreads, [&](size_t i) { z[i] = r[i]; });
+	}
+}
+
+
+// preconditioners.
+// ------------------------------------------------------------------------- //
+SparsePreconditioner::~SparsePreconditioner()
+{}
+
+JacobiPreconditioner::JacobiPreconditioner(const SparseMatrix& A)
+	: mInvDiagonal(A.Rows())
+{
+	assert(A.Rows() == A.Cols());
+	for(size_t i=0 ; i<A.Rows() ; ++i)
+	{
+		const double _d = A(i, i);
+		if(_d == 0.0)
+		{
+			char _msg[] = "Zero diagonal element in JacobiPreconditioner::JacobiPreconditioner";
+			throw SUtils::Exceptions::InvalidArgumentException(_msg);
+		}
+		mInvDiagonal[i] = 1.0 / _d;
+	}
+}
+
+void JacobiPreconditioner::Apply(const double* r, double* z) const
+{
+	const double* _invDiagonal = mInvDiagonal.data();
+	ForEach(mInvDiagonal.size(), 0, [&](size_t i) { z[i] = r[i] * _invDiagonal[i]; });
+}
+
+IncompleteCholeskyPreconditioner::IncompleteCholeskyPreconditioner(const SparseMatrix& A)
+{
+	assert(A.Rows() == A.Cols());
+	const size_t  _n           = A.Rows();
+	const size_t* _rowPointers = A.RowPointers();
+	const size_t* _colIndices  = A.ColIndices();
+	const double* _values      = A.Values();
+	
+	// structure of L is the lower triangle of A, the diagonal is the last
+	// element of each row.
+	std::vector<size_t> _lRowPointers(_n+1, 0);
+	std::vector<size_t> _lColIndices;
+	std::vector<double> _lValues;
+	_lColIndices.reserve(A.NonZeros()/2 + _n);
+	_lValues.reserve(A.NonZeros()/2 + _n);
+	for(size_t i=0 ; i<_n ; ++i)
+	{
+		bool _hasDiagonal = false;
+		for(size_t k=_rowPointers[i] ; k<_rowPointers[i+1] && _colIndices[k]<=i ; ++k)
+		{
+			_lColIndices.push_back(_colIndices[k]);
+			_lValues.push_back(_values[k]);
+			_hasDiagonal = (_colIndices[k] == i);
+		}
+		if(!_hasDiagonal)
+		{
+			char _msg[] = "Missing diagonal element in IncompleteCholeskyPreconditioner::IncompleteCholeskyPreconditioner";
+			throw SUtils::Exceptions::InvalidArgumentException(_msg);
+		}
+		_lRowPointers[i+1] = _lColIndices.size();
+	}
+	
+	// row-by-row factorization: L(i,j) = (A(i,j) - sum_k L(i,k)*L(j,k)) / L(j,j)
+	// over the common columns k < j of the rows i and j.
+	for(size_t i=0 ; i<_n ; ++i)
+	{
+		const size_t _iBegin = _lRowPointers[i];
+		const size_t _iEnd   = _lRowPointers[i+1];
+		for(size_t p=_iBegin ; p<_iEnd ; ++p)
+		{
+			const size_t _j    = _lColIndices[p];
+			double       _s    = _lValues[p];
+			size_t       _q    = _iBegin;
+			size_t       _r    = _lRowPointers[_j];
+			const size_t _rEnd = _lRowPointers[_j+1] - 1;
+			while(_q < p && _r < _rEnd)
+			{
+				if(_lColIndices[_q] == _lColIndices[_r])
+				{
+					_s -= _lValues[_q++] * _lValues[_r++];
+				}
+				else if(_lColIndices[_q] < _lColIndices[_r])
+				{
+					++_q;
+				}
+				else
+				{
+					++_r;
+				}
+			}
+			
+			if(_j < i)
+			{
+				_lValues[p] = _s / _lValues[_lRowPointers[_j+1]-1];
+			}
+			else
+			{
+				if(!(_s > 0.0))
+				{
+					char _msg[] = "Non-positive pivot in IncompleteCholeskyPreconditioner::IncompleteCholeskyPreconditioner";
+					throw SUtils::Exceptions::InvalidArgumentException(_msg);
+				}
+				_lValues[p] = std::sqrt(_s);
+			}
+		}
+	}
+	
+	mL = SparseMatrix(_n, _n, std::move(_lRowPointers), std::move(_lColIndices), std::move(_lValues));
+}
+
+void IncompleteCholeskyPreconditioner::Apply(const double* r, double* z) const
+{
+	const size_t  _n           = mL.Rows();
+	const size_t* _rowPointers = mL.RowPointers();
+	const size_t* _colIndices  = mL.ColIndices();
+	const double* _values      = mL.Values();
+	
+	// L*y = r, y is stored in z.
+	for(size_t i=0 ; i<_n ; ++i)
+	{
+		double       _s    = r[i];
+		const size_t _diag = _rowPointers[i+1] - 1;
+		for(size_t k=_rowPointers[i] ; k<_diag ; ++k)
+		{
+			_s -= _values[k] * z[_colIndices[k]];
+		}
+		z[i] = _s / _values[_diag];
+	}
+	
+	// L^T*z = y, column i of L^T is row i of L.
+	for(size_t i=_n ; i-->0 ; )
+	{
+		const size_t _diag = _rowPointers[i+1] - 1;
+		z[i] /= _values[_diag];
+		const double _zi = z[i];
+		for(size_t k=_rowPointers[i] ; k<_diag ; ++k)
+		{
+			z[_colIndices[k]] -= _values[k] * _zi;
+		}
+	}
+}
+// ------------------------------------------------------------------------- //
+
+
+// solvers.
+// ------------------------------------------------------------------------- //
+SparseSolverOptions::SparseSolverOptions()
+	: maxIterations(1000), tolerance(1e-10), preconditioner(nullptr), keepResiduals(false), numThreads(0)
+{}
+
+SparseSolverResult::SparseSolverResult()
+	: converged(false), iterations(0), residual(0.0)
+{}
+
+// record the relative residual of an iteration, returns true if converged.
+static bool Record(SparseSolverResult& result, const SparseSolverOptions& options, double residual)
+{
+	result.residual = residual;
+	if(options.keepResiduals)
+	{
+		result.residuals.push_back(residual);
+	}
+	result.converged = residual <= options.tolerance;
+	return result.converged;
+}
+
+SparseSolverResult glSolveCG(const SparseMatrix& A, const double* b, double* x, const SparseSolverOptions& options)
+{
+	assert(A.Rows() == A.Cols());
+	const size_t       _n  = A.Rows();
+	const unsigned int _nt = options.numThreads;
+	SparseSolverResult _result;
+	
+	const double _bNorm = std::sqrt(Dot(_n, b, b, _nt));
+	if(_bNorm == 0.0)
+	{
+		ForEach(_n, _nt, [&](size_t i) { x[i] = 0.0; });
+		_result.converged = true;
+		return _result;
+	}
+	
+	// r = b - A*x.
+	std::vector<double> _r(_n), _z(_n), _p(_n), _Ap(_n);
+	A.Multiply(x, _r.data(), _nt);
+	ForEach(_n, _nt, [&](size_t i) { _r[i] = b[i] - _r[i]; });
+	if(Record(_result, options, std::sqrt(Dot(_n, _r.data(), _r.data(), _nt)) / _bNorm))
+	{
+		return _result;
+	}
+	
+	Precondition(options.preconditioner, _n, _r.data(), _z.data(), _nt);
+	_p = _z;
+	double _rz = Dot(_n, _r.data(), _z.data(), _nt);
+	
+	while(_result.iterations < options.maxIterations)
+	{
+		++_result.iterations;
+		
+		A.Multiply(_p.data(), _Ap.data(), _nt);
+		const double _pAp = Dot(_n, _p.data(), _Ap.data(), _nt);
+		if(_pAp == 0.0)
+		{
+			break;
+		}
+		
+		const double _alpha = _rz / _pAp;
+		ForEach(_n, _nt, [&](size_t i)
+		{
+			x[i]  += _alpha * _p[i];
+			_r[i] -= _alpha * _Ap[i];
+		});
+		if(Record(_result, options, std::sqrt(Dot(_n, _r.data(), _r.data(), _nt)) / _bNorm))
+		{
+			break;
+		}
+		
+		Precondition(options.preconditioner, _n, _r.data(), _z.data(), _nt);
+		const double _rzNew = Dot(_n, _r.data(), _z.data(), _nt);
+		const double _beta  = _rzNew / _rz;
+		_rz = _rzNew;
+		ForEach(_n, _nt, [&](size_t i) { _p[i] = _z[i] + _beta * _p[i]; });
+	}
+	return _result;
+}
+
+SparseSolverResult glSolveBiCGSTAB(const SparseMatrix& A, const double* b, double* x, const SparseSolverOptions& options)
+{
+	assert(A.Rows() == A.Cols());
+	const size_t       _n  = A.Rows();
+	const unsigned int _nt = options.numThreads;
+	SparseSolverResult _result;
+	
+	const double _bNorm = std::sqrt(Dot(_n, b, b, _nt));
+	if(_bNorm == 0.0)
+	{
+		ForEach(_n, _nt, [&](size_t i) { x[i] = 0.0; });
+		_result.converged = true;
+		return _result;
+	}
+	
+	// r = b - A*x, the shadow residual is the initial residual.
+	std::vector<double> _r(_n), _rHat(_n), _p(_n, 0.0), _v(_n, 0.0), _pHat(_n), _s(_n), _sHat(_n), _t(_n);
+	A.Multiply(x, _r.data(), _nt);
+	ForEach(_n, _nt, [&](size_t i) { _r[i] = b[i] - _r[i]; });
+	if(Record(_result, options, std::sqrt(Dot(_n, _r.data(), _r.data(), _nt)) / _bNorm))
+	{
+		return _result;
+	}
+	_rHat = _r;
+	
+	double _rho   = 1.0;
+	double _alpha = 1.0;
+	double _omega = 1.0;
+	while(_result.iterations < options.maxIterations)
+	{
+		++_result.iterations;
+		
+		const double _rhoNew = Dot(_n, _rHat.data(), _r.data(), _nt);
+		if(_rhoNew == 0.0)
+		{
+			break;
+		}
+		const double _beta = (_rhoNew / _rho) * (_alpha / _omega);
+		_rho = _rhoNew;
+		ForEach(_n, _nt, [&](size_t i) { _p[i] = _r[i] + _beta * (_p[i] - _omega * _v[i]); });
+		
+		// first half step along the preconditioned search direction.
+		Precondition(options.preconditioner, _n, _p.data(), _pHat.data(), _nt);
+		A.Multiply(_pHat.data(), _v.data(), _nt);
+		const double _rHatV = Dot(_n, _rHat.data(), _v.data(), _nt);
+		if(_rHatV == 0.0)
+		{
+			break;
+		}
+		_alpha = _rho / _rHatV;
+		ForEach(_n, _nt, [&](size_t i) { _s[i] = _r[i] - _alpha * _v[i]; });
+		
+		const double _sNorm = std::sqrt(Dot(_n, _s.data(), _s.data(), _nt)) / _bNorm;
+		if(_sNorm <= options.tolerance)
+		{
+			ForEach(_n, _nt, [&](size_t i) { x[i] += _alpha * _pHat[i]; });
+			Record(_result, options, _sNorm);
+			break;
+		}
+		
+		// second half step minimizing the residual.
+		Precondition(options.preconditioner, _n, _s.data(), _sHat.data(), _nt);
+		A.Multiply(_sHat.data(), _t.data(), _nt);
+		const double _tt = Dot(_n, _t.data(), _t.data(), _nt);
+		_omega = _tt == 0.0 ? 0.0 : Dot(_n, _t.data(), _s.data(), _nt) / _tt;
+		ForEach(_n, _nt, [&](size_t i)
+		{
+			x[i]  += _alpha * _pHat[i] + _omega * _sHat[i];
+			_r[i]  = _s[i] - _omega * _t[i];
+		});
+		if(Record(_result, options, std::sqrt(Dot(_n, _r.data(), _r.data(), _nt)) / _bNorm) || _omega == 0.0)
+		{
+			break;
+		}
+	}
+	return _result;
+}
+// ------------------------------------------------------------------------- //
+
+};	// End namespace SMathLib.
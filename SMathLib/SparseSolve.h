@@ -0,0 +1,122 @@
+// 
+// This file is part of SLogLib; you can redistribute it and/or 
+// modify it under the terms of the MIT License.
+// Author: Saurabh Garg (saurabhgarg@mysoc.net)
+// 
+
+#ifndef _SMATHLIB_SPARSESOLVE_H_
+#define _SMATHLIB_SPARSESOLVE_H_
+
+#include "SMathLib/Config.h"
+#include "SMathLib/SparseMatrix.h"
+#include <vector>
+
+namespace SMathLib {
+;
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+// Preconditioned iterative solvers for sparse systems A*x = b:
+//
+//     JacobiPreconditioner _M(A);
+//     SparseSolverOptions  _options;
+//     _options.preconditioner = &_M;
+//     SparseSolverResult _result = glSolveCG(A, b, x, _options);
+//
+// x holds the initial guess on input and the solution on output. The vector
+// operations and the products with A are distributed over the thread pool,
+// the reductions are done in fixed blocks so that the results don't depend
+// on the number of threads.
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+//! Interface of the preconditioners, M approximates A and Apply() computes
+//! z = M^-1*r.
+class SMATHLIB_DLL_API SparsePreconditioner
+{
+public:
+
+	virtual ~SparsePreconditioner();
+	
+	//! z = M^-1*r, r and z must not overlap.
+	virtual void Apply(const double* r, double* z) const = 0;
+};
+
+//! Jacobi preconditioner, M = diag(A). Throws
+//! SUtils::Exceptions::InvalidArgumentException if a diagonal element is 0.
+class SMATHLIB_DLL_API JacobiPreconditioner : public SparsePreconditioner
+{
+public:
+
+	explicit JacobiPreconditioner(const SparseMatrix& A);
+	void Apply(const double* r, double* z) const override;
+
+private:
+
+	std::vector<double> mInvDiagonal;
+};
+
+//! Incomplete Cholesky preconditioner with no fill-in, M = L*L^T where L has
+//! the structure of the lower triangle of A. A must be symmetric positive
+//! definite; only its lower triangle is read. Throws
+//! SUtils::Exceptions::InvalidArgumentException if the factorization breaks
+//! down with a non-positive pivot.
+class SMATHLIB_DLL_API IncompleteCholeskyPreconditioner : public SparsePreconditioner
+{
+public:
+
+	explicit IncompleteCholeskyPreconditioner(const SparseMatrix& A);
+	void Apply(const double* r, double* z) const override;
+	
+	//! The incomplete factor L.
+	inline const SparseMatrix& Factor() const {return mL;}
+
+private:
+
+	SparseMatrix mL;
+};
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+//! Options of the iterative solvers.
+struct SMATHLIB_DLL_API SparseSolverOptions
+{
+	SparseSolverOptions();
+	
+	size_t                      maxIterations;   ///< Default 1000.
+	double                      tolerance;       ///< Relative residual |b-A*x|/|b| to reach, default 1e-10.
+	const SparsePreconditioner* preconditioner;  ///< nullptr for no preconditioning, the default.
+	bool                        keepResiduals;   ///< Record the residual of every iteration, default false.
+	unsigned int                numThreads;      ///< 0 means use glGetNumThreads(), the default.
+};
+
+//! Outcome of an iterative solve.
+struct SMATHLIB_DLL_API SparseSolverResult
+{
+	SparseSolverResult();
+	
+	bool                converged;    ///< The tolerance was reached.
+	size_t              iterations;   ///< Number of iterations performed.
+	double              residual;     ///< Final relative residual |b-A*x|/|b|.
+	std::vector<double> residuals;    ///< Relative residual after each iteration, if requested.
+};
+
+//! Solve A*x = b with the preconditioned conjugate gradient method. A must be
+//! symmetric positive definite and so must the preconditioner.
+//! \param A n x n matrix.
+//! \param b Right-hand side with n elements.
+//! \param x Initial guess with n elements, receives the solution.
+SMATHLIB_DLL_API SparseSolverResult glSolveCG(const SparseMatrix& A, const double* b, double* x,
+                                              const SparseSolverOptions& options = SparseSolverOptions());
+
+//! Solve A*x = b with the right-preconditioned BiCGSTAB method, for general
+//! square matrices. The parameters are the same as glSolveCG(). The solve
+//! stops early without converging if the method breaks down.
+SMATHLIB_DLL_API SparseSolverResult glSolveBiCGSTAB(const SparseMatrix& A, const double* b, double* x,
+                                                    const SparseSolverOptions& options = SparseSolverOptions());
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+
+};	// End namespace SMathLib.
+
+#endif // _SMATHLIB_SPARSESOLVE_H_
@@ -0,0 +1,97 @@
+// 
+// This file is part of SLogLib; you can redistribute it and/or 
+// modify it under the terms of the MIT License.
+// Author: Saurabh Garg (saurabhgarg@mysoc.net)
+// 
+
+#include "Svd.h"
+#include "EigenInterop.h"
+#include "Gemm.h"
+#include "SUtils/Exceptions/InvalidArgumentException.h"
+#include <Eigen/Dense>
+#include <Eigen/SVD>
+#include <algorithm>
+#include <random>
+
+namespace SMathLib {
+;
+
+// C = A*B for views with any strides.
+static Matrix Product(const ConstMatrixView& A, const ConstMatrixView& B, unsigned int numThreads)
+{
+	Matrix _C(A.Rows(), B.Cols(), MatrixType::Null);
+	glGemmStrided(A.Rows(), B.Cols(), A.Cols(), 1.0, A.Data(), A.RowStride(), A.ColStride(),
+	              B.Data(), B.RowStride(), B.ColStride(), 0.0, _C.matrix, _C.cols, numThreads);
+	return _C;
+}
+
+// replace the columns of Y with an orthonormal basis of their span, computed
+// with a Householder QR.
+static void Orthonormalize(Matrix& Y)
+{
+	const Eigen::HouseholderQR<Eigen::MatrixXd> _qr(Y.AsEigen());
+	Y.AsEigen() = _qr.householderQ() * Eigen::MatrixXd::Identity(Eigen::Index(Y.rows), Eigen::Index(Y.cols));
+}
+
+
+// randomized svd.
+// ------------------------------------------------------------------------- //
+RandomizedSvdOptions::RandomizedSvdOptions()
+	: oversampling(10), powerIterations(2), seed(0), numThreads(0)
+{}
+
+Matrix glRandomizedSvd(const ConstMatrixView& A, size_t k, Matrix* S, Matrix* V, const RandomizedSvdOptions& options)
+{
+	const size_t _m = A.Rows();
+	const size_t _n = A.Cols();
+	if(k > std::min(_m, _n))
+	{
+		char _msg[] = "k is larger than the smaller dimension in glRandomizedSvd";
+		throw SUtils::Exceptions::InvalidArgumentException(_msg);
+	}
+	const size_t       _l          = std::min(std::min(_m, _n), k + options.oversampling);
+	const unsigned int _numThreads = options.numThreads;
+	
+	// Gaussian sketch of the range of A.
+	Matrix                           _W(_n, _l, MatrixType::Null);
+	std::mt19937_64                  _engine(options.seed);
+	std::normal_distribution<double> _normal;
+	for(size_t i=0 ; i<_n*_l ; ++i)
+	{
+		_W.matrix[i] = _normal(_engine);
+	}
+	Matrix _Q = Product(A, _W.View(), _numThreads);
+	Orthonormalize(_Q);
+	
+	// power iterations, re-orthonormalized after every product so that the
+	// small singular values are not lost in rounding.
+	for(size_t q=0 ; q<options.powerIterations ; ++q)
+	{
+		_W = Product(A.Transpose(), _Q.View(), _numThreads);
+		Orthonormalize(_W);
+		_Q = Product(A, _W.View(), _numThreads);
+		Orthonormalize(_Q);
+	}
+	
+	// SVD of B = Q^T*A (l x n), computed as the transpose B^T = A^T*Q (n x l)
+	// which is tall.
+	// B^T is converted to column-major as it is copied into the SVD.
+	const Eigen::MatrixXd                _B = Product(A.Transpose(), _Q.View(), _numThreads).AsEigen();
+	const Eigen::BDCSVD<Eigen::MatrixXd> _svd(_B, Eigen::ComputeThinU | Eigen::ComputeThinV);
+	
+	// B^T = Ub*S*Vb^T, so B = Vb*S*Ub^T, U = Q*Vb and V = Ub.
+	const Eigen::Index _k = Eigen::Index(k);
+	const Matrix       _U(_Q.AsEigen() * _svd.matrixV().leftCols(_k));
+	if(V != nullptr)
+	{
+		glEigenOutput(*V, _n, k) = _svd.matrixU().leftCols(_k);
+	}
+	if(S != nullptr)
+	{
+		glEigenOutput(*S, k, 1) = _svd.singularValues().head(_k);
+	}
+	return _U;
+}
+// ------------------------------------------------------------------------- //
+
+};	// End namespace SMathLib.
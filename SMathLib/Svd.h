@@ -0,0 +1,60 @@
+// 
+// This file is part of SLogLib; you can redistribute it and/or 
+// modify it under the terms of the MIT License.
+// Author: Saurabh Garg (saurabhgarg@mysoc.net)
+// 
+
+#ifndef _SMATHLIB_SVD_H_
+#define _SMATHLIB_SVD_H_
+
+#include "SMathLib/Config.h"
+#include "SMathLib/Matrix.h"
+#include "SMathLib/MatrixView.h"
+#include <cstdint>
+
+namespace SMathLib {
+;
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+// Randomized truncated SVD for the k largest singular triplets of a large
+// matrix A (m x n). A random sketch Y = A*W with k + oversampling columns
+// finds the range of A, a few power iterations (A*A^T)^q*Y sharpen it for
+// slowly decaying spectra, and the SVD of the small projection Q^T*A gives
+// the triplets. A is only touched by 2*q + 2 GEMM passes, so the cost is
+// O(m*n*k) instead of the O(m*n*min(m, n)) of a full SVD:
+//
+//     Matrix _S, _V;
+//     Matrix _U = glRandomizedSvd(A, 20, &_S, &_V);    // Top 20 components.
+//
+// See Halko, Martinsson and Tropp, "Finding structure with randomness",
+// SIAM Review 53(2), 2011. For exact decompositions use Matrix::Svd().
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+//! Options of glRandomizedSvd().
+struct SMATHLIB_DLL_API RandomizedSvdOptions
+{
+	RandomizedSvdOptions();
+	
+	size_t       oversampling;       ///< Extra columns of the sketch, default 10.
+	size_t       powerIterations;    ///< Number of power iterations q, default 2.
+	uint64_t     seed;               ///< Seed of the random sketch, default 0.
+	unsigned int numThreads;         ///< 0 means use glGetNumThreads(), the default.
+};
+
+//! Randomized SVD of the k largest singular values of A, A ~ U*S*V^T.
+//! \param A m x n matrix.
+//! \param k Number of singular triplets, at most min(m, n).
+//! \param sigma Receives the singular values in decreasing order as a k x 1
+//!              matrix, can be nullptr.
+//! \param v Receives V as a n x k matrix, can be nullptr.
+//! \return U as a m x k matrix.
+//! Throws SUtils::Exceptions::InvalidArgumentException if k > min(m, n).
+SMATHLIB_DLL_API Matrix glRandomizedSvd(const ConstMatrixView& A, size_t k, Matrix* sigma, Matrix* v,
+                                        const RandomizedSvdOptions& options = RandomizedSvdOptions());
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+
+};	// End namespace SMathLib.
+
+#endif // _SMATHLIB_SVD_H_
@@ -0,0 +1,383 @@
+// 
+// This file is part of SLogLib; you can redistribute it and/or 
+// modify it under the terms of the MIT License.
+// Author: Saurabh Garg (saurabhgarg@mysoc.net)
+// 
+
+#include "TextParser.h"
+#include "Parallel.h"
+#include "SUtils/Exceptions/InvalidArgumentException.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <istream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#if __cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L)
+#	include <charconv>
+#endif
+
+namespace SMathLib {
+;
+
+// size of the blocks read from a stream.
+static const size_t gcReadBlockSize = size_t(8) << 20;
+
+// minimum size of the chunks parsed by one thread.
+static const size_t gcMinChunkSize = size_t(256) << 10;
+
+// longest token echoed in the error messages.
+static const size_t gcMaxTokenEcho = 32;
+
+
+// tokens.
+// ------------------------------------------------------------------------- //
+static inline bool IsSeparator(char c)
+{
+	return c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == ',' || c == ';' || c == '\v' || c == '\f';
+}
+
+// parse the number starting at p, returns the end of the number or nullptr if
+// the token is not a valid number.
+template<typename T>
+static inline const char* ParseNumber(const char* p, const char* end, T& value)
+{
+	// std::from_chars does not accept a leading '+'.
+	if(*p == '+' && p+1 != end && p[1] != '-' && p[1] != '+')
+	{
+		++p;
+	}
+
+#if defined(__cpp_lib_to_chars)
+	const std::from_chars_result _result = std::from_chars(p, end, value);
+	if(_result.ec != std::errc() || (_result.ptr != end && !IsSeparator(*_result.ptr)))
+	{
+		return nullptr;
+	}
+	return _result.ptr;
+#else
+	// strtod needs a terminated string.
+	char        _token[64];
+	const char* _tokenEnd = p;
+	while(_tokenEnd != end && !IsSeparator(*_tokenEnd))
+	{
+		++_tokenEnd;
+	}
+	if(size_t(_tokenEnd - p) >= sizeof(_token))
+	{
+		return nullptr;
+	}
+	std::memcpy(_token, p, size_t(_tokenEnd - p));
+	_token[_tokenEnd - p] = '\0';
+	char* _last = nullptr;
+	value = T(std::strtod(_token, &_last));
+	if(_last != _token + (_tokenEnd - p) || _last == _token)
+	{
+		return nullptr;
+	}
+	return _tokenEnd;
+#endif
+}
+
+static size_t CountTokens(const char* begin, const char* end)
+{
+	size_t _count = 0;
+	bool   _inToken = false;
+	for(const char* p=begin ; p!=end ; ++p)
+	{
+		const bool _separator = IsSeparator(*p);
+		_count  += (!_separator && !_inToken) ? 1 : 0;
+		_inToken = !_separator;
+	}
+	return _count;
+}
+
+// throw an error at the given line and column, token is the offending token
+// which can be empty.
+static void ThrowError(const std::string& token, size_t line, size_t column, const char* what, const char* func)
+{
+	std::ostringstream _msg;
+	_msg << what;
+	if(!token.empty())
+	{
+		_msg << " '" << token.substr(0, gcMaxTokenEcho) << "'";
+	}
+	_msg << " at line " << line << ", column " << column << " in " << func;
+	throw SUtils::Exceptions::InvalidArgumentException(_msg.str().c_str());
+}
+
+// throw an error at position p of the text which starts at begin on line
+// firstLine.
+static void ThrowParseError(const char* begin, const char* p, const char* end, size_t firstLine,
+                            const char* what, const char* func)
+{
+	size_t      _line      = firstLine + size_t(std::count(begin, p, '\n'));
+	const char* _lineStart = p;
+	while(_lineStart != begin && _lineStart[-1] != '\n')
+	{
+		--_lineStart;
+	}
+	
+	const char* _tokenEnd = p;
+	while(_tokenEnd != end && !IsSeparator(*_tokenEnd) && size_t(_tokenEnd - p) < gcMaxTokenEcho)
+	{
+		++_tokenEnd;
+	}
+	ThrowError(std::string(p, _tokenEnd), _line, size_t(p - _lineStart + 1), what, func);
+}
+// ------------------------------------------------------------------------- //
+
+
+// blocks.
+// ------------------------------------------------------------------------- //
+// parse up to count numbers from [begin, end), which must end at a line
+// boundary or at the end of the input. The block is split at line boundaries
+// into chunks, the tokens of each chunk are counted and then the chunks are
+// parsed directly into their part of out.
+// returns the end of the last parsed number, or end if fewer than count
+// numbers were found; numParsed receives the number of parsed numbers.
+template<typename T>
+static const char* ParseBlock(const char* begin, const char* end, T* out, size_t count, size_t& numParsed,
+                              size_t firstLine, unsigned int numThreads, const char* func)
+{
+	const unsigned int _numThreads = numThreads == 0 ? glGetNumThreads() : numThreads;
+	const size_t       _chunkSize  = std::max(gcMinChunkSize, size_t(end - begin) / (4 * size_t(_numThreads)) + 1);
+	
+	std::vector<const char*> _chunks(1, begin);
+	while(_chunks.back() != end)
+	{
+		const char* _next = _chunks.back() + std::min(_chunkSize, size_t(end - _chunks.back()));
+		if(_next != end)
+		{
+			const void* _newline = std::memchr(_next, '\n', size_t(end - _next));
+			_next = _newline == nullptr ? end : static_cast<const char*>(_newline) + 1;
+		}
+		_chunks.push_back(_next);
+	}
+	const size_t _numChunks = _chunks.size() - 1;
+	
+	// count the tokens of each chunk and find where they go in out.
+	std::vector<size_t> _offsets(_numChunks+1, 0);
+	glParallelFor(0, _numChunks, 1, [&](size_t c1, size_t c2)
+	{
+		for(size_t c=c1 ; c<c2 ; ++c)
+		{
+			_offsets[c+1] = CountTokens(_chunks[c], _chunks[c+1]);
+		}
+	}, numThreads);
+	for(size_t c=0 ; c<_numChunks ; ++c)
+	{
+		_offsets[c+1] += _offsets[c];
+	}
+	
+	// parse the chunks which hold the first count tokens.
+	std::vector<const char*> _errors(_numChunks, nullptr);
+	std::vector<const char*> _stops(_numChunks, nullptr);
+	glParallelFor(0, _numChunks, 1, [&](size_t c1, size_t c2)
+	{
+		for(size_t c=c1 ; c<c2 && _offsets[c]<count ; ++c)
+		{
+			const char* p     = _chunks[c];
+			const char* _end  = _chunks[c+1];
+			T*          _out  = out + _offsets[c];
+			size_t      _left = std::min(_offsets[c+1], count) - _offsets[c];
+			while(_left > 0)
+			{
+				while(IsSeparator(*p))
+				{
+					++p;
+				}
+				const char* _numberEnd = ParseNumber(p, _end, *_out);
+				if(_numberEnd == nullptr)
+				{
+					_errors[c] = p;
+					break;
+				}
+				p = _numberEnd;
+				++_out;
+				--_left;
+			}
+			_stops[c] = p;
+		}
+	}, numThreads);
+	
+	for(size_t c=0 ; c<_numChunks ; ++c)
+	{
+		if(_errors[c] != nullptr)
+		{
+			ThrowParseError(begin, _errors[c], end, firstLine, "Invalid number", func);
+		}
+	}
+	
+	numParsed = std::min(_offsets[_numChunks], count);
+	if(numParsed < count || numParsed == 0)
+	{
+		return end;
+	}
+	const size_t _last = size_t(std::upper_bound(_offsets.begin(), _offsets.end(), count-1) - _offsets.begin()) - 1;
+	return _stops[_last];
+}
+// ------------------------------------------------------------------------- //
+
+
+// parsing.
+// ------------------------------------------------------------------------- //
+template<typename T>
+static const char* ParseNumbers(const char* begin, const char* end, T* out, size_t count, unsigned int numThreads)
+{
+	size_t      _numParsed = 0;
+	const char* _stop      = ParseBlock(begin, end, out, count, _numParsed, 1, numThreads, "glParseNumbers");
+	if(_numParsed < count)
+	{
+		ThrowParseError(begin, end, end, 1, "Unexpected end of input", "glParseNumbers");
+	}
+	return count == 0 ? begin : _stop;
+}
+
+// read count numbers from a stream which can't seek one character at a time,
+// so that nothing after the last number is consumed.
+template<typename T>
+static void ReadNumbersByToken(std::istream& in, T* out, size_t count)
+{
+	const int       _eof    = std::char_traits<char>::eof();
+	std::streambuf* _buffer = in.rdbuf();
+	std::string     _token;
+	size_t          _line   = 1;
+	size_t          _column = 1;
+	int             _c      = _buffer->sgetc();
+	for(size_t i=0 ; i<count ; ++i)
+	{
+		while(_c != _eof && IsSeparator(char(_c)))
+		{
+			_column = _c == '\n' ? 1 : _column+1;
+			_line  += _c == '\n' ? 1 : 0;
+			_c      = _buffer->snextc();
+		}
+		if(_c == _eof)
+		{
+			in.setstate(std::ios::eofbit | std::ios::failbit);
+			ThrowError(std::string(), _line, _column, "Unexpected end of input", "glReadNumbers");
+		}
+		
+		const size_t _tokenColumn = _column;
+		_token.clear();
+		while(_c != _eof && !IsSeparator(char(_c)))
+		{
+			_token.push_back(char(_c));
+			++_column;
+			_c = _buffer->snextc();
+		}
+		const char* _end = _token.data() + _token.size();
+		if(ParseNumber(_token.data(), _end, out[i]) != _end)
+		{
+			ThrowError(_token, _line, _tokenColumn, "Invalid number", "glReadNumbers");
+		}
+	}
+	if(_c == _eof)
+	{
+		in.setstate(std::ios::eofbit);
+	}
+}
+
+template<typename T>
+static void ReadNumbers(std::istream& in, T* out, size_t count, unsigned int numThreads)
+{
+	if(count == 0)
+	{
+		return;
+	}
+	
+	std::istream::pos_type _blockStart = in.tellg();
+	if(_blockStart == std::istream::pos_type(-1))
+	{
+		ReadNumbersByToken(in, out, count);
+		return;
+	}
+	
+	// the blocks are positioned with tellg() and in.ignore(), not by adding
+	// byte counts to positions, because a stream in text mode can read fewer
+	// characters than the bytes of the file, e.g. for \r\n line endings.
+	std::vector<char> _buffer;
+	size_t            _blockCapacity = gcReadBlockSize;
+	size_t            _consumed      = 0;    // characters of the last block parsed.
+	size_t            _line          = 1;
+	size_t            _parsed        = 0;
+	while(true)
+	{
+		_buffer.resize(_blockCapacity);
+		in.read(_buffer.data(), std::streamsize(_blockCapacity));
+		const size_t _size = size_t(in.gcount());
+		const bool   _eof  = _size < _blockCapacity;
+		
+		// parse up to the last complete line, the block is read again with a
+		// larger capacity if it holds no complete line.
+		size_t _blockSize = _size;
+		if(!_eof)
+		{
+			const char* _last = _buffer.data() + _size;
+			while(_last != _buffer.data() && _last[-1] != '\n')
+			{
+				--_last;
+			}
+			if(_last == _buffer.data())
+			{
+				_blockCapacity *= 2;
+				in.seekg(_blockStart);
+				continue;
+			}
+			_blockSize = size_t(_last - _buffer.data());
+		}
+		
+		const char* _begin = _buffer.data();
+		const char* _end   = _begin + _blockSize;
+		size_t      _numParsed = 0;
+		const char* _stop = ParseBlock(_begin, _end, out + _parsed, count - _parsed, _numParsed, _line, numThreads,
+		                               "glReadNumbers");
+		_parsed += _numParsed;
+		if(_parsed == count)
+		{
+			_consumed = size_t(_stop - _begin);
+			break;
+		}
+		if(_eof)
+		{
+			ThrowParseError(_begin, _end, _end, _line, "Unexpected end of input", "glReadNumbers");
+		}
+		
+		// the next block starts after the last complete line.
+		_line += size_t(std::count(_begin, _end, '\n'));
+		in.seekg(_blockStart);
+		in.ignore(std::streamsize(_blockSize));
+		_blockStart = in.tellg();
+	}
+	
+	// leave the stream just after the last number.
+	in.clear();
+	in.seekg(_blockStart);
+	in.ignore(std::streamsize(_consumed));
+}
+
+const char* glParseNumbers(const char* begin, const char* end, double* out, size_t count, unsigned int numThreads)
+{
+	return ParseNumbers(begin, end, out, count, numThreads);
+}
+
+const char* glParseNumbers(const char* begin, const char* end, float* out, size_t count, unsigned int numThreads)
+{
+	return ParseNumbers(begin, end, out, count, numThreads);
+}
+
+void glReadNumbers(std::istream& in, double* out, size_t count, unsigned int numThreads)
+{
+	ReadNumbers(in, out, count, numThreads);
+}
+
+void glReadNumbers(std::istream& in, float* out, size_t count, unsigned int numThreads)
+{
+	ReadNumbers(in, out, count, numThreads);
+}
+// ------------------------------------------------------------------------- //
+
+};	// End namespace SMathLib.
@@ -0,0 +1,52 @@
+// 
+// This file is part of SLogLib; you can redistribute it and/or 
+// modify it under the terms of the MIT License.
+// Author: Saurabh Garg (saurabhgarg@mysoc.net)
+// 
+
+#ifndef _SMATHLIB_TEXTPARSER_H_
+#define _SMATHLIB_TEXTPARSER_H_
+
+#include "SMathLib/Config.h"
+#include <cstddef>
+#include <iosfwd>
+
+namespace SMathLib {
+;
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+// Fast parsing of numbers from text, used by Matrix::Read() and the stream
+// operators of Matrix and Vector3DArray. The numbers are separated by
+// whitespace, commas or semicolons and parsed with std::from_chars, so the
+// parsing does not depend on the locale of the stream. Numbers parsed into
+// float are rounded once, directly from the text. The input is read in
+// large blocks which are split at line boundaries into chunks; the chunks
+// are parsed on the thread pool directly into the output array.
+//
+// Invalid numbers and a premature end of the input throw
+// SUtils::Exceptions::InvalidArgumentException with the line and column of
+// the error. Lines and columns start at 1 from where the parsing started.
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+//! Parse count numbers from the text [begin, end) into out. The text after
+//! the last number is ignored.
+//! \param numThreads Number of threads to use, 0 means use glGetNumThreads().
+//! \return Pointer to the character after the last number.
+SMATHLIB_DLL_API const char* glParseNumbers(const char* begin, const char* end, double* out, size_t count,
+                                            unsigned int numThreads = 0);
+SMATHLIB_DLL_API const char* glParseNumbers(const char* begin, const char* end, float* out, size_t count,
+                                            unsigned int numThreads = 0);
+
+//! Read count numbers from a stream into out, the stream is left just after
+//! the last number. A stream which can't seek, e.g. a pipe, is read one
+//! character at a time and is not parsed in parallel.
+//! \param numThreads Number of threads to use, 0 means use glGetNumThreads().
+SMATHLIB_DLL_API void glReadNumbers(std::istream& in, double* out, size_t count, unsigned int numThreads = 0);
+SMATHLIB_DLL_API void glReadNumbers(std::istream& in, float* out, size_t count, unsigned int numThreads = 0);
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+
+};	// End namespace SMathLib.
+
+#endif // _SMATHLIB_TEXTPARSER_H_
@@ -0,0 +1,430 @@
+// 
+// This file is part of SLogLib; you can redistribute it and/or 
+// modify it under the terms of the MIT License.
+// Author: Saurabh Garg (saurabhgarg@mysoc.net)
+// 
+
+#include "TiledMatrix.h"
+#include "Gemm.h"
+#include "Parallel.h"
+#include "Transpose.h"
+#include "SUtils/Exceptions/InvalidArgumentException.h"
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+
+namespace SMathLib {
+;
+
+// the file starts with a header of one page so that the tiles are aligned.
+static const size_t gcTiledHeaderSize = 4096;
+static const char   gcTiledMagic[8]   = {'S', 'M', 'T', 'I', 'L', 'E', 'D', '1'};
+
+// memory used by the panels of glTiledGemm() by default.
+static const size_t gcDefaultGemmBudget = size_t(1) << 30;
+
+// the header stored at the start of the file.
+struct TiledHeader
+{
+	char     magic[8];
+	uint64_t rows;
+	uint64_t cols;
+	uint64_t tileSize;
+};
+
+
+// constructors.
+// ------------------------------------------------------------------------- //
+TiledMatrix::TiledMatrix()
+	: mRows(0), mCols(0), mTileSize(1)
+{}
+
+TiledMatrix::TiledMatrix(TiledMatrix&& B)
+	: mFile(std::move(B.mFile)), mRows(B.mRows), mCols(B.mCols), mTileSize(B.mTileSize)
+{
+	B.mRows     = 0;
+	B.mCols     = 0;
+	B.mTileSize = 1;
+}
+
+TiledMatrix& TiledMatrix::operator=(TiledMatrix&& B)
+{
+	std::swap(mFile    , B.mFile    );
+	std::swap(mRows    , B.mRows    );
+	std::swap(mCols    , B.mCols    );
+	std::swap(mTileSize, B.mTileSize);
+	return *this;
+}
+
+TiledMatrix TiledMatrix::Create(const std::string& fileName, size_t rows, size_t cols, size_t tileSize)
+{
+	if(tileSize == 0)
+	{
+		char _msg[] = "Tile size must be positive in TiledMatrix::Create";
+		throw SUtils::Exceptions::InvalidArgumentException(_msg);
+	}
+	
+	TiledMatrix _A;
+	_A.mRows     = rows;
+	_A.mCols     = cols;
+	_A.mTileSize = tileSize;
+	_A.mFile.Create(fileName, gcTiledHeaderSize + _A.NumTileRows()*_A.NumTileCols()*_A.TileBytes());
+	
+	TiledHeader _header;
+	std::memcpy(_header.magic, gcTiledMagic, sizeof(gcTiledMagic));
+	_header.rows     = rows;
+	_header.cols     = cols;
+	_header.tileSize = tileSize;
+	std::memcpy(_A.mFile.WritableData(), &_header, sizeof(_header));
+	return _A;
+}
+
+TiledMatrix TiledMatrix::Open(const std::string& fileName, bool writable)
+{
+	TiledMatrix _A;
+	_A.mFile.Open(fileName, writable);
+	
+	TiledHeader _header;
+	if(_A.mFile.Size() < gcTiledHeaderSize ||
+	   std::memcmp(std::memcpy(&_header, _A.mFile.Data(), sizeof(_header)), gcTiledMagic, sizeof(gcTiledMagic)) != 0 ||
+	   _header.tileSize == 0)
+	{
+		std::string _msg = fileName + " is not a tiled matrix in TiledMatrix::Open";
+		throw SUtils::Exceptions::InvalidArgumentException(_msg.c_str());
+	}
+	_A.mRows     = size_t(_header.rows);
+	_A.mCols     = size_t(_header.cols);
+	_A.mTileSize = size_t(_header.tileSize);
+	if(_A.mFile.Size() != gcTiledHeaderSize + _A.NumTileRows()*_A.NumTileCols()*_A.TileBytes())
+	{
+		std::string _msg = fileName + " has the wrong size in TiledMatrix::Open";
+		throw SUtils::Exceptions::InvalidArgumentException(_msg.c_str());
+	}
+	return _A;
+}
+
+void TiledMatrix::Flush() const
+{
+	mFile.Flush();
+}
+
+void TiledMatrix::Close()
+{
+	mFile.Close();
+	mRows     = 0;
+	mCols     = 0;
+	mTileSize = 1;
+}
+// ------------------------------------------------------------------------- //
+
+
+// element access.
+// ------------------------------------------------------------------------- //
+size_t TiledMatrix::TileOffset(size_t ti, size_t tj) const
+{
+	return gcTiledHeaderSize + (ti*NumTileCols() + tj)*TileBytes();
+}
+
+size_t TiledMatrix::TileBytes() const
+{
+	return mTileSize*mTileSize*sizeof(double);
+}
+
+ConstMatrixView TiledMatrix::Tile(size_t ti, size_t tj) const
+{
+	assert(ti < NumTileRows() && tj < NumTileCols());
+	const double* _data = reinterpret_cast<const double*>(mFile.Data() + TileOffset(ti, tj));
+	return ConstMatrixView(_data, TileRows(ti), TileCols(tj), mTileSize, 1);
+}
+
+MatrixView TiledMatrix::Tile(size_t ti, size_t tj)
+{
+	assert(ti < NumTileRows() && tj < NumTileCols());
+	double* _data = reinterpret_cast<double*>(mFile.WritableData() + TileOffset(ti, tj));
+	return MatrixView(_data, TileRows(ti), TileCols(tj), mTileSize, 1);
+}
+
+double TiledMatrix::operator ()(size_t r, size_t c) const
+{
+	assert(r < mRows && c < mCols);
+	return Tile(r / mTileSize, c / mTileSize)(r % mTileSize, c % mTileSize);
+}
+
+double& TiledMatrix::operator ()(size_t r, size_t c)
+{
+	assert(r < mRows && c < mCols);
+	return Tile(r / mTileSize, c / mTileSize)(r % mTileSize, c % mTileSize);
+}
+// ------------------------------------------------------------------------- //
+
+
+// paging hints.
+// ------------------------------------------------------------------------- //
+void TiledMatrix::PrefetchTile(size_t ti, size_t tj) const
+{
+	mFile.Prefetch(TileOffset(ti, tj), TileBytes());
+}
+
+void TiledMatrix::PrefetchTiles(size_t ti, size_t tj1, size_t tj2) const
+{
+	if(tj2 > tj1)
+	{
+		mFile.Prefetch(TileOffset(ti, tj1), (tj2-tj1)*TileBytes());
+	}
+}
+
+void TiledMatrix::EvictTile(size_t ti, size_t tj) const
+{
+	mFile.Evict(TileOffset(ti, tj), TileBytes());
+}
+
+void TiledMatrix::EvictTiles(size_t ti, size_t tj1, size_t tj2) const
+{
+	if(tj2 > tj1)
+	{
+		mFile.Evict(TileOffset(ti, tj1), (tj2-tj1)*TileBytes());
+	}
+}
+// ------------------------------------------------------------------------- //
+
+
+// conversion.
+// ------------------------------------------------------------------------- //
+void TiledMatrix::Assign(const ConstMatrixView& A)
+{
+	if(A.Rows() != mRows || A.Cols() != mCols)
+	{
+		char _msg[] = "Matrix size mismatch in TiledMatrix::Assign";
+		throw SUtils::Exceptions::InvalidArgumentException(_msg);
+	}
+	
+	for(size_t ti=0 ; ti<NumTileRows() ; ++ti)
+	{
+		glParallelFor(0, NumTileCols(), 1, [&](size_t tj1, size_t tj2)
+		{
+			for(size_t tj=tj1 ; tj<tj2 ; ++tj)
+			{
+				Tile(ti, tj) = A.Block(ti*mTileSize, tj*mTileSize, ti*mTileSize+TileRows(ti)-1, tj*mTileSize+TileCols(tj)-1);
+			}
+		});
+		EvictTiles(ti, 0, NumTileCols());
+	}
+}
+
+Matrix TiledMatrix::ToMatrix() const
+{
+	Matrix _A(mRows, mCols, MatrixType::Null);
+	for(size_t ti=0 ; ti<NumTileRows() ; ++ti)
+	{
+		glParallelFor(0, NumTileCols(), 1, [&](size_t tj1, size_t tj2)
+		{
+			for(size_t tj=tj1 ; tj<tj2 ; ++tj)
+			{
+				_A.View().Block(ti*mTileSize, tj*mTileSize, ti*mTileSize+TileRows(ti)-1, tj*mTileSize+TileCols(tj)-1) = Tile(ti, tj);
+			}
+		});
+		EvictTiles(ti, 0, NumTileCols());
+	}
+	return _A;
+}
+// ------------------------------------------------------------------------- //
+
+
+// operations.
+// ------------------------------------------------------------------------- //
+void TiledMatrix::TransposeTo(TiledMatrix& B) const
+{
+	if(B.mRows != mCols || B.mCols != mRows || B.mTileSize != mTileSize)
+	{
+		char _msg[] = "Matrix size mismatch in TiledMatrix::TransposeTo";
+		throw SUtils::Exceptions::InvalidArgumentException(_msg);
+	}
+	
+	// tile (ti, tj) is transposed into tile (tj, ti) of B.
+	for(size_t ti=0 ; ti<NumTileRows() ; ++ti)
+	{
+		if(ti+1 < NumTileRows())
+		{
+			PrefetchTiles(ti+1, 0, NumTileCols());
+		}
+		glParallelFor(0, NumTileCols(), 1, [&](size_t tj1, size_t tj2)
+		{
+			for(size_t tj=tj1 ; tj<tj2 ; ++tj)
+			{
+				const ConstMatrixView _src = Tile(ti, tj);
+				const MatrixView      _dst = B.Tile(tj, ti);
+				glTranspose(_src.Rows(), _src.Cols(), _src.Data(), _src.RowStride(), _dst.Data(), _dst.RowStride());
+				B.EvictTile(tj, ti);
+			}
+		});
+		EvictTiles(ti, 0, NumTileCols());
+	}
+}
+
+Matrix TiledMatrix::SumRows() const
+{
+	Matrix _sums(mRows, 1, MatrixType::Zero);
+	for(size_t ti=0 ; ti<NumTileRows() ; ++ti)
+	{
+		if(ti+1 < NumTileRows())
+		{
+			PrefetchTiles(ti+1, 0, NumTileCols());
+		}
+		
+		// the rows of a tile row are split over the threads.
+		glParallelFor(0, TileRows(ti), 16, [&](size_t i1, size_t i2)
+		{
+			for(size_t tj=0 ; tj<NumTileCols() ; ++tj)
+			{
+				const ConstMatrixView _tile = Tile(ti, tj);
+				for(size_t i=i1 ; i<i2 ; ++i)
+				{
+					double _s = 0.0;
+					for(size_t j=0 ; j<_tile.Cols() ; ++j)
+					{
+						_s += _tile(i, j);
+					}
+					_sums.matrix[ti*mTileSize+i] += _s;
+				}
+			}
+		});
+		EvictTiles(ti, 0, NumTileCols());
+	}
+	return _sums;
+}
+
+Matrix TiledMatrix::SumCols() const
+{
+	Matrix _sums(1, mCols, MatrixType::Zero);
+	for(size_t ti=0 ; ti<NumTileRows() ; ++ti)
+	{
+		if(ti+1 < NumTileRows())
+		{
+			PrefetchTiles(ti+1, 0, NumTileCols());
+		}
+		
+		// the tiles of a tile row add to disjoint columns.
+		glParallelFor(0, NumTileCols(), 1, [&](size_t tj1, size_t tj2)
+		{
+			for(size_t tj=tj1 ; tj<tj2 ; ++tj)
+			{
+				const ConstMatrixView _tile = Tile(ti, tj);
+				double*               _s    = _sums.matrix + tj*mTileSize;
+				for(size_t i=0 ; i<_tile.Rows() ; ++i)
+				{
+					for(size_t j=0 ; j<_tile.Cols() ; ++j)
+					{
+						_s[j] += _tile(i, j);
+					}
+				}
+			}
+		});
+		EvictTiles(ti, 0, NumTileCols());
+	}
+	return _sums;
+}
+// ------------------------------------------------------------------------- //
+
+
+// products.
+// ------------------------------------------------------------------------- //
+void glTiledGemm(double alpha, const TiledMatrix& A, const TiledMatrix& B, double beta, TiledMatrix& C,
+                 size_t memoryBudget, unsigned int numThreads)
+{
+	if(A.Cols() != B.Rows() || C.Rows() != A.Rows() || C.Cols() != B.Cols())
+	{
+		char _msg[] = "Matrix size mismatch in glTiledGemm";
+		throw SUtils::Exceptions::InvalidArgumentException(_msg);
+	}
+	if(A.TileSize() != B.TileSize() || A.TileSize() != C.TileSize())
+	{
+		char _msg[] = "Tile size mismatch in glTiledGemm";
+		throw SUtils::Exceptions::InvalidArgumentException(_msg);
+	}
+	
+	const size_t _ts  = A.TileSize();
+	const size_t _nTi = C.NumTileRows();
+	const size_t _nTj = C.NumTileCols();
+	const size_t _nTk = A.NumTileCols();
+	
+	// with an empty inner dimension the product is 0 and only C is scaled.
+	if(_nTk == 0)
+	{
+		for(size_t ti=0 ; ti<_nTi ; ++ti)
+		{
+			for(size_t tj=0 ; tj<_nTj ; ++tj)
+			{
+				if(beta == 0.0)
+				{
+					C.Tile(ti, tj).Fill(0.0);
+				}
+				else
+				{
+					C.Tile(ti, tj) *= beta;
+				}
+			}
+			C.EvictTiles(ti, 0, _nTj);
+		}
+		return;
+	}
+	
+	// a panel holds a tile row of A and one tile of C for each of its tile
+	// rows; every tile of B is read once per panel.
+	const size_t _tileBytes = _ts*_ts*sizeof(double);
+	const size_t _budget    = memoryBudget == 0 ? gcDefaultGemmBudget : memoryBudget;
+	const size_t _panel     = std::max<size_t>(1, _budget / ((_nTk+1)*_tileBytes));
+	for(size_t ti1=0 ; ti1<_nTi ; ti1+=_panel)
+	{
+		const size_t _ti2 = std::min(_nTi, ti1+_panel);
+		for(size_t ti=ti1 ; ti<_ti2 ; ++ti)
+		{
+			A.PrefetchTiles(ti, 0, _nTk);
+		}
+		B.PrefetchTile(0, 0);
+		
+		for(size_t tj=0 ; tj<_nTj ; ++tj)
+		{
+			for(size_t tk=0 ; tk<_nTk ; ++tk)
+			{
+				// B is read down its tile columns.
+				if(tk+1 < _nTk)
+				{
+					B.PrefetchTile(tk+1, tj);
+				}
+				else if(tj+1 < _nTj)
+				{
+					B.PrefetchTile(0, tj+1);
+				}
+				
+				// the tiles of the panel are multiplied in parallel, a panel of
+				// one tile row uses the threads inside glGemm() instead.
+				const ConstMatrixView _B    = B.Tile(tk, tj);
+				const double          _beta = tk == 0 ? beta : 1.0;
+				glParallelFor(ti1, _ti2, 1, [&](size_t i1, size_t i2)
+				{
+					for(size_t ti=i1 ; ti<i2 ; ++ti)
+					{
+						const ConstMatrixView _A = A.Tile(ti, tk);
+						const MatrixView      _C = C.Tile(ti, tj);
+						glGemm(_C.Rows(), _C.Cols(), _A.Cols(), alpha, _A.Data(), _ts, _B.Data(), _ts,
+						       _beta, _C.Data(), _ts, numThreads);
+					}
+				}, numThreads);
+				B.EvictTile(tk, tj);
+			}
+			for(size_t ti=ti1 ; ti<_ti2 ; ++ti)
+			{
+				C.EvictTile(ti, tj);
+			}
+		}
+		
+		for(size_t ti=ti1 ; ti<_ti2 ; ++ti)
+		{
+			A.EvictTiles(ti, 0, _nTk);
+		}
+	}
+}
+// ------------------------------------------------------------------------- //
+
+};	// End namespace SMathLib.
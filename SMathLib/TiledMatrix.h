@@ -0,0 +1,146 @@
+// 
+// This file is part of SLogLib; you can redistribute it and/or 
+// modify it under the terms of the MIT License.
+// Author: Saurabh Garg (saurabhgarg@mysoc.net)
+// 
+
+#ifndef _SMATHLIB_TILEDMATRIX_H_
+#define _SMATHLIB_TILEDMATRIX_H_
+
+#include "SMathLib/Config.h"
+#include "SMathLib/MappedFile.h"
+#include "SMathLib/Matrix.h"
+#include "SMathLib/MatrixView.h"
+#include <algorithm>
+#include <string>
+
+namespace SMathLib {
+;
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+// Out-of-core matrices for data larger than the memory. A TiledMatrix lives
+// in a memory-mapped file and stores its elements in square tiles of
+// TileSize() x TileSize() elements; each tile is contiguous and row-major and
+// the tiles are stored row by row. The tiles on the last tile row and column
+// are padded to the full size.
+//
+//     TiledMatrix _A = TiledMatrix::Create("A.tiled", n, n);
+//     TiledMatrix _B = TiledMatrix::Create("B.tiled", n, n);
+//     TiledMatrix _C = TiledMatrix::Create("C.tiled", n, n);
+//     ...                                 // Fill A and B tile by tile.
+//     glTiledGemm(1.0, _A, _B, 0.0, _C);
+//
+// The operations walk the tiles in file order and tell the operating system
+// which tiles are needed next (Prefetch) and which are done (Evict), so the
+// memory used stays bounded and the file is read almost sequentially.
+//
+// Invalid sizes throw SUtils::Exceptions::InvalidArgumentException, file
+// errors throw SUtils::Exceptions::InvalidOperationException.
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+//! Disk-backed matrix stored in square tiles, see above.
+class SMATHLIB_DLL_API TiledMatrix
+{
+public:  // Constructors.
+
+	TiledMatrix();
+	TiledMatrix(TiledMatrix&& B);
+	TiledMatrix& operator=(TiledMatrix&& B);
+	
+	TiledMatrix(const TiledMatrix&) = delete;
+	TiledMatrix& operator=(const TiledMatrix&) = delete;
+	
+	//! Create a rows x cols matrix of zeros in a new file, an existing file is
+	//! overwritten. The default tile size of 256 gives tiles of 512 KB.
+	static TiledMatrix Create(const std::string& fileName, size_t rows, size_t cols, size_t tileSize = 256);
+	
+	//! Open a file written by a TiledMatrix.
+	static TiledMatrix Open(const std::string& fileName, bool writable = true);
+	
+	//! Write the modified tiles back to the file.
+	void Flush() const;
+	void Close();
+	inline bool IsOpen() const {return mFile.IsOpen();}
+
+public:  // Size.
+
+	inline size_t Rows() const        {return mRows;}
+	inline size_t Cols() const        {return mCols;}
+	inline size_t TileSize() const    {return mTileSize;}
+	inline size_t NumTileRows() const {return (mRows + mTileSize - 1) / mTileSize;}
+	inline size_t NumTileCols() const {return (mCols + mTileSize - 1) / mTileSize;}
+	
+	//! Number of rows of the tiles on tile row ti and number of columns of
+	//! the tiles on tile column tj.
+	inline size_t TileRows(size_t ti) const {return std::min(mTileSize, mRows - ti*mTileSize);}
+	inline size_t TileCols(size_t tj) const {return std::min(mTileSize, mCols - tj*mTileSize);}
+
+public:  // Element access.
+
+	//! View of tile (ti, tj) without the padding. The non-const access
+	//! functions need a matrix opened for writing.
+	ConstMatrixView Tile(size_t ti, size_t tj) const;
+	MatrixView      Tile(size_t ti, size_t tj);
+	
+	double  operator ()(size_t r, size_t c) const;
+	double& operator ()(size_t r, size_t c);
+
+public:  // Paging hints.
+
+	//! Start reading tile (ti, tj) or the tiles [tj1, tj2) of tile row ti
+	//! into memory.
+	void PrefetchTile(size_t ti, size_t tj) const;
+	void PrefetchTiles(size_t ti, size_t tj1, size_t tj2) const;
+	
+	//! Drop tile (ti, tj) or the tiles [tj1, tj2) of tile row ti from memory,
+	//! modified tiles are written back to the file first.
+	void EvictTile(size_t ti, size_t tj) const;
+	void EvictTiles(size_t ti, size_t tj1, size_t tj2) const;
+
+public:  // Conversion.
+
+	//! Copy a matrix of the same size into the tiles.
+	void   Assign(const ConstMatrixView& A);
+	Matrix ToMatrix() const;
+
+public:  // Operations.
+
+	//! Write the transpose into B, which must be Cols() x Rows() and have the
+	//! same tile size.
+	void TransposeTo(TiledMatrix& B) const;
+	
+	//! Sum of each row as a Rows() x 1 matrix and sum of each column as a
+	//! 1 x Cols() matrix.
+	Matrix SumRows() const;
+	Matrix SumCols() const;
+
+private:
+
+	size_t TileOffset(size_t ti, size_t tj) const;
+	size_t TileBytes() const;
+	
+	MappedFile mFile;
+	size_t     mRows;
+	size_t     mCols;
+	size_t     mTileSize;
+};
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+//! Tile-wise C = alpha*A*B + beta*C for tiled matrices with the same tile size.
+//! The tile rows of A and C are processed in panels which fit in
+//! memoryBudget bytes; every tile of B is read once per panel and each tile
+//! product runs on the GEMM kernel of glGemm().
+//! \param memoryBudget Bytes of A and C kept in memory, 0 means 1 GB.
+//! \param numThreads Number of threads to use, 0 means use glGetNumThreads().
+SMATHLIB_DLL_API void glTiledGemm(double alpha, const TiledMatrix& A, const TiledMatrix& B,
+                                  double beta, TiledMatrix& C, size_t memoryBudget = 0,
+                                  unsigned int numThreads = 0);
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+
+};	// End namespace SMathLib.
+
+#endif // _SMATHLIB_TILEDMATRIX_H_
@@ -0,0 +1,401 @@
+// 
+// This file is part of SLogLib; you can redistribute it and/or 
+// modify it under the terms of the MIT License.
+// Author: Saurabh Garg (saurabhgarg@mysoc.net)
+// 
+
+#include "Transpose.h"
+#include "Cpu.h"
+#include "Parallel.h"
+#include <algorithm>
+#include <vector>
+
+#if defined(SMATHLIB_HAS_AVX2)
+	#include <immintrin.h>
+#endif
+
+namespace SMathLib {
+;
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+// Blocks of at most gcLeaf x gcLeaf elements are transposed directly; a block
+// of A and the corresponding block of B take 16 KB, which fits in L1 cache.
+static const size_t gcLeaf = 32;
+
+// minimum number of elements transposed by a thread.
+static const size_t gcParallelGrain = 32768;
+
+// transpose a block of A into B, or swap a block P with the transpose of a
+// block Q of the same matrix.
+template<typename T> using LeafFunc = void (*)(size_t rows, size_t cols, const T* A, size_t lda, T* B, size_t ldb);
+template<typename T> using SwapFunc = void (*)(size_t rows, size_t cols, T* P, T* Q, size_t ld);
+
+// number of elements in a row of the tiles transposed in AVX2 registers, the
+// blocks are split at multiples of it.
+template<typename T> struct TileSize {static const size_t value = 32 / sizeof(T);};
+
+template<typename T>
+static void LeafScalar(size_t rows, size_t cols, const T* A, size_t lda, T* B, size_t ldb)
+{
+	for(size_t i=0 ; i<rows ; ++i)
+	{
+		for(size_t j=0 ; j<cols ; ++j)
+		{
+			B[j*ldb + i] = A[i*lda + j];
+		}
+	}
+}
+
+template<typename T>
+static void SwapScalar(size_t rows, size_t cols, T* P, T* Q, size_t ld)
+{
+	for(size_t i=0 ; i<rows ; ++i)
+	{
+		for(size_t j=0 ; j<cols ; ++j)
+		{
+			std::swap(P[i*ld + j], Q[j*ld + i]);
+		}
+	}
+}
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+
+
+#if defined(SMATHLIB_HAS_AVX2)
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+// AVX2 kernels. A 4x4 tile of doubles is loaded as four rows, the pairs of
+// rows are interleaved and the 128-bit halves exchanged, which gives the four
+// columns. An 8x8 tile of floats needs one more round of shuffles.
+SMATHLIB_AVX2_TARGET
+static inline void Transpose4x4(__m256d& r0, __m256d& r1, __m256d& r2, __m256d& r3)
+{
+	const __m256d _t0 = _mm256_unpacklo_pd(r0, r1);
+	const __m256d _t1 = _mm256_unpackhi_pd(r0, r1);
+	const __m256d _t2 = _mm256_unpacklo_pd(r2, r3);
+	const __m256d _t3 = _mm256_unpackhi_pd(r2, r3);
+	r0 = _mm256_permute2f128_pd(_t0, _t2, 0x20);
+	r1 = _mm256_permute2f128_pd(_t1, _t3, 0x20);
+	r2 = _mm256_permute2f128_pd(_t0, _t2, 0x31);
+	r3 = _mm256_permute2f128_pd(_t1, _t3, 0x31);
+}
+
+SMATHLIB_AVX2_TARGET
+static void LeafAvx2(size_t rows, size_t cols, const double* A, size_t lda, double* B, size_t ldb)
+{
+	const size_t _rows4 = rows & ~size_t(3);
+	const size_t _cols4 = cols & ~size_t(3);
+	for(size_t i=0 ; i<_rows4 ; i+=4)
+	{
+		for(size_t j=0 ; j<_cols4 ; j+=4)
+		{
+			const double* _a  = A + i*lda + j;
+			__m256d       _r0 = _mm256_loadu_pd(_a        );
+			__m256d       _r1 = _mm256_loadu_pd(_a +   lda);
+			__m256d       _r2 = _mm256_loadu_pd(_a + 2*lda);
+			__m256d       _r3 = _mm256_loadu_pd(_a + 3*lda);
+			Transpose4x4(_r0, _r1, _r2, _r3);
+			
+			double* _b = B + j*ldb + i;
+			_mm256_storeu_pd(_b        , _r0);
+			_mm256_storeu_pd(_b +   ldb, _r1);
+			_mm256_storeu_pd(_b + 2*ldb, _r2);
+			_mm256_storeu_pd(_b + 3*ldb, _r3);
+		}
+	}
+	
+	// right and bottom edges which don't fill a tile.
+	LeafScalar(rows, cols-_cols4, A + _cols4, lda, B + _cols4*ldb, ldb);
+	LeafScalar(rows-_rows4, _cols4, A + _rows4*lda, lda, B + _rows4, ldb);
+}
+
+SMATHLIB_AVX2_TARGET
+static void SwapAvx2(size_t rows, size_t cols, double* P, double* Q, size_t ld)
+{
+	const size_t _rows4 = rows & ~size_t(3);
+	const size_t _cols4 = cols & ~size_t(3);
+	for(size_t i=0 ; i<_rows4 ; i+=4)
+	{
+		for(size_t j=0 ; j<_cols4 ; j+=4)
+		{
+			double* _p  = P + i*ld + j;
+			double* _q  = Q + j*ld + i;
+			__m256d _p0 = _mm256_loadu_pd(_p       );
+			__m256d _p1 = _mm256_loadu_pd(_p +   ld);
+			__m256d _p2 = _mm256_loadu_pd(_p + 2*ld);
+			__m256d _p3 = _mm256_loadu_pd(_p + 3*ld);
+			__m256d _q0 = _mm256_loadu_pd(_q       );
+			__m256d _q1 = _mm256_loadu_pd(_q +   ld);
+			__m256d _q2 = _mm256_loadu_pd(_q + 2*ld);
+			__m256d _q3 = _mm256_loadu_pd(_q + 3*ld);
+			Transpose4x4(_p0, _p1, _p2, _p3);
+			Transpose4x4(_q0, _q1, _q2, _q3);
+			_mm256_storeu_pd(_q       , _p0);
+			_mm256_storeu_pd(_q +   ld, _p1);
+			_mm256_storeu_pd(_q + 2*ld, _p2);
+			_mm256_storeu_pd(_q + 3*ld, _p3);
+			_mm256_storeu_pd(_p       , _q0);
+			_mm256_storeu_pd(_p +   ld, _q1);
+			_mm256_storeu_pd(_p + 2*ld, _q2);
+			_mm256_storeu_pd(_p + 3*ld, _q3);
+		}
+	}
+	SwapScalar(rows, cols-_cols4, P + _cols4, Q + _cols4*ld, ld);
+	SwapScalar(rows-_rows4, _cols4, P + _rows4*ld, Q + _rows4, ld);
+}
+
+SMATHLIB_AVX2_TARGET
+static inline void Transpose8x8(__m256* r)
+{
+	__m256 _t[8];
+	for(int k=0 ; k<8 ; k+=2)
+	{
+		_t[k  ] = _mm256_unpacklo_ps(r[k], r[k+1]);
+		_t[k+1] = _mm256_unpackhi_ps(r[k], r[k+1]);
+	}
+	for(int k=0 ; k<8 ; k+=4)
+	{
+		r[k  ] = _mm256_shuffle_ps(_t[k  ], _t[k+2], _MM_SHUFFLE(1, 0, 1, 0));
+		r[k+1] = _mm256_shuffle_ps(_t[k  ], _t[k+2], _MM_SHUFFLE(3, 2, 3, 2));
+		r[k+2] = _mm256_shuffle_ps(_t[k+1], _t[k+3], _MM_SHUFFLE(1, 0, 1, 0));
+		r[k+3] = _mm256_shuffle_ps(_t[k+1], _t[k+3], _MM_SHUFFLE(3, 2, 3, 2));
+	}
+	for(int k=0 ; k<4 ; ++k)
+	{
+		_t[k  ] = _mm256_permute2f128_ps(r[k], r[k+4], 0x20);
+		_t[k+4] = _mm256_permute2f128_ps(r[k], r[k+4], 0x31);
+	}
+	for(int k=0 ; k<8 ; ++k)
+	{
+		r[k] = _t[k];
+	}
+}
+
+SMATHLIB_AVX2_TARGET
+static void LeafAvx2(size_t rows, size_t cols, const float* A, size_t lda, float* B, size_t ldb)
+{
+	const size_t _rows8 = rows & ~size_t(7);
+	const size_t _cols8 = cols & ~size_t(7);
+	for(size_t i=0 ; i<_rows8 ; i+=8)
+	{
+		for(size_t j=0 ; j<_cols8 ; j+=8)
+		{
+			__m256 _r[8];
+			for(size_t k=0 ; k<8 ; ++k)
+			{
+				_r[k] = _mm256_loadu_ps(A + (i+k)*lda + j);
+			}
+			Transpose8x8(_r);
+			for(size_t k=0 ; k<8 ; ++k)
+			{
+				_mm256_storeu_ps(B + (j+k)*ldb + i, _r[k]);
+			}
+		}
+	}
+	LeafScalar(rows, cols-_cols8, A + _cols8, lda, B + _cols8*ldb, ldb);
+	LeafScalar(rows-_rows8, _cols8, A + _rows8*lda, lda, B + _rows8, ldb);
+}
+
+SMATHLIB_AVX2_TARGET
+static void SwapAvx2(size_t rows, size_t cols, float* P, float* Q, size_t ld)
+{
+	const size_t _rows8 = rows & ~size_t(7);
+	const size_t _cols8 = cols & ~size_t(7);
+	for(size_t i=0 ; i<_rows8 ; i+=8)
+	{
+		for(size_t j=0 ; j<_cols8 ; j+=8)
+		{
+			float* _p = P + i*ld + j;
+			float* _q = Q + j*ld + i;
+			__m256 _pr[8];
+			__m256 _qr[8];
+			for(size_t k=0 ; k<8 ; ++k)
+			{
+				_pr[k] = _mm256_loadu_ps(_p + k*ld);
+				_qr[k] = _mm256_loadu_ps(_q + k*ld);
+			}
+			Transpose8x8(_pr);
+			Transpose8x8(_qr);
+			for(size_t k=0 ; k<8 ; ++k)
+			{
+				_mm256_storeu_ps(_q + k*ld, _pr[k]);
+				_mm256_storeu_ps(_p + k*ld, _qr[k]);
+			}
+		}
+	}
+	SwapScalar(rows, cols-_cols8, P + _cols8, Q + _cols8*ld, ld);
+	SwapScalar(rows-_rows8, _cols8, P + _rows8*ld, Q + _rows8, ld);
+}
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+#endif
+
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+// halve the larger dimension, keeping the first half a multiple of the tile
+// size, until the block fits in L1 cache.
+template<typename T>
+static void Recurse(size_t rows, size_t cols, const T* A, size_t lda, T* B, size_t ldb, LeafFunc<T> leaf)
+{
+	const size_t _mask = ~(TileSize<T>::value - 1);
+	if(rows <= gcLeaf && cols <= gcLeaf)
+	{
+		leaf(rows, cols, A, lda, B, ldb);
+	}
+	else if(rows >= cols)
+	{
+		const size_t _half = (rows/2) & _mask;
+		Recurse(_half, cols, A, lda, B, ldb, leaf);
+		Recurse(rows-_half, cols, A + _half*lda, lda, B + _half, ldb, leaf);
+	}
+	else
+	{
+		const size_t _half = (cols/2) & _mask;
+		Recurse(rows, _half, A, lda, B, ldb, leaf);
+		Recurse(rows, cols-_half, A + _half, lda, B + _half*ldb, ldb, leaf);
+	}
+}
+
+// transpose an n x n matrix in place, block row bi is swapped with block
+// column bi.
+template<typename T>
+static void TransposeSquare(size_t n, T* A, unsigned int numThreads)
+{
+	SwapFunc<T> _swap = SwapScalar;
+#if defined(SMATHLIB_HAS_AVX2)
+	if(glCpuHasAvx2())
+	{
+		_swap = SwapAvx2;
+	}
+#endif
+
+	const size_t _blocks   = (n + gcLeaf - 1) / gcLeaf;
+	auto         _blockRow = [&](size_t bi)
+	{
+		const size_t _i1 = bi*gcLeaf;
+		const size_t _ni = std::min(gcLeaf, n-_i1);
+		T*           _d  = A + _i1*n + _i1;
+		for(size_t i=0 ; i<_ni ; ++i)
+		{
+			for(size_t j=i+1 ; j<_ni ; ++j)
+			{
+				std::swap(_d[i*n + j], _d[j*n + i]);
+			}
+		}
+		for(size_t j1=_i1+gcLeaf ; j1<n ; j1+=gcLeaf)
+		{
+			_swap(_ni, std::min(gcLeaf, n-j1), A + _i1*n + j1, A + j1*n + _i1, n);
+		}
+	};
+	
+	// block row bi has blocks-bi blocks to swap, pairing it with block row
+	// blocks-1-bi gives every index the same amount of work.
+	const size_t _pairs = (_blocks + 1) / 2;
+	const size_t _grain = std::max(size_t(1), gcParallelGrain / (n*gcLeaf + 1));
+	glParallelFor(0, _pairs, _grain, [&](size_t t1, size_t t2)
+	{
+		for(size_t t=t1 ; t<t2 ; ++t)
+		{
+			_blockRow(t);
+			if(_blocks-1-t != t)
+			{
+				_blockRow(_blocks-1-t);
+			}
+		}
+	}, numThreads);
+}
+
+// transpose a rectangular matrix in place by following the cycles of the
+// permutation, the element at i*cols+j moves to j*rows+i.
+template<typename T>
+static void TransposeCycles(size_t rows, size_t cols, T* A)
+{
+	const size_t      _last = rows*cols - 1;
+	std::vector<bool> _visited(rows*cols, false);
+	for(size_t start=1 ; start<_last ; ++start)
+	{
+		if(_visited[start])
+		{
+			continue;
+		}
+		
+		size_t _p     = start;
+		T      _value = A[_p];
+		do
+		{
+			const size_t _q = (_p % cols) * rows + _p / cols;
+			std::swap(_value, A[_q]);
+			_visited[_q] = true;
+			_p = _q;
+		}
+		while(_p != start);
+	}
+}
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ //
+
+
+// transpose.
+// ------------------------------------------------------------------------- //
+template<typename T>
+static void Transpose(size_t rows, size_t cols, const T* A, size_t lda, T* B, size_t ldb, unsigned int numThreads)
+{
+	if(rows == 0 || cols == 0)
+	{
+		return;
+	}
+	
+	LeafFunc<T> _leaf = LeafScalar;
+#if defined(SMATHLIB_HAS_AVX2)
+	if(glCpuHasAvx2())
+	{
+		_leaf = LeafAvx2;
+	}
+#endif
+
+	// each thread transposes a panel of columns of A, i.e. writes a contiguous
+	// block of rows of B.
+	const size_t _grain = std::max(gcLeaf, gcParallelGrain / rows);
+	glParallelFor(0, cols, _grain, [&](size_t c1, size_t c2)
+	{
+		Recurse(rows, c2-c1, A + c1, lda, B + c1*ldb, ldb, _leaf);
+	}, numThreads);
+}
+
+template<typename T>
+static void TransposeInPlace(size_t rows, size_t cols, T* A, unsigned int numThreads)
+{
+	// a vector stores its elements in the same order as its transpose.
+	if(rows <= 1 || cols <= 1)
+	{
+		return;
+	}
+	
+	if(rows == cols)
+	{
+		TransposeSquare(rows, A, numThreads);
+	}
+	else
+	{
+		TransposeCycles(rows, cols, A);
+	}
+}
+
+void glTranspose(size_t rows, size_t cols, const double* A, size_t lda, double* B, size_t ldb, unsigned int numThreads)
+{
+	Transpose(rows, cols, A, lda, B, ldb, numThreads);
+}
+
+void glTranspose(size_t rows, size_t cols, const float* A, size_t lda, float* B, size_t ldb, unsigned int numThreads)
+{
+	Transpose(rows, cols, A, lda, B, ldb, numThreads);
+}
+
+void glTransposeInPlace(size_t rows, size_t cols, double* A, unsigned int numThreads)
+{
+	TransposeInPlace(rows, cols, A, numThreads);
+}
+
+void glTransposeInPlace(size_t rows, size_t cols, float* A, unsigned int numThreads)
+{
+	TransposeInPlace(rows, cols, A, numThreads);
+}
+// ------------------------------------------------------------------------- //
+
+};	// End namespace SMathLib.
@@ -0,0 +1,50 @@
+// 
+// This file is part of SLogLib; you can redistribute it and/or 
+// modify it under the terms of the MIT License.
+// Author: Saurabh Garg (saurabhgarg@mysoc.net)
+// 
+
+#ifndef _SMATHLIB_TRANSPOSE_H_
+#define _SMATHLIB_TRANSPOSE_H_
+
+#include "SMathLib/Config.h"
+#include <cstddef>
+
+namespace SMathLib {
+;
+
+//! Transpose of a matrix, B = A^T. Both matrices are stored in row-major order.
+//! \param rows Number of rows of A and columns of B.
+//! \param cols Number of columns of A and rows of B.
+//! \param A Pointer to the first element of the rows x cols matrix A.
+//! \param lda Distance between two consecutive rows of A.
+//! \param B Pointer to the first element of the cols x rows matrix B.
+//! \param ldb Distance between two consecutive rows of B.
+//! \param numThreads Number of threads to use, 0 means use glGetNumThreads().
+//! The matrix is split recursively along its larger dimension until a block of
+//! A and B fits in L1 cache, so both are read and written in whole cache lines
+//! at every level of the cache hierarchy. The blocks are transposed in 4x4
+//! tiles of doubles or 8x8 tiles of floats held in AVX2 registers when the
+//! CPU supports them. A and B must not overlap.
+SMATHLIB_DLL_API void glTranspose(size_t rows, size_t cols, const double* A, size_t lda,
+                                  double* B, size_t ldb, unsigned int numThreads = 0);
+SMATHLIB_DLL_API void glTranspose(size_t rows, size_t cols, const float* A, size_t lda,
+                                  float* B, size_t ldb, unsigned int numThreads = 0);
+
+//! Transpose a contiguous row-major matrix in place. On return the memory holds
+//! the cols x rows transpose in row-major order.
+//! \param rows Number of rows of A.
+//! \param cols Number of columns of A.
+//! \param A Pointer to the rows*cols elements of A.
+//! \param numThreads Number of threads to use, 0 means use glGetNumThreads().
+//! Square matrices swap pairs of blocks across the diagonal in parallel.
+//! Rectangular matrices follow the cycles of the permutation i*cols+j ->
+//! j*rows+i, which needs rows*cols bits of extra memory instead of a second
+//! copy of the matrix but touches the elements in random order and runs
+//! on a single thread.
+SMATHLIB_DLL_API void glTransposeInPlace(size_t rows, size_t cols, double* A, unsigned int numThreads = 0);
+SMATHLIB_DLL_API void glTransposeInPlace(size_t rows, size_t cols, float* A, unsigned int numThreads = 0);
+
+};	// End namespace SMathLib.
+
+#endif // _SMATHLIB_TRANSPOSE_H_
@@ -6,6 +6,8 @@
 
 #include "Vector3D.h"
 #include "Matrix.h"
+#include "TextParser.h"
+#include "SUtils/Exceptions/InvalidArgumentException.h"
 #include <cassert>
 #include <cmath>
 
@@ -338,14 +340,21 @@ std::ostream& operator <<(std::ostream& fout, const std::vector<Vector3D>& B)
 // input stream.
 std::istream& operator >>(std::istream& fin, std::vector<Vector3D>& B)
 {
-	int size;
-	fin >> size;
+	size_t size;
+	if(!(fin >> size))
+	{
+		char _msg[] = "Invalid number of points in operator >>(std::istream&, std::vector<Vector3D>&)";
+		throw SUtils::Exceptions::InvalidArgumentException(_msg);
+	}
+	
+	// parse all the coordinates in one go, then append the points.
+	std::vector<double> _coords(3*size);
+	glReadNumbers(fin, _coords.data(), _coords.size());
 	
-	for(int i=0 ; i<size ; i++)
+	B.reserve(B.size() + size);
+	for(size_t i=0 ; i<size ; i++)
 	{
-		Vector3D p;
-		fin >> p;
-		B.push_back(p);
+		B.push_back(Vector3D(_coords[3*i], _coords[3*i+1], _coords[3*i+2]));
 	}
 	
 	return fin;
@@ -14,7 +14,8 @@
 namespace SMathLib {
 ;
 
-class Matrix;
+template<typename T> class MatrixT;
+typedef MatrixT<double> Matrix;
 
 class SMATHLIB_DLL_API Vector3D
 {